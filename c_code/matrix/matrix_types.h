@@ -12,19 +12,55 @@
 #define MATRIX_ERR_DIMENSION 3   // Mismatched dimensions for operation
 #define MATRIX_ERR_MATH 4        // e.g., singular matrix for inverse
 
+// Alignment of the element buffer, and the row stride is rounded up to a multiple of this
+#define MATRIX_C_ALIGNMENT 64
+
 // --- Matrix Structure ---
+// Elements live in one contiguous buffer: element (i, j) is values[i * stride + j]. The
+// struct, the row pointers and the elements share a single allocation (or one slice of an
+// arena), so creating a matrix is one malloc and destroying it is one free.
 typedef struct {
     int rows;
     int cols;
-    double** data; // Pointer to array of row pointers
+    int stride;      // Doubles from the start of one row to the next (>= cols, padded for alignment)
+    double* values;  // rows * stride doubles, MATRIX_C_ALIGNMENT-aligned
+    double** data;   // Row pointers into values, so data[i][j] keeps working
+    bool in_arena;   // Storage belongs to a MatrixArenaC; destroy_matrix leaves it alone
 } MatrixC; // Added 'C' suffix to avoid potential clashes if mixing with C++
 
+// --- Arena Allocator ---
+// A bump allocator over one buffer. Matrices created in it are never freed one by one:
+// matrix_arena_reset (or matrix_arena_release back to a mark) recycles them all at once,
+// and matrix_arena_destroy returns the buffer. A computation sized up front with
+// matrix_arena_matrix_bytes then runs without touching malloc.
+typedef struct {
+    unsigned char* buffer;
+    size_t capacity; // Bytes
+    size_t used;     // Bytes handed out so far
+} MatrixArenaC;
+
 // --- Function to Create/Destroy Matrix ---
 // Creates a matrix, initializes elements to 0.0. Returns NULL on failure.
 MatrixC* create_matrix(int rows, int cols);
-// Frees all memory associated with the matrix. Safe to call with NULL.
+// Frees all memory associated with the matrix. Safe to call with NULL; does nothing for
+// matrices that live in an arena.
 void destroy_matrix(MatrixC* matrix);
 
+// Creates an arena with room for capacity bytes. Returns NULL on failure.
+MatrixArenaC* matrix_arena_create(size_t capacity);
+// Frees the arena and every matrix in it. Safe to call with NULL.
+void matrix_arena_destroy(MatrixArenaC* arena);
+// Arena bytes taken by one rows x cols matrix (header, row pointers, padding and elements).
+size_t matrix_arena_matrix_bytes(int rows, int cols);
+// Creates a zeroed matrix in the arena. Returns NULL if the dimensions are invalid or the
+// arena is full.
+MatrixC* matrix_arena_create_matrix(MatrixArenaC* arena, int rows, int cols);
+// Marks the current fill level; matrix_arena_release drops everything created after it.
+size_t matrix_arena_mark(const MatrixArenaC* arena);
+void matrix_arena_release(MatrixArenaC* arena, size_t mark);
+// Drops every matrix in the arena, keeping the buffer for reuse.
+void matrix_arena_reset(MatrixArenaC* arena);
+
 // --- Input Structures (using pointers to avoid copying) ---
 typedef struct {
     const MatrixC* matrix; // Use const for input-only matrices
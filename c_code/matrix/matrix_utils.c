@@ -1,80 +1,136 @@
 // File: matrix_utils.c
 #include "matrix_utils.h"
 #include <stdio.h>
-#include <stdlib.h> // For malloc, free, exit
+#include <stdlib.h> // For malloc, aligned_alloc, free
 #include <string.h> // For memcpy, memset, snprintf
 #include <math.h>   // For fabs, pow
 #include <stdbool.h>
 
+// --- Matrix Layout ---
+// One block holds [MatrixC][row pointers][padding][elements]. Both the header part and the
+// element part are multiples of MATRIX_C_ALIGNMENT, so a block that starts aligned keeps
+// its elements aligned, and consecutive arena blocks stay aligned too.
+
+static size_t round_up_to_alignment(size_t bytes) {
+    return (bytes + MATRIX_C_ALIGNMENT - 1) / MATRIX_C_ALIGNMENT * MATRIX_C_ALIGNMENT;
+}
+
+static int padded_stride(int cols) {
+    const int per_line = MATRIX_C_ALIGNMENT / (int)sizeof(double);
+    return (cols + per_line - 1) / per_line * per_line;
+}
+
+static size_t header_bytes(int rows) {
+    return round_up_to_alignment(sizeof(MatrixC) + (size_t)rows * sizeof(double*));
+}
+
+size_t matrix_arena_matrix_bytes(int rows, int cols) {
+    if (rows <= 0 || cols <= 0) return 0;
+    return header_bytes(rows) + (size_t)rows * (size_t)padded_stride(cols) * sizeof(double);
+}
+
+// Lays a zeroed rows x cols matrix out in an aligned block of matrix_arena_matrix_bytes bytes
+static MatrixC* layout_matrix(unsigned char* block, int rows, int cols, bool in_arena) {
+    MatrixC* matrix = (MatrixC*)block;
+    matrix->rows = rows;
+    matrix->cols = cols;
+    matrix->stride = padded_stride(cols);
+    matrix->data = (double**)(block + sizeof(MatrixC));
+    matrix->values = (double*)(block + header_bytes(rows));
+    matrix->in_arena = in_arena;
+    memset(matrix->values, 0, (size_t)rows * (size_t)matrix->stride * sizeof(double));
+    for (int i = 0; i < rows; ++i) {
+        matrix->data[i] = matrix->values + (size_t)i * matrix->stride;
+    }
+    return matrix;
+}
+
 // --- Matrix Creation/Destruction ---
 
 MatrixC* create_matrix(int rows, int cols) {
     if (rows <= 0 || cols <= 0) {
         return NULL; // Invalid dimensions
     }
+    // A single allocation for the struct, the row pointers and the elements
+    unsigned char* block = (unsigned char*)aligned_alloc(MATRIX_C_ALIGNMENT, matrix_arena_matrix_bytes(rows, cols));
+    if (!block) {
+        return NULL;
+    }
+    return layout_matrix(block, rows, cols, false);
+}
 
-    // Allocate memory for the MatrixC struct itself
-    MatrixC* matrix = (MatrixC*)malloc(sizeof(MatrixC));
-    if (!matrix) {
-        return NULL; // Failed to allocate struct
+void destroy_matrix(MatrixC* matrix) {
+    if (!matrix || matrix->in_arena) {
+        return; // Nothing to free, or the arena owns it
     }
-    matrix->rows = rows;
-    matrix->cols = cols;
+    free(matrix); // The struct starts the block, so this frees rows and elements as well
+}
 
-    // Allocate memory for the array of row pointers (double**)
-    matrix->data = (double**)malloc(rows * sizeof(double*));
-    if (!matrix->data) {
-        free(matrix); // Free the struct if row pointer allocation fails
+// --- Arena Allocator ---
+
+MatrixArenaC* matrix_arena_create(size_t capacity) {
+    MatrixArenaC* arena = (MatrixArenaC*)malloc(sizeof(MatrixArenaC));
+    if (!arena) {
         return NULL;
     }
-
-    // Allocate memory for each row (double*) and initialize to 0.0
-    for (int i = 0; i < rows; ++i) {
-        matrix->data[i] = (double*)malloc(cols * sizeof(double));
-        if (!matrix->data[i]) {
-            // Allocation failed for a row: cleanup previously allocated rows and the row pointer array
-            for (int k = 0; k < i; ++k) {
-                free(matrix->data[k]);
-            }
-            free(matrix->data);
-            free(matrix);
+    capacity = round_up_to_alignment(capacity);
+    arena->buffer = NULL;
+    if (capacity > 0) {
+        arena->buffer = (unsigned char*)aligned_alloc(MATRIX_C_ALIGNMENT, capacity);
+        if (!arena->buffer) {
+            free(arena);
             return NULL;
         }
-        // Initialize elements to 0.0
-        memset(matrix->data[i], 0, cols * sizeof(double));
-        // Alternative: loop and assign 0.0 if memset isn't preferred
-        // for (int j = 0; j < cols; ++j) matrix->data[i][j] = 0.0;
     }
+    arena->capacity = capacity;
+    arena->used = 0;
+    return arena;
+}
 
-    return matrix;
+void matrix_arena_destroy(MatrixArenaC* arena) {
+    if (!arena) {
+        return;
+    }
+    free(arena->buffer);
+    free(arena);
 }
 
-void destroy_matrix(MatrixC* matrix) {
-    if (!matrix) {
-        return; // Nothing to free
+MatrixC* matrix_arena_create_matrix(MatrixArenaC* arena, int rows, int cols) {
+    if (!arena || rows <= 0 || cols <= 0) {
+        return NULL;
     }
-    if (matrix->data) {
-        // Free each row
-        for (int i = 0; i < matrix->rows; ++i) {
-            free(matrix->data[i]); // Safe to free NULL, but rows should be allocated if data isn't NULL
-        }
-        // Free the array of row pointers
-        free(matrix->data);
+    size_t bytes = matrix_arena_matrix_bytes(rows, cols);
+    if (bytes > arena->capacity - arena->used) {
+        return NULL; // Arena full
     }
-    // Free the struct itself
-    free(matrix);
+    MatrixC* matrix = layout_matrix(arena->buffer + arena->used, rows, cols, true);
+    arena->used += bytes;
+    return matrix;
+}
+
+size_t matrix_arena_mark(const MatrixArenaC* arena) {
+    return arena ? arena->used : 0;
+}
+
+void matrix_arena_release(MatrixArenaC* arena, size_t mark) {
+    if (arena && mark <= arena->used) {
+        arena->used = mark;
+    }
+}
+
+void matrix_arena_reset(MatrixArenaC* arena) {
+    matrix_arena_release(arena, 0);
 }
 
 // --- Validation and Helper Functions ---
 
 int matrix_is_valid(const MatrixC* matrix, int* rows, int* cols) {
-    if (!matrix || !matrix->data || matrix->rows <= 0 || matrix->cols <= 0) {
+    if (!matrix || !matrix->values || !matrix->data || matrix->rows <= 0 || matrix->cols <= 0) {
         if(rows) *rows = 0;
         if(cols) *cols = 0;
         return 0; // false (invalid)
     }
-    // Basic check: Assume if struct/data ptr is valid, internal structure is too
-    // (More robust checks could verify each matrix->data[i] is not NULL)
+    // Basic check: Assume if struct/values ptr is valid, internal structure is too
     if(rows) *rows = matrix->rows;
     if(cols) *cols = matrix->cols;
     return 1; // true (valid)
@@ -104,23 +160,16 @@ int matrix_get_dimension_string(const MatrixC* matrix, char* buffer, size_t buff
 
 MatrixC* matrix_get_submatrix(const MatrixC* matrix, int skip_row, int skip_col) {
     int n;
-    if (!matrix_is_square(matrix, &n) || n <= 1 || skip_row < 0 || skip_row >= n || skip_col < 0 || skip_col >= n) {
+    if (!matrix_is_square(matrix, &n) || n <= 1) {
         return NULL; // Invalid input or 1x1 matrix
     }
 
     MatrixC* sub = create_matrix(n - 1, n - 1);
     if (!sub) return NULL; // Memory allocation failed
 
-    int sub_r = 0;
-    for (int r = 0; r < n; ++r) {
-        if (r == skip_row) continue;
-        int sub_c = 0;
-        for (int c = 0; c < n; ++c) {
-            if (c == skip_col) continue;
-            sub->data[sub_r][sub_c] = matrix->data[r][c];
-            sub_c++;
-        }
-        sub_r++;
+    if (matrix_get_submatrix_into(matrix, skip_row, skip_col, sub) != MATRIX_SUCCESS) {
+        destroy_matrix(sub);
+        return NULL;
     }
     return sub;
 }
@@ -142,35 +191,220 @@ void matrix_print(const char* title, const MatrixC* matrix) {
 }
 
 
-// --- Core Calculation Functions ---
+// --- Preallocated-Output Functions ---
 
-int matrix_determinant_recursive(const MatrixC* matrix, double* result) {
-    if (!result) return MATRIX_ERR_INVALID_ARG;
+static bool has_dimensions(const MatrixC* matrix, int rows, int cols) {
+    int r, c;
+    return matrix_is_valid(matrix, &r, &c) && r == rows && c == cols;
+}
+
+int matrix_get_submatrix_into(const MatrixC* matrix, int skip_row, int skip_col, MatrixC* result) {
     int n;
-    if (!matrix_is_square(matrix, &n)) return MATRIX_ERR_DIMENSION;
+    if (!matrix_is_square(matrix, &n) || n <= 1 || skip_row < 0 || skip_row >= n || skip_col < 0 || skip_col >= n) {
+        return MATRIX_ERR_INVALID_ARG; // Invalid input or 1x1 matrix
+    }
+    if (result == matrix) return MATRIX_ERR_INVALID_ARG;
+    if (!has_dimensions(result, n - 1, n - 1)) return MATRIX_ERR_DIMENSION;
 
-    if (n == 0) { *result = 1.0; return MATRIX_SUCCESS; } // Convention for 0x0
-    if (n == 1) { *result = matrix->data[0][0]; return MATRIX_SUCCESS; }
+    int sub_r = 0;
+    for (int r = 0; r < n; ++r) {
+        if (r == skip_row) continue;
+        const double* src = matrix->values + (size_t)r * matrix->stride;
+        double* dst = result->values + (size_t)sub_r * result->stride;
+        // The row minus one column: two contiguous copies
+        memcpy(dst, src, (size_t)skip_col * sizeof(double));
+        memcpy(dst + skip_col, src + skip_col + 1, (size_t)(n - 1 - skip_col) * sizeof(double));
+        sub_r++;
+    }
+    return MATRIX_SUCCESS;
+}
+
+int matrix_transpose_into(const MatrixC* input, MatrixC* result) {
+    int rows, cols;
+    if (!matrix_is_valid(input, &rows, &cols) || result == input) return MATRIX_ERR_INVALID_ARG;
+    if (!has_dimensions(result, cols, rows)) return MATRIX_ERR_DIMENSION;
+
+    for (int i = 0; i < rows; ++i) {
+        const double* src = input->values + (size_t)i * input->stride;
+        for (int j = 0; j < cols; ++j) {
+            result->values[(size_t)j * result->stride + i] = src[j];
+        }
+    }
+    return MATRIX_SUCCESS;
+}
+
+int matrix_add_into(const MatrixC* a, const MatrixC* b, MatrixC* result) {
+    int rA, cA, rB, cB;
+    if (!matrix_is_valid(a, &rA, &cA) || !matrix_is_valid(b, &rB, &cB)) return MATRIX_ERR_INVALID_ARG;
+    if (rA != rB || cA != cB || !has_dimensions(result, rA, cA)) return MATRIX_ERR_DIMENSION;
+
+    for (int i = 0; i < rA; ++i) {
+        const double* a_row = a->values + (size_t)i * a->stride;
+        const double* b_row = b->values + (size_t)i * b->stride;
+        double* out = result->values + (size_t)i * result->stride;
+        for (int j = 0; j < cA; ++j) {
+            out[j] = a_row[j] + b_row[j];
+        }
+    }
+    return MATRIX_SUCCESS;
+}
+
+int matrix_multiply_scalar_into(const MatrixC* matrix, double scalar, MatrixC* result) {
+    int rows, cols;
+    if (!matrix_is_valid(matrix, &rows, &cols)) return MATRIX_ERR_INVALID_ARG;
+    if (!has_dimensions(result, rows, cols)) return MATRIX_ERR_DIMENSION;
+
+    for (int i = 0; i < rows; ++i) {
+        const double* src = matrix->values + (size_t)i * matrix->stride;
+        double* out = result->values + (size_t)i * result->stride;
+        for (int j = 0; j < cols; ++j) {
+            out[j] = src[j] * scalar;
+        }
+    }
+    return MATRIX_SUCCESS;
+}
+
+int matrix_multiply_matrices_into(const MatrixC* a, const MatrixC* b, MatrixC* result) {
+    int rA, cA, rB, cB;
+    if (!matrix_is_valid(a, &rA, &cA) || !matrix_is_valid(b, &rB, &cB)) return MATRIX_ERR_INVALID_ARG;
+    if (result == a || result == b) return MATRIX_ERR_INVALID_ARG;
+    if (cA != rB || !has_dimensions(result, rA, cB)) return MATRIX_ERR_DIMENSION;
+
+    // i-k-j order: the inner loop streams a row of b into a row of the result. Each element
+    // still sums its products in k order, as the i-j-k loop did.
+    for (int i = 0; i < rA; ++i) {
+        const double* a_row = a->values + (size_t)i * a->stride;
+        double* out = result->values + (size_t)i * result->stride;
+        memset(out, 0, (size_t)cB * sizeof(double));
+        for (int k = 0; k < cA; ++k) { // cA == rB
+            const double a_ik = a_row[k];
+            const double* b_row = b->values + (size_t)k * b->stride;
+            for (int j = 0; j < cB; ++j) {
+                out[j] += a_ik * b_row[j];
+            }
+        }
+    }
+    return MATRIX_SUCCESS;
+}
+
+size_t matrix_determinant_scratch_bytes(int n) {
+    // One submatrix of each order below n
+    size_t bytes = 0;
+    for (int k = 1; k < n; ++k) {
+        bytes += matrix_arena_matrix_bytes(k, k);
+    }
+    return bytes;
+}
+
+// Cofactor expansion along the first row; one submatrix per level, refilled for each column
+static int determinant_expand(const MatrixC* matrix, MatrixArenaC* scratch, double* result) {
+    const int n = matrix->rows;
+    const double* row0 = matrix->values;
+    if (n == 1) { *result = row0[0]; return MATRIX_SUCCESS; }
     if (n == 2) {
-        *result = matrix->data[0][0] * matrix->data[1][1] - matrix->data[0][1] * matrix->data[1][0];
+        const double* row1 = matrix->values + matrix->stride;
+        *result = row0[0] * row1[1] - row0[1] * row1[0];
         return MATRIX_SUCCESS;
     }
 
-    double det = 0.0;
-    for (int j = 0; j < n; ++j) { // Expand along first row
-        MatrixC* sub = matrix_get_submatrix(matrix, 0, j);
-        if (!sub) return MATRIX_ERR_MEMORY; // Failed to create submatrix
+    size_t mark = matrix_arena_mark(scratch);
+    MatrixC* sub = matrix_arena_create_matrix(scratch, n - 1, n - 1);
+    if (!sub) return MATRIX_ERR_MEMORY; // Scratch arena too small
 
+    int status = MATRIX_SUCCESS;
+    double det = 0.0;
+    for (int j = 0; j < n && status == MATRIX_SUCCESS; ++j) {
         double minor;
-        int status = matrix_determinant_recursive(sub, &minor);
-        destroy_matrix(sub); // Free the temporary submatrix
-        if (status != MATRIX_SUCCESS) return status; // Propagate error
+        status = matrix_get_submatrix_into(matrix, 0, j, sub);
+        if (status == MATRIX_SUCCESS) status = determinant_expand(sub, scratch, &minor);
+        if (status == MATRIX_SUCCESS) {
+            double sign = (j % 2 == 0) ? 1.0 : -1.0;
+            det += sign * row0[j] * minor;
+        }
+    }
+    matrix_arena_release(scratch, mark);
+    if (status == MATRIX_SUCCESS) *result = det;
+    return status;
+}
 
-        double sign = (j % 2 == 0) ? 1.0 : -1.0;
-        det += sign * matrix->data[0][j] * minor;
+int matrix_determinant_arena(const MatrixC* matrix, MatrixArenaC* scratch, double* result) {
+    if (!result) return MATRIX_ERR_INVALID_ARG;
+    int n;
+    if (!matrix_is_square(matrix, &n)) return MATRIX_ERR_DIMENSION;
+    return determinant_expand(matrix, scratch, result);
+}
+
+// Signed minors into result, transposed for the adjoint. A 1x1 input has the single
+// cofactor 1 (the determinant of the empty minor).
+static int cofactors_into(const MatrixC* input, MatrixArenaC* scratch, MatrixC* result, bool transposed) {
+    int n;
+    if (!matrix_is_square(input, &n)) return MATRIX_ERR_DIMENSION;
+    if (result == input) return MATRIX_ERR_INVALID_ARG;
+    if (!has_dimensions(result, n, n)) return MATRIX_ERR_DIMENSION;
+    if (n == 1) { result->values[0] = 1.0; return MATRIX_SUCCESS; }
+
+    size_t mark = matrix_arena_mark(scratch);
+    MatrixC* sub = matrix_arena_create_matrix(scratch, n - 1, n - 1);
+    if (!sub) return MATRIX_ERR_MEMORY;
+
+    int status = MATRIX_SUCCESS;
+    for (int r = 0; r < n && status == MATRIX_SUCCESS; ++r) {
+        for (int c = 0; c < n && status == MATRIX_SUCCESS; ++c) {
+            double minor;
+            status = matrix_get_submatrix_into(input, r, c, sub);
+            if (status == MATRIX_SUCCESS) status = determinant_expand(sub, scratch, &minor);
+            if (status == MATRIX_SUCCESS) {
+                double sign = ((r + c) % 2 == 0) ? 1.0 : -1.0;
+                if (transposed) {
+                    result->values[(size_t)c * result->stride + r] = sign * minor;
+                } else {
+                    result->values[(size_t)r * result->stride + c] = sign * minor;
+                }
+            }
+        }
     }
-    *result = det;
-    return MATRIX_SUCCESS;
+    matrix_arena_release(scratch, mark);
+    return status;
+}
+
+int matrix_cofactor_matrix_into(const MatrixC* input, MatrixArenaC* scratch, MatrixC* result) {
+    return cofactors_into(input, scratch, result, false);
+}
+
+int matrix_adjoint_matrix_into(const MatrixC* input, MatrixArenaC* scratch, MatrixC* result) {
+    return cofactors_into(input, scratch, result, true);
+}
+
+int matrix_inverse_matrix_into(const MatrixC* input, MatrixArenaC* scratch, MatrixC* result) {
+    double det;
+    int status = matrix_determinant_arena(input, scratch, &det);
+    if (status != MATRIX_SUCCESS) return status;
+
+    if (fabs(det) < MATRIX_C_EPSILON) {
+        return MATRIX_ERR_MATH; // Singular matrix, no inverse
+    }
+
+    status = matrix_adjoint_matrix_into(input, scratch, result);
+    if (status != MATRIX_SUCCESS) return status;
+    return matrix_multiply_scalar_into(result, 1.0 / det, result);
+}
+
+
+// --- Core Calculation Functions ---
+// Allocating wrappers over the functions above. The cofactor-based ones size one scratch
+// arena for the whole expansion instead of allocating a submatrix per minor.
+
+int matrix_determinant_recursive(const MatrixC* matrix, double* result) {
+    if (!result) return MATRIX_ERR_INVALID_ARG;
+    int n;
+    if (!matrix_is_square(matrix, &n)) return MATRIX_ERR_DIMENSION;
+    if (n <= 2) return determinant_expand(matrix, NULL, result); // No scratch needed
+
+    MatrixArenaC* scratch = matrix_arena_create(matrix_determinant_scratch_bytes(n));
+    if (!scratch) return MATRIX_ERR_MEMORY;
+    int status = determinant_expand(matrix, scratch, result);
+    matrix_arena_destroy(scratch);
+    return status;
 }
 
 int matrix_transpose(const MatrixC* input, MatrixC** result_ptr) {
@@ -182,11 +416,8 @@ int matrix_transpose(const MatrixC* input, MatrixC** result_ptr) {
     MatrixC* transposed = create_matrix(cols, rows);
     if (!transposed) return MATRIX_ERR_MEMORY;
 
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            transposed->data[j][i] = input->data[i][j];
-        }
-    }
+    int status = matrix_transpose_into(input, transposed);
+    if (status != MATRIX_SUCCESS) { destroy_matrix(transposed); return status; }
     *result_ptr = transposed;
     return MATRIX_SUCCESS;
 }
@@ -201,11 +432,8 @@ int matrix_add(const MatrixC* a, const MatrixC* b, MatrixC** result_ptr) {
      MatrixC* result = create_matrix(rA, cA);
      if (!result) return MATRIX_ERR_MEMORY;
 
-     for(int i=0; i<rA; ++i) {
-         for(int j=0; j<cA; ++j) {
-             result->data[i][j] = a->data[i][j] + b->data[i][j];
-         }
-     }
+     int status = matrix_add_into(a, b, result);
+     if (status != MATRIX_SUCCESS) { destroy_matrix(result); return status; }
      *result_ptr = result;
      return MATRIX_SUCCESS;
 }
@@ -219,11 +447,8 @@ int matrix_multiply_scalar(const MatrixC* matrix, double scalar, MatrixC** resul
       MatrixC* result = create_matrix(rows, cols);
       if (!result) return MATRIX_ERR_MEMORY;
 
-      for(int i=0; i<rows; ++i) {
-         for(int j=0; j<cols; ++j) {
-             result->data[i][j] = matrix->data[i][j] * scalar;
-         }
-     }
+     int status = matrix_multiply_scalar_into(matrix, scalar, result);
+     if (status != MATRIX_SUCCESS) { destroy_matrix(result); return status; }
      *result_ptr = result;
      return MATRIX_SUCCESS;
 }
@@ -238,84 +463,42 @@ int matrix_multiply_matrices(const MatrixC* a, const MatrixC* b, MatrixC** resul
      MatrixC* result = create_matrix(rA, cB); // Dimensions of result are rowsA x colsB
      if (!result) return MATRIX_ERR_MEMORY;
 
-      for(int i=0; i<rA; ++i) {
-         for(int j=0; j<cB; ++j) {
-             // result[i][j] is already 0.0 due to create_matrix
-             for(int k=0; k<cA; ++k) { // cA == rB
-                result->data[i][j] += a->data[i][k] * b->data[k][j];
-             }
-         }
-     }
+     int status = matrix_multiply_matrices_into(a, b, result);
+     if (status != MATRIX_SUCCESS) { destroy_matrix(result); return status; }
      *result_ptr = result;
      return MATRIX_SUCCESS;
 }
 
-int matrix_cofactor_matrix(const MatrixC* input, MatrixC** result_ptr) {
+// Shared body of the cofactor, adjoint and inverse wrappers
+static int allocate_with_scratch(const MatrixC* input, MatrixC** result_ptr,
+                                 int (*compute)(const MatrixC*, MatrixArenaC*, MatrixC*)) {
      if (!result_ptr) return MATRIX_ERR_INVALID_ARG;
      *result_ptr = NULL;
      int n;
      if (!matrix_is_square(input, &n)) return MATRIX_ERR_DIMENSION;
 
-     MatrixC* cofactors = create_matrix(n, n);
-     if (!cofactors) return MATRIX_ERR_MEMORY;
-
-     int status = MATRIX_SUCCESS; // Track errors during sub-calculations
-     for(int r=0; r<n; ++r) {
-         for(int c=0; c<n; ++c) {
-            MatrixC* sub = matrix_get_submatrix(input, r, c);
-            if (!sub) { status = MATRIX_ERR_MEMORY; goto cleanup_cofactor; }
-
-            double minor;
-            status = matrix_determinant_recursive(sub, &minor);
-            destroy_matrix(sub); // Free temp submatrix
-            if (status != MATRIX_SUCCESS) goto cleanup_cofactor;
-
-            double sign = ((r + c) % 2 == 0) ? 1.0 : -1.0;
-            cofactors->data[r][c] = sign * minor;
-         }
+     MatrixC* result = create_matrix(n, n);
+     MatrixArenaC* scratch = matrix_arena_create(matrix_determinant_scratch_bytes(n));
+     int status = (result && scratch) ? compute(input, scratch, result) : MATRIX_ERR_MEMORY;
+     matrix_arena_destroy(scratch);
+     if (status != MATRIX_SUCCESS) {
+         destroy_matrix(result);
+         return status;
      }
+     *result_ptr = result;
+     return MATRIX_SUCCESS;
+}
 
-cleanup_cofactor:
-    if (status != MATRIX_SUCCESS) {
-        destroy_matrix(cofactors);
-        *result_ptr = NULL;
-    } else {
-        *result_ptr = cofactors;
-    }
-    return status;
+int matrix_cofactor_matrix(const MatrixC* input, MatrixC** result_ptr) {
+    return allocate_with_scratch(input, result_ptr, matrix_cofactor_matrix_into);
 }
 
 int matrix_adjoint_matrix(const MatrixC* input, MatrixC** result_ptr) {
-    if (!result_ptr) return MATRIX_ERR_INVALID_ARG;
-    *result_ptr = NULL;
-    MatrixC* cofactors = NULL;
-    int status = matrix_cofactor_matrix(input, &cofactors);
-    if (status != MATRIX_SUCCESS) return status;
-
-    status = matrix_transpose(cofactors, result_ptr);
-    destroy_matrix(cofactors); // Free intermediate cofactor matrix
-    return status;
+    return allocate_with_scratch(input, result_ptr, matrix_adjoint_matrix_into);
 }
 
 int matrix_inverse_matrix(const MatrixC* input, MatrixC** result_ptr) {
-     if (!result_ptr) return MATRIX_ERR_INVALID_ARG;
-     *result_ptr = NULL;
-
-     double det;
-     int status = matrix_determinant_recursive(input, &det);
-     if (status != MATRIX_SUCCESS) return status;
-
-     if (fabs(det) < MATRIX_C_EPSILON) {
-         return MATRIX_ERR_MATH; // Singular matrix, no inverse
-     }
-
-     MatrixC* adj = NULL;
-     status = matrix_adjoint_matrix(input, &adj);
-     if (status != MATRIX_SUCCESS) return status;
-
-     status = matrix_multiply_scalar(adj, 1.0 / det, result_ptr);
-     destroy_matrix(adj); // Free intermediate adjoint matrix
-     return status;
+    return allocate_with_scratch(input, result_ptr, matrix_inverse_matrix_into);
 }
 
 
@@ -344,11 +527,13 @@ int matrix_compare_matrices(const TwoMatrixInputC* input, MatrixEqualityResponse
     }
 
     for (int i = 0; i < rA; ++i) {
+        const double* a_row = input->matrix_a->values + (size_t)i * input->matrix_a->stride;
+        const double* b_row = input->matrix_b->values + (size_t)i * input->matrix_b->stride;
         for (int j = 0; j < cA; ++j) {
-            if (fabs(input->matrix_a->data[i][j] - input->matrix_b->data[i][j]) > MATRIX_C_EPSILON) {
+            if (fabs(a_row[j] - b_row[j]) > MATRIX_C_EPSILON) {
                  snprintf(response->reason, sizeof(response->reason),
                           "Element mismatch at row %d, column %d (%.4f != %.4f).",
-                          i, j, input->matrix_a->data[i][j], input->matrix_b->data[i][j]);
+                          i, j, a_row[j], b_row[j]);
                  return MATRIX_SUCCESS;
             }
         }
@@ -401,24 +586,17 @@ int matrix_calculate_minors_cofactors(const MatrixInputC* input, MinorsCofactors
      status = matrix_cofactor_matrix(input->matrix, &response->matrix_of_cofactors);
      if (status != MATRIX_SUCCESS) return status;
 
-     // Calculate minors separately for the response
+     // Minors are the cofactors with the checkerboard sign undone
      response->matrix_of_minors = create_matrix(n, n);
      if (!response->matrix_of_minors) {
          destroy_matrix(response->matrix_of_cofactors); // Clean up already created cofactor matrix
          response->matrix_of_cofactors = NULL;
          return MATRIX_ERR_MEMORY;
      }
-
-     status = MATRIX_SUCCESS;
-      for(int r=0; r<n; ++r) {
-         for(int c=0; c<n; ++c) {
-            MatrixC* sub = matrix_get_submatrix(input->matrix, r, c);
-             if (!sub) { status = MATRIX_ERR_MEMORY; goto cleanup_minors; }
-            double minor_val;
-            int det_status = matrix_determinant_recursive(sub, &minor_val);
-            destroy_matrix(sub);
-             if (det_status != MATRIX_SUCCESS) { status = det_status; goto cleanup_minors; }
-             response->matrix_of_minors->data[r][c] = minor_val;
+     for (int r = 0; r < n; ++r) {
+         for (int c = 0; c < n; ++c) {
+             double cofactor = response->matrix_of_cofactors->data[r][c];
+             response->matrix_of_minors->data[r][c] = ((r + c) % 2 == 0) ? cofactor : -cofactor;
          }
      }
 
@@ -31,6 +31,27 @@ int matrix_cofactor_matrix(const MatrixC* input, MatrixC** result); // Allocates
 int matrix_adjoint_matrix(const MatrixC* input, MatrixC** result); // Allocates result
 int matrix_inverse_matrix(const MatrixC* input, MatrixC** result); // Allocates result (NULL if singular)
 
+// --- Preallocated-Output Functions ---
+// The functions above allocate their result and are wrappers over these, which write into a
+// result the caller created (with create_matrix or in an arena) and never allocate. The
+// result must already have the output dimensions (MATRIX_ERR_DIMENSION otherwise).
+// Element-wise functions accept result == an input; the others need a distinct result
+// (MATRIX_ERR_INVALID_ARG).
+int matrix_get_submatrix_into(const MatrixC* matrix, int skip_row, int skip_col, MatrixC* result);
+int matrix_transpose_into(const MatrixC* input, MatrixC* result);
+int matrix_add_into(const MatrixC* a, const MatrixC* b, MatrixC* result);
+int matrix_multiply_scalar_into(const MatrixC* matrix, double scalar, MatrixC* result);
+int matrix_multiply_matrices_into(const MatrixC* a, const MatrixC* b, MatrixC* result);
+
+// Cofactor expansion needs one submatrix per level of recursion. These take them from the
+// scratch arena and release them before returning; matrix_determinant_scratch_bytes(n) is
+// enough for any of them on an n x n input (MATRIX_ERR_MEMORY if the arena is smaller).
+size_t matrix_determinant_scratch_bytes(int n);
+int matrix_determinant_arena(const MatrixC* matrix, MatrixArenaC* scratch, double* result);
+int matrix_cofactor_matrix_into(const MatrixC* input, MatrixArenaC* scratch, MatrixC* result);
+int matrix_adjoint_matrix_into(const MatrixC* input, MatrixArenaC* scratch, MatrixC* result);
+int matrix_inverse_matrix_into(const MatrixC* input, MatrixArenaC* scratch, MatrixC* result); // MATRIX_ERR_MATH if singular
+
 // --- "API"-like Functions (matching Python endpoints where possible) ---
 // These functions typically allocate memory for the result structure or contained matrices,
 // which the caller might need to manage (e.g., free matrices inside response structs).
@@ -0,0 +1,102 @@
+// File: backend_compare_bench.cc
+// Runs GEMM, GEMV, TRSM and GETRF on every compiled-in backend, timing each and reporting
+// the largest difference from the built-in backend's result.
+// Usage: backend_compare_bench [max_n]   (build with BLAS=openblas to include "cblas")
+#include "../matrix/matrix_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using MatrixUtils::ConstDenseMatrixView;
+using MatrixUtils::DenseMatrix;
+using MatrixUtils::MatrixBackend;
+
+static double maxAbsDiff(ConstDenseMatrixView x, ConstDenseMatrixView y) {
+    double worst = 0.0;
+    for (int i = 0; i < x.rows(); ++i) {
+        for (int j = 0; j < x.cols(); ++j) worst = std::max(worst, std::fabs(x(i, j) - y(i, j)));
+    }
+    return worst;
+}
+
+static double timePerCall(const std::function<void()>& fn) {
+    int reps = 0;
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+    do {
+        fn();
+        ++reps;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (elapsed < 0.3);
+    return elapsed / reps;
+}
+
+struct KernelResults {
+    DenseMatrix gemm_c, gemv_y, trsm_b, getrf_a;
+};
+
+int main(int argc, char** argv) {
+    int max_n = (argc > 1) ? std::atoi(argv[1]) : 1024;
+    std::vector<std::string> backends = MatrixUtils::availableMatrixBackends();
+    std::mt19937_64 rng(5);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    std::cout << "--- Matrix backend comparison (" << backends.size() << " backend(s)) ---" << std::endl;
+    std::cout << std::setw(6) << "n" << std::setw(10) << "backend" << std::setw(10) << "kernel"
+              << std::setw(14) << "seconds" << std::setw(12) << "GFLOP/s" << std::setw(14) << "max diff" << std::endl;
+
+    for (int n = 256; n <= max_n; n *= 2) {
+        DenseMatrix a(n, n), b(n, n), x(1, n); // Vectors as single rows: contiguous, unlike (n, 1)
+        for (int i = 0; i < n; ++i) {
+            x(0, i) = dist(rng);
+            for (int j = 0; j < n; ++j) {
+                a(i, j) = dist(rng) + (i == j ? n : 0.0); // Diagonally dominant: well-conditioned solves
+                b(i, j) = dist(rng);
+            }
+        }
+
+        KernelResults reference;
+        for (const std::string& name : backends) {
+            MatrixUtils::setMatrixBackend(name);
+            const MatrixBackend& be = MatrixUtils::activeMatrixBackend();
+            KernelResults out{DenseMatrix(n, n), DenseMatrix(1, n), DenseMatrix(n, n), DenseMatrix(n, n)};
+            std::vector<int> pivots(n);
+            double n3 = static_cast<double>(n) * n * n;
+
+            struct Case { const char* kernel; double flops; std::function<void()> run; DenseMatrix* result; DenseMatrix* ref; };
+            std::vector<Case> cases = {
+                {"gemm", 2.0 * n3, [&] { be.gemm(1.0, a, b, 0.0, out.gemm_c); }, &out.gemm_c, &reference.gemm_c},
+                {"gemv", 2.0 * n * n, [&] { be.gemv(1.0, a, x.data(), 0.0, out.gemv_y.data()); }, &out.gemv_y, &reference.gemv_y},
+                {"trsm", n3, [&] {
+                    out.trsm_b = b;
+                    be.trsm(MatrixUtils::TriangularKind::Upper, a, out.trsm_b);
+                }, &out.trsm_b, &reference.trsm_b},
+                {"getrf", 2.0 * n3 / 3.0, [&] {
+                    out.getrf_a = a;
+                    be.getrf(out.getrf_a, pivots.data());
+                }, &out.getrf_a, &reference.getrf_a},
+            };
+            for (Case& c : cases) {
+                double seconds = timePerCall(c.run);
+                std::cout << std::setw(6) << n << std::setw(10) << name << std::setw(10) << c.kernel
+                          << std::setw(14) << std::scientific << std::setprecision(3) << seconds
+                          << std::setw(12) << std::fixed << std::setprecision(2) << c.flops / seconds * 1e-9;
+                if (name == "builtin") {
+                    *c.ref = *c.result;
+                    std::cout << std::setw(14) << "(reference)";
+                } else {
+                    std::cout << std::setw(14) << std::scientific << std::setprecision(1) << maxAbsDiff(*c.result, *c.ref);
+                }
+                std::cout << std::endl;
+            }
+        }
+    }
+    MatrixUtils::setMatrixBackend("builtin");
+    return 0;
+}
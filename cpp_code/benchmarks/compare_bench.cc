@@ -0,0 +1,90 @@
+// File: compare_bench.cc
+// Compares two large equal matrices (the worst case: every element is read) with the
+// original element-by-element loop over Matrix rows and with the vectorised kernel, in
+// each tolerance mode; then plants one mismatch early to show the chunked early exit.
+// Usage: compare_bench [n]
+#include "../matrix/matrix_utils.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+using MatrixUtils::ComparisonOptions;
+using MatrixUtils::ComparisonResult;
+using MatrixUtils::DenseMatrix;
+using MatrixUtils::ToleranceMode;
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// The loop compareMatrices used before the kernel: one branch per element
+static bool scalarEqual(const Matrix& a, const Matrix& b) {
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (size_t j = 0; j < a[i].size(); ++j) {
+            if (std::fabs(a[i][j] - b[i][j]) > MATRIX_EPSILON) return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const int n = (argc > 1) ? std::atoi(argv[1]) : 4000;
+    const int repeats = 5;
+    std::mt19937_64 rng(5);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    DenseMatrix a(n, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) a(i, j) = uniform(rng);
+    }
+    DenseMatrix b = a;
+    Matrix a_rows = a.toMatrix(), b_rows = b.toMatrix();
+    const double gigabytes = 2.0 * n * n * sizeof(double) / 1e9;
+
+    std::cout << "--- Equal " << n << "x" << n << " matrices, full scan ---" << std::endl;
+    std::cout << std::setw(26) << "method" << std::setw(12) << "seconds" << std::setw(10) << "GB/s" << std::endl;
+    auto report = [&](const char* name, double seconds) {
+        std::cout << std::setw(26) << name << std::fixed << std::setprecision(4) << std::setw(12) << seconds
+                  << std::setprecision(2) << std::setw(10) << gigabytes / seconds << std::endl;
+    };
+
+    bool equal = true;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) equal &= scalarEqual(a_rows, b_rows);
+    report("scalar loop (Matrix)", secondsSince(start) / repeats);
+
+    TwoMatrixInput input{a_rows, b_rows};
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) equal &= MatrixUtils::compareMatrices(input).are_equal;
+    report("compareMatrices (Matrix)", secondsSince(start) / repeats);
+
+    const std::pair<const char*, ToleranceMode> modes[] = {
+        {"kernel absolute", ToleranceMode::Absolute},
+        {"kernel relative", ToleranceMode::Relative},
+        {"kernel ulp", ToleranceMode::Ulp}};
+    for (const auto& mode : modes) {
+        ComparisonOptions options;
+        options.mode = mode.second;
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r) equal &= MatrixUtils::compareElements(a, b, options).equal;
+        report(mode.first, secondsSince(start) / repeats);
+    }
+    if (!equal) std::cout << "ERROR: equal matrices reported unequal" << std::endl;
+
+    std::cout << "\n--- One mismatch at row " << n / 100 << ", early exit vs full count ---" << std::endl;
+    b(n / 100, n / 2) += 1.0;
+    for (bool stop : {true, false}) {
+        ComparisonOptions options;
+        options.stop_at_first = stop;
+        start = std::chrono::steady_clock::now();
+        ComparisonResult result = MatrixUtils::compareElements(a, b, options);
+        const double seconds = secondsSince(start);
+        std::cout << std::setw(26) << (stop ? "stop at first" : "full scan") << std::fixed << std::setprecision(6)
+                  << std::setw(12) << seconds << "  at (" << result.first_row << ", " << result.first_col
+                  << "), " << result.elements_compared << " compared, " << result.mismatches << " mismatch(es)"
+                  << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+// File: determinant_scaling_bench.cc
+// Times MatrixUtils::calculateDeterminant from 2x2 up to 2000x2000 and reports the
+// empirical growth exponent between successive sizes (about 3 for an O(n^3) engine).
+#include "../matrix/matrix_utils.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+static Matrix randomMatrix(int n, std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    Matrix m(n, std::vector<double>(n));
+    for (auto& row : m) {
+        for (double& v : row) v = dist(rng);
+    }
+    return m;
+}
+
+int main(int argc, char** argv) {
+    int max_n = (argc > 1) ? std::atoi(argv[1]) : 2000;
+    std::vector<int> sizes;
+    for (int n = 2; n < max_n; n *= 2) sizes.push_back(n);
+    sizes.push_back(max_n);
+
+    std::mt19937_64 rng(42);
+    std::cout << "--- Determinant scaling (LU, partial pivoting) ---" << std::endl;
+    std::cout << std::setw(8) << "n" << std::setw(16) << "seconds/op" << std::setw(16) << "log|det|"
+              << std::setw(12) << "exponent" << std::endl;
+
+    double prev_time = 0.0;
+    int prev_n = 0;
+    volatile double sink = 0.0; // Keeps the timed calls from being optimised away
+    for (int n : sizes) {
+        MatrixInput input = {randomMatrix(n, rng)};
+        int reps = 0;
+        auto start = std::chrono::steady_clock::now();
+        double elapsed = 0.0;
+        do { // Repeat small sizes until the timing is meaningful
+            sink = MatrixUtils::calculateDeterminant(input).determinant;
+            ++reps;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < 0.2);
+        double per_op = elapsed / reps;
+        double log_det = MatrixUtils::luDecompose(input.matrix).logAbsDeterminant();
+
+        std::cout << std::setw(8) << n << std::setw(16) << std::scientific << std::setprecision(3) << per_op
+                  << std::setw(16) << std::fixed << std::setprecision(2) << log_det;
+        if (prev_n > 0 && n >= 64) { // Below this, call overhead dominates
+            double exponent = std::log(per_op / prev_time) / std::log(static_cast<double>(n) / prev_n);
+            std::cout << std::setw(12) << std::setprecision(2) << exponent;
+        }
+        std::cout << std::endl;
+        prev_time = per_op;
+        prev_n = n;
+    }
+    (void)sink;
+    return 0;
+}
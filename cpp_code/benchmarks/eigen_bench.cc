@@ -0,0 +1,165 @@
+// File: eigen_bench.cc
+// Times the symmetric eigendecomposition, general eigenvalues and Jacobi SVD on matrices
+// built from a known spectrum (A = Q * D * Q^T with Q a random orthogonal matrix), so each
+// result is checked against exact reference values: maximum eigenvalue / singular value
+// error (the spectra have magnitudes up to 1), residual ||A V - V D|| / ||A|| (or ||A - U S V^T||)
+// and loss of orthogonality ||V^T V - I||, all in the max norm (general: eigenvalues only).
+// Usage: eigen_bench [max_n] [max_svd_n]   (the SVD is O(sweeps * n^3), so it stops earlier)
+#include "../matrix/matrix_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using MatrixUtils::DenseMatrix;
+
+static DenseMatrix randomOrthogonal(int n, std::mt19937_64& rng) {
+    std::normal_distribution<double> dist(0.0, 1.0);
+    DenseMatrix g(n, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) g(i, j) = dist(rng);
+    }
+    DenseMatrix q = DenseMatrix::identity(n);
+    MatrixUtils::qrDecompose(g).applyQInPlace(q);
+    return q;
+}
+
+static DenseMatrix transposeOf(const DenseMatrix& m) {
+    DenseMatrix t(m.cols(), m.rows());
+    MatrixUtils::transposeInto(m, t);
+    return t;
+}
+
+// q * d * q^T
+static DenseMatrix conjugate(const DenseMatrix& q, const DenseMatrix& d) {
+    return MatrixUtils::multiplyMatrices(MatrixUtils::multiplyMatrices(q, d), transposeOf(q));
+}
+
+static double maxAbs(const DenseMatrix& m) {
+    double value = 0.0;
+    for (int i = 0; i < m.rows(); ++i) {
+        for (int j = 0; j < m.cols(); ++j) value = std::max(value, std::fabs(m(i, j)));
+    }
+    return value;
+}
+
+static double orthogonalityLoss(const DenseMatrix& v) {
+    DenseMatrix gram = MatrixUtils::multiplyMatrices(transposeOf(v), v);
+    for (int i = 0; i < gram.rows(); ++i) gram(i, i) -= 1.0;
+    return maxAbs(gram);
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void printRow(const char* kind, int n, double seconds, double value_err, double residual,
+                     double orthogonality, int sweeps = -1) {
+    std::cout << std::setw(10) << kind << std::setw(8) << n << std::fixed << std::setprecision(3)
+              << std::setw(12) << seconds << std::scientific << std::setprecision(2) << std::setw(12)
+              << value_err;
+    if (residual >= 0.0) std::cout << std::setw(12) << residual << std::setw(12) << orthogonality;
+    if (sweeps >= 0) std::cout << std::setw(8) << sweeps;
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+    int max_n = (argc > 1) ? std::atoi(argv[1]) : 2000;
+    int max_svd_n = (argc > 2) ? std::atoi(argv[2]) : 1000;
+    std::vector<int> sizes;
+    for (int n = 125; n < max_n; n *= 2) sizes.push_back(n);
+    sizes.push_back(max_n);
+
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::cout << "--- Eigen / SVD against known spectra ---" << std::endl;
+    std::cout << std::setw(10) << "kind" << std::setw(8) << "n" << std::setw(12) << "seconds" << std::setw(12)
+              << "value err" << std::setw(12) << "residual" << std::setw(12) << "orthog" << std::setw(8)
+              << "sweeps" << std::endl;
+
+    for (int n : sizes) {
+        DenseMatrix q = randomOrthogonal(n, rng);
+
+        // Symmetric: eigenvalues spread over [-1, 1]
+        std::vector<double> lambda(n);
+        for (double& x : lambda) x = uniform(rng);
+        std::sort(lambda.begin(), lambda.end());
+        DenseMatrix d(n, n);
+        for (int i = 0; i < n; ++i) d(i, i) = lambda[i];
+        DenseMatrix a = conjugate(q, d);
+        auto start = std::chrono::steady_clock::now();
+        MatrixUtils::SymmetricEigenDecomposition eig = MatrixUtils::symmetricEigenDecompose(a);
+        double seconds = secondsSince(start);
+        double value_err = 0.0;
+        for (int i = 0; i < n; ++i) value_err = std::max(value_err, std::fabs(eig.eigenvalues[i] - lambda[i]));
+        DenseMatrix av = MatrixUtils::multiplyMatrices(a, eig.eigenvectors);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) av(i, j) -= eig.eigenvectors(i, j) * eig.eigenvalues[j];
+        }
+        printRow("symmetric", n, seconds, value_err, maxAbs(av) / maxAbs(a), orthogonalityLoss(eig.eigenvectors));
+
+        // General: 2x2 rotation blocks give conjugate pairs a +- b i, with a mild upper
+        // triangle on top so the matrix is not normal
+        std::vector<std::complex<double>> expected(n);
+        DenseMatrix t(n, n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = i + 1; j < n; ++j) t(i, j) = 0.1 * uniform(rng) / std::sqrt(static_cast<double>(n));
+        }
+        for (int i = 0; i < n; i += 2) {
+            double re = uniform(rng);
+            if (i + 1 == n) {
+                t(i, i) = re;
+                expected[i] = {re, 0.0};
+                break;
+            }
+            double im = 0.5 * std::fabs(uniform(rng)) + 0.05;
+            t(i, i) = t(i + 1, i + 1) = re;
+            t(i, i + 1) = im;
+            t(i + 1, i) = -im;
+            expected[i] = {re, -im};
+            expected[i + 1] = {re, im};
+        }
+        std::sort(expected.begin(), expected.end(), [](const std::complex<double>& x, const std::complex<double>& y) {
+            return x.real() != y.real() ? x.real() < y.real() : x.imag() < y.imag();
+        });
+        a = conjugate(q, t);
+        start = std::chrono::steady_clock::now();
+        std::vector<std::complex<double>> values = MatrixUtils::calculateEigenvalues(a);
+        seconds = secondsSince(start);
+        value_err = 0.0;
+        for (int i = 0; i < n; ++i) value_err = std::max(value_err, std::abs(values[i] - expected[i]));
+        printRow("general", n, seconds, value_err, -1.0, -1.0); // Eigenvalues only
+
+        // SVD: singular values graded from 1 down to 1e-6
+        if (n > max_svd_n) continue;
+        DenseMatrix p = randomOrthogonal(n, rng);
+        std::vector<double> sigma(n);
+        for (int i = 0; i < n; ++i) sigma[i] = std::pow(10.0, -6.0 * i / std::max(n - 1, 1));
+        DenseMatrix us = q;
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) us(i, j) *= sigma[j];
+        }
+        a = MatrixUtils::multiplyMatrices(us, transposeOf(p));
+        start = std::chrono::steady_clock::now();
+        MatrixUtils::SingularValueDecomposition svd = MatrixUtils::singularValueDecompose(a);
+        seconds = secondsSince(start);
+        value_err = 0.0;
+        for (int i = 0; i < n; ++i) value_err = std::max(value_err, std::fabs(svd.singular_values[i] - sigma[i]));
+        DenseMatrix rebuilt = svd.u;
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) rebuilt(i, j) *= svd.singular_values[j];
+        }
+        rebuilt = MatrixUtils::multiplyMatrices(rebuilt, transposeOf(svd.v));
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) rebuilt(i, j) -= a(i, j);
+        }
+        printRow("svd", n, seconds, value_err, maxAbs(rebuilt) / maxAbs(a),
+                 std::max(orthogonalityLoss(svd.u), orthogonalityLoss(svd.v)), svd.sweeps);
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+// File: expression_bench.cc
+// D = alpha * A + B - C evaluated four ways: chained legacy Matrix calls, chained
+// DenseMatrix calls (one temporary per step), a fused lazy expression and a hand-written
+// loop. Bandwidth counts only the compulsory traffic (three reads and one write per
+// element), so the fused and hand-written versions should sit close together.
+// Usage: expression_bench [max_n]
+#include "../matrix/matrix_utils.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+using MatrixUtils::DenseMatrix;
+
+template <typename Fn>
+static double secondsPerCall(Fn&& fn) {
+    int reps = 0;
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+    do {
+        fn();
+        ++reps;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (elapsed < 0.3);
+    return elapsed / reps;
+}
+
+int main(int argc, char** argv) {
+    int max_n = (argc > 1) ? std::atoi(argv[1]) : 4000;
+    const double alpha = 0.75;
+    std::mt19937_64 rng(13);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    std::cout << "--- D = alpha * A + B - C, ms (GB/s) ---" << std::endl;
+    std::cout << std::setw(8) << "n" << std::setw(20) << "legacy" << std::setw(20) << "dense temps"
+              << std::setw(20) << "expression" << std::setw(20) << "hand loop" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+
+    volatile double sink = 0.0; // Keeps the timed calls from being optimised away
+    for (int n = 500; n <= max_n; n *= 2) {
+        DenseMatrix a(n, n), b(n, n), c(n, n), d(n, n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                a(i, j) = dist(rng);
+                b(i, j) = dist(rng);
+                c(i, j) = dist(rng);
+            }
+        }
+        Matrix la = a.toMatrix(), lb = b.toMatrix(), lc = c.toMatrix();
+        Matrix neg_lc = MatrixUtils::multiplyMatrixByScalar(lc, -1.0);
+        const double bytes = 4.0 * sizeof(double) * n * n;
+
+        double legacy = secondsPerCall([&] {
+            Matrix r = MatrixUtils::addMatrices(MatrixUtils::addMatrices(MatrixUtils::multiplyMatrixByScalar(la, alpha), lb), neg_lc);
+            sink = r[n - 1][n - 1];
+        });
+        double temps = secondsPerCall([&] {
+            DenseMatrix scaled = MatrixUtils::multiplyMatrixByScalar(a, alpha);
+            DenseMatrix sum = MatrixUtils::addMatrices(scaled, b);
+            DenseMatrix neg = MatrixUtils::multiplyMatrixByScalar(c, -1.0);
+            d = MatrixUtils::addMatrices(sum, neg);
+            sink = d(n - 1, n - 1);
+        });
+        double fused = secondsPerCall([&] {
+            d = alpha * a + b - c;
+            sink = d(n - 1, n - 1);
+        });
+        double hand = secondsPerCall([&] {
+            for (int i = 0; i < n; ++i) {
+                const double* pa = a.row(i);
+                const double* pb = b.row(i);
+                const double* pc = c.row(i);
+                double* pd = d.row(i);
+                for (int j = 0; j < n; ++j) pd[j] = alpha * pa[j] + pb[j] - pc[j];
+            }
+            sink = d(n - 1, n - 1);
+        });
+
+        auto cell = [&](double seconds) {
+            std::cout << std::setw(10) << seconds * 1e3 << " (" << std::setw(6) << bytes / seconds / 1e9 << ")";
+        };
+        std::cout << std::setw(8) << n;
+        cell(legacy);
+        cell(temps);
+        cell(fused);
+        cell(hand);
+        std::cout << std::endl;
+    }
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,106 @@
+// File: factorization64_bench.cc
+// Microseconds per getPrimeFactorization64 call on random 64-bit numbers, on 64-bit primes
+// (a Miller-Rabin certificate and nothing else) and on products of two random 32-bit primes
+// (the hardest case for rho). Trial division by odd numbers is the baseline on 40-bit
+// inputs, where it is still feasible. Every result is checked: the factors multiply back
+// to n.
+// Usage: factorization64_bench [count]
+#include "../real_numbers/real_numbers_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace michu_fr::real_numbers;
+
+__extension__ typedef unsigned __int128 uint128_t;
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static std::map<uint64_t, int> trialDivision(uint64_t n) {
+    std::map<uint64_t, int> factors;
+    for (uint64_t p = 2; p * p <= n; p += (p == 2) ? 1 : 2) {
+        while (n % p == 0) {
+            factors[p]++;
+            n /= p;
+        }
+    }
+    if (n > 1) factors[n]++;
+    return factors;
+}
+
+static bool multipliesBack(uint64_t n, const PrimeFactors64& factors) {
+    uint128_t product = 1;
+    for (const auto& factor : factors) {
+        for (int i = 0; i < factor.second; ++i) product *= factor.first;
+    }
+    return product == n;
+}
+
+static uint64_t randomPrime(std::mt19937_64& rng, int bits) {
+    for (;;) {
+        const uint64_t candidate = (rng() >> (64 - bits)) | (1ULL << (bits - 1)) | 1;
+        if (isPrimeMillerRabin(candidate)) return candidate;
+    }
+}
+
+int main(int argc, char** argv) {
+    const int count = (argc > 1) ? std::atoi(argv[1]) : 2000;
+    std::mt19937_64 rng(17);
+
+    struct Workload {
+        const char* name;
+        std::vector<uint64_t> numbers;
+        bool with_baseline;
+    };
+    std::vector<Workload> workloads = {{"random 40-bit", {}, true},
+                                       {"random 64-bit", {}, false},
+                                       {"64-bit primes", {}, false},
+                                       {"32-bit x 32-bit primes", {}, false}};
+    for (int i = 0; i < count; ++i) {
+        workloads[0].numbers.push_back((rng() >> 24) | 2);
+        workloads[1].numbers.push_back(rng() | 2);
+        workloads[2].numbers.push_back(randomPrime(rng, 64));
+        workloads[3].numbers.push_back(randomPrime(rng, 32) * randomPrime(rng, 32));
+    }
+
+    std::cout << std::setw(24) << "workload" << std::setw(14) << "mean us" << std::setw(14) << "max us"
+              << std::setw(16) << "trial div us" << std::endl;
+    for (const Workload& workload : workloads) {
+        double total = 0.0, worst = 0.0;
+        for (uint64_t n : workload.numbers) {
+            const auto start = std::chrono::steady_clock::now();
+            PrimeFactorization64Result result = getPrimeFactorization64(n);
+            const double seconds = secondsSince(start);
+            total += seconds;
+            worst = std::max(worst, seconds);
+            if (!multipliesBack(n, result.factors)) {
+                std::cout << "ERROR: factors of " << n << " do not multiply back" << std::endl;
+                return 1;
+            }
+        }
+        std::cout << std::setw(24) << workload.name << std::fixed << std::setprecision(2) << std::setw(14)
+                  << 1e6 * total / count << std::setw(14) << 1e6 * worst;
+
+        if (workload.with_baseline) {
+            const auto start = std::chrono::steady_clock::now();
+            for (uint64_t n : workload.numbers) {
+                if (PrimeFactors64(trialDivision(n)) != getPrimeFactorization64(n).factors) {
+                    std::cout << "\nERROR: factorizations of " << n << " differ" << std::endl;
+                    return 1;
+                }
+            }
+            std::cout << std::setw(16) << 1e6 * (secondsSince(start) - total) / count;
+        } else {
+            std::cout << std::setw(16) << "-";
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+// File: gcd_throughput_bench.cc
+// Millions of values per second through the batch HCF/LCM kernels against the per-pair API
+// (euclidsAlgorithmHCF, calculateLCM) and a plain std::gcd / std::lcm loop:
+//   pairs:  random ints in [-INT_MAX, INT_MAX], elementwise gcd and lcm;
+//   folds:  gcdOf over multiples of 6 (so it never stops early) and lcmOf over values in
+//           [1, 40] (whose lcm fits in a long long).
+// Every batch result is checked against the std:: loop. The fold part ends by checking
+// that lcmOf throws std::overflow_error on three large primes.
+// Usage: gcd_throughput_bench [count]
+#include "../real_numbers/real_numbers_utils.h"
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace michu_fr::real_numbers;
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void printRow(const char* name, double count, double per_pair_seconds, double std_seconds,
+                     double batch_seconds) {
+    std::cout << std::setw(12) << name << std::fixed << std::setprecision(1);
+    if (per_pair_seconds >= 0.0) {
+        std::cout << std::setw(14) << count / per_pair_seconds / 1e6;
+    } else {
+        std::cout << std::setw(14) << "-";
+    }
+    std::cout << std::setw(14) << count / std_seconds / 1e6 << std::setw(14) << count / batch_seconds / 1e6
+              << std::setw(10) << std_seconds / batch_seconds << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const int count = (argc > 1) ? std::atoi(argv[1]) : 10000000;
+    std::mt19937 rng(23);
+    std::uniform_int_distribution<int> any_int(-INT_MAX, INT_MAX);
+    std::vector<int> a(count), b(count);
+    for (int i = 0; i < count; ++i) {
+        a[i] = any_int(rng);
+        b[i] = any_int(rng);
+    }
+
+    std::cout << std::setw(12) << "workload" << std::setw(14) << "per-pair M/s" << std::setw(14) << "std:: M/s"
+              << std::setw(14) << "batch M/s" << std::setw(10) << "speedup" << std::endl;
+
+    // Elementwise gcd
+    std::vector<int> reference(count), batch(count);
+    unsigned long long checksum = 0; // Keeps the per-pair loops from being optimised away
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) checksum += euclidsAlgorithmHCF(a[i], b[i]).hcf;
+    double per_pair_seconds = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) reference[i] = std::gcd(a[i], b[i]);
+    double std_seconds = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    gcdOfPairs(a.data(), b.data(), batch.data(), batch.size());
+    double batch_seconds = secondsSince(start);
+    if (batch != reference || checksum != std::accumulate(reference.begin(), reference.end(), 0ULL)) {
+        std::cout << "ERROR: gcdOfPairs disagrees with std::gcd" << std::endl;
+        return 1;
+    }
+    printRow("gcd pairs", count, per_pair_seconds, std_seconds, batch_seconds);
+
+    // Elementwise lcm
+    std::vector<long long> lcm_reference(count), lcm_batch(count);
+    checksum = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) checksum += calculateLCM(a[i], b[i]);
+    per_pair_seconds = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        lcm_reference[i] = std::lcm(static_cast<long long>(a[i]), static_cast<long long>(b[i]));
+    }
+    std_seconds = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    lcmOfPairs(a.data(), b.data(), lcm_batch.data(), lcm_batch.size());
+    batch_seconds = secondsSince(start);
+    unsigned long long reference_sum = 0;
+    for (long long value : lcm_reference) reference_sum += value; // Wraps identically on both sides
+    if (lcm_batch != lcm_reference || checksum != reference_sum) {
+        std::cout << "ERROR: lcmOfPairs disagrees with std::lcm" << std::endl;
+        return 1;
+    }
+    printRow("lcm pairs", count, per_pair_seconds, std_seconds, batch_seconds);
+
+    // gcd fold: multiples of 6 keep every prefix gcd above 1
+    std::uniform_int_distribution<int> multiplier(1, INT_MAX / 6);
+    for (int& value : a) value = 6 * multiplier(rng);
+    start = std::chrono::steady_clock::now();
+    int folded = 0;
+    for (int value : a) folded = std::gcd(folded, value);
+    std_seconds = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    const int batch_gcd = gcdOf(a);
+    batch_seconds = secondsSince(start);
+    if (batch_gcd != folded) {
+        std::cout << "ERROR: gcdOf gave " << batch_gcd << ", std::gcd fold " << folded << std::endl;
+        return 1;
+    }
+    printRow("gcdOf", count, -1.0, std_seconds, batch_seconds);
+
+    // lcm fold over small values
+    std::uniform_int_distribution<int> small(1, 40);
+    for (int& value : a) value = small(rng);
+    start = std::chrono::steady_clock::now();
+    long long folded_lcm = 1;
+    for (int value : a) folded_lcm = std::lcm(folded_lcm, static_cast<long long>(value));
+    std_seconds = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    const long long batch_lcm = lcmOf(a);
+    batch_seconds = secondsSince(start);
+    if (batch_lcm != folded_lcm) {
+        std::cout << "ERROR: lcmOf gave " << batch_lcm << ", std::lcm fold " << folded_lcm << std::endl;
+        return 1;
+    }
+    printRow("lcmOf", count, -1.0, std_seconds, batch_seconds);
+
+    try {
+        lcmOf(std::vector<int>{2147483647, 2147483629, 2147483587});
+        std::cout << "ERROR: lcmOf did not detect overflow" << std::endl;
+        return 1;
+    } catch (const std::overflow_error&) {
+        std::cout << "lcmOf overflow detected as expected" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+// File: gemm_bench.cc
+// GFLOP/s of the packed, cache-blocked GEMM against the original naive i-j-k loop
+// over vector<vector<double>>. Usage: gemm_bench [max_n] [naive_max_n]
+#include "../matrix/matrix_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// The multiplyMatrices loop as it was before the blocked kernel
+static Matrix naiveMultiply(const Matrix& a, const Matrix& b) {
+    size_t rows = a.size(), inner = b.size(), cols = b[0].size();
+    Matrix result(rows, std::vector<double>(cols, 0.0));
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < cols; ++j) {
+            for (size_t k = 0; k < inner; ++k) {
+                result[i][j] += a[i][k] * b[k][j];
+            }
+        }
+    }
+    return result;
+}
+
+static Matrix randomMatrix(int n, std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    Matrix m(n, std::vector<double>(n));
+    for (auto& row : m) {
+        for (double& v : row) v = dist(rng);
+    }
+    return m;
+}
+
+// Runs fn until at least min_seconds have passed; returns seconds per call
+template <typename Fn>
+static double timePerCall(Fn&& fn, double min_seconds = 0.3) {
+    int reps = 0;
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+    do {
+        fn();
+        ++reps;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (elapsed < min_seconds);
+    return elapsed / reps;
+}
+
+int main(int argc, char** argv) {
+    int max_n = (argc > 1) ? std::atoi(argv[1]) : 4096;
+    int naive_max_n = (argc > 2) ? std::atoi(argv[2]) : 1024;
+    std::mt19937_64 rng(7);
+
+    MatrixUtils::GemmBlocking blk = MatrixUtils::getGemmBlocking();
+    std::cout << "--- GEMM throughput (" << MatrixUtils::gemmKernelName() << ", mc=" << blk.mc
+              << " kc=" << blk.kc << " nc=" << blk.nc << ") ---" << std::endl;
+    std::cout << std::setw(8) << "n" << std::setw(14) << "naive GF/s" << std::setw(14) << "legacy API"
+              << std::setw(14) << "dense GF/s" << std::setw(12) << "speedup" << std::setw(12) << "max err" << std::endl;
+
+    for (int n = 128; n <= max_n; n *= 2) {
+        Matrix a = randomMatrix(n, rng);
+        Matrix b = randomMatrix(n, rng);
+        MatrixUtils::DenseMatrix da(a), db(b), dc(n, n);
+        double flops = 2.0 * n * n * static_cast<double>(n);
+
+        double t_dense = timePerCall([&] { MatrixUtils::gemm(1.0, da, db, 0.0, dc); });
+        double t_api = timePerCall([&] { MatrixUtils::multiplyMatrices(a, b); });
+
+        std::cout << std::setw(8) << n << std::fixed << std::setprecision(2);
+        if (n <= naive_max_n) {
+            Matrix ref;
+            double t_naive = timePerCall([&] { ref = naiveMultiply(a, b); }, 0.0);
+            double max_err = 0.0;
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) max_err = std::max(max_err, std::fabs(ref[i][j] - dc(i, j)));
+            }
+            std::cout << std::setw(14) << flops / t_naive * 1e-9 << std::setw(14) << flops / t_api * 1e-9
+                      << std::setw(14) << flops / t_dense * 1e-9 << std::setw(11) << t_naive / t_dense << "x"
+                      << std::setw(12) << std::scientific << std::setprecision(1) << max_err;
+        } else {
+            std::cout << std::setw(14) << "-" << std::setw(14) << flops / t_api * 1e-9
+                      << std::setw(14) << flops / t_dense * 1e-9;
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+// File: matrix_file_bench.cc
+// Time to get a matrix into memory from disk, four ways: parsing whitespace-separated text
+// into a nested-vector Matrix (the current input path), loadMatrixFile on the binary
+// format, opening a MappedMatrixFile (zero-copy; nothing is read yet) and mapping plus
+// one full pass over the view. Files are written to the given directory and removed
+// afterwards; timings are with a warm page cache, so they measure parsing and copying
+// rather than the disk. Text is skipped above 1 GB and loadMatrixFile once the matrix
+// would not fit in half of physical memory; the mapped pass still runs there.
+// Usage: matrix_file_bench [max_mb] [directory]
+#include "../matrix/matrix_utils.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+static double secondsOf(void (*fn)(const std::string&, double&), const std::string& path, double& out) {
+    auto start = std::chrono::steady_clock::now();
+    fn(path, out);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void parseText(const std::string& path, double& out) {
+    std::ifstream in(path);
+    int rows = 0, cols = 0;
+    in >> rows >> cols;
+    Matrix m(rows, std::vector<double>(cols));
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) in >> m[i][j];
+    }
+    out = m[rows - 1][cols - 1];
+}
+
+static void loadBinary(const std::string& path, double& out) {
+    MatrixUtils::DenseMatrix m = MatrixUtils::loadMatrixFile(path);
+    out = m(m.rows() - 1, m.cols() - 1);
+}
+
+static void mapOnly(const std::string& path, double& out) {
+    MatrixUtils::MappedMatrixFile file(path);
+    out = static_cast<double>(file.info().rows);
+}
+
+static void mapAndSum(const std::string& path, double& out) {
+    MatrixUtils::MappedMatrixFile file(path);
+    file.adviseSequential();
+    MatrixUtils::ConstDenseMatrixView v = file.view();
+    double sum = 0.0;
+    for (int i = 0; i < v.rows(); ++i) {
+        const double* row = v.row(i);
+        for (int j = 0; j < v.cols(); ++j) sum += row[j];
+    }
+    out = sum;
+}
+
+int main(int argc, char** argv) {
+    long long max_mb = (argc > 1) ? std::atoll(argv[1]) : 1000;
+    std::string dir = (argc > 2) ? argv[2] : "/tmp";
+    const int cols = 1000;
+    const double ram_bytes = static_cast<double>(sysconf(_SC_PHYS_PAGES)) * sysconf(_SC_PAGE_SIZE);
+
+    std::cout << "--- Load time, seconds (warm cache) ---" << std::endl;
+    std::cout << std::setw(8) << "MB" << std::setw(12) << "text MB" << std::setw(12) << "text"
+              << std::setw(12) << "load" << std::setw(12) << "map" << std::setw(12) << "map+pass" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    volatile double sink = 0.0; // Keeps the loads from being optimised away
+    for (long long mb = 100; mb <= max_mb; mb *= 10) {
+        const int rows = static_cast<int>(mb * 1000000 / (sizeof(double) * cols));
+        const std::string bin_path = dir + "/matrix_file_bench.nmat";
+        const std::string text_path = dir + "/matrix_file_bench.txt";
+        const bool with_text = mb <= 1000;
+        const bool with_load = static_cast<double>(rows) * cols * sizeof(double) < ram_bytes / 2;
+
+        // Stream both files out one row at a time so generation never holds the matrix
+        {
+            MatrixUtils::MatrixFileWriter writer(bin_path, cols);
+            std::FILE* text = with_text ? std::fopen(text_path.c_str(), "w") : nullptr;
+            if (text) std::fprintf(text, "%d %d\n", rows, cols);
+            std::vector<double> row(cols);
+            unsigned long long state = 88172645463325252ULL;
+            for (int i = 0; i < rows; ++i) {
+                for (int j = 0; j < cols; ++j) {
+                    state ^= state << 13;
+                    state ^= state >> 7;
+                    state ^= state << 17;
+                    row[j] = static_cast<double>(state >> 11) * 0x1.0p-53 - 0.5;
+                    if (text) std::fprintf(text, j + 1 < cols ? "%.17g " : "%.17g\n", row[j]);
+                }
+                writer.writeRow(row.data());
+            }
+            writer.close();
+            if (text) std::fclose(text);
+        }
+
+        double value = 0.0;
+        double text_mb = 0.0, text_time = 0.0, load_time = 0.0;
+        if (with_text) {
+            std::ifstream probe(text_path, std::ios::ate | std::ios::binary);
+            text_mb = static_cast<double>(probe.tellg()) / 1e6;
+            text_time = secondsOf(parseText, text_path, value);
+            sink = value;
+        }
+        if (with_load) {
+            load_time = secondsOf(loadBinary, bin_path, value);
+            sink = value;
+        }
+        double map_time = secondsOf(mapOnly, bin_path, value);
+        sink = value;
+        double pass_time = secondsOf(mapAndSum, bin_path, value);
+        sink = value;
+
+        std::cout << std::setw(8) << mb;
+        if (with_text) {
+            std::cout << std::setw(12) << std::setprecision(0) << text_mb << std::setprecision(3)
+                      << std::setw(12) << text_time;
+        } else {
+            std::cout << std::setw(12) << "-" << std::setw(12) << "-";
+        }
+        if (with_load) {
+            std::cout << std::setw(12) << load_time;
+        } else {
+            std::cout << std::setw(12) << "-";
+        }
+        std::cout << std::setw(12) << map_time << std::setw(12) << pass_time << std::endl;
+
+        std::remove(bin_path.c_str());
+        if (with_text) std::remove(text_path.c_str());
+    }
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,109 @@
+// File: matrix_functions_bench.cc
+// Part 1: A^k for a random row-stochastic (Markov) matrix, k multiplies in a loop against
+// matrixPower's binary exponentiation; the row sums of the result must stay 1.
+// Part 2: matrixExp on symmetric matrices of growing norm (so growing squaring counts),
+// checked against V * exp(D) * V^T from the symmetric eigendecomposition.
+// Usage: matrix_functions_bench [n]
+#include "../matrix/matrix_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+using MatrixUtils::DenseMatrix;
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double maxAbsDifference(const DenseMatrix& a, const DenseMatrix& b) {
+    double diff = 0.0;
+    for (int i = 0; i < a.rows(); ++i) {
+        for (int j = 0; j < a.cols(); ++j) diff = std::max(diff, std::fabs(a(i, j) - b(i, j)));
+    }
+    return diff;
+}
+
+int main(int argc, char** argv) {
+    const int n = (argc > 1) ? std::atoi(argv[1]) : 512;
+    std::mt19937_64 rng(3);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    DenseMatrix markov(n, n);
+    for (int i = 0; i < n; ++i) {
+        double sum = 0.0;
+        for (int j = 0; j < n; ++j) sum += markov(i, j) = uniform(rng);
+        for (int j = 0; j < n; ++j) markov(i, j) /= sum;
+    }
+
+    std::cout << "--- Markov matrix power, n = " << n << " ---" << std::endl;
+    std::cout << std::setw(10) << "k" << std::setw(12) << "loop s" << std::setw(12) << "power s" << std::setw(10)
+              << "speedup" << std::setw(12) << "max diff" << std::setw(14) << "row sum err" << std::endl;
+    for (long long k : {8LL, 100LL, 1000LL, 1000000LL}) {
+        double loop_seconds = -1.0;
+        DenseMatrix looped;
+        if (k <= 1000) { // The loop is the baseline; beyond this it only burns time
+            auto start = std::chrono::steady_clock::now();
+            looped = markov;
+            DenseMatrix next(n, n);
+            for (long long step = 1; step < k; ++step) {
+                MatrixUtils::gemm(1.0, looped, markov, 0.0, next);
+                looped.swap(next);
+            }
+            loop_seconds = secondsSince(start);
+        }
+        auto start = std::chrono::steady_clock::now();
+        DenseMatrix powered = MatrixUtils::matrixPower(markov, k);
+        double power_seconds = secondsSince(start);
+
+        double row_error = 0.0;
+        for (int i = 0; i < n; ++i) {
+            double sum = 0.0;
+            for (int j = 0; j < n; ++j) sum += powered(i, j);
+            row_error = std::max(row_error, std::fabs(sum - 1.0));
+        }
+        std::cout << std::setw(10) << k << std::fixed << std::setprecision(4);
+        if (loop_seconds >= 0.0) {
+            std::cout << std::setw(12) << loop_seconds << std::setw(12) << power_seconds << std::setprecision(1)
+                      << std::setw(10) << loop_seconds / power_seconds << std::scientific << std::setprecision(2)
+                      << std::setw(12) << maxAbsDifference(looped, powered);
+        } else {
+            std::cout << std::setw(12) << "-" << std::setw(12) << power_seconds << std::setw(10) << "-"
+                      << std::setw(12) << "-" << std::scientific << std::setprecision(2);
+        }
+        std::cout << std::setw(14) << row_error << std::fixed << std::endl;
+    }
+
+    std::cout << "\n--- Matrix exponential of symmetric A, n = " << n << " ---" << std::endl;
+    std::cout << std::setw(10) << "||A||_2" << std::setw(12) << "exp s" << std::setw(14) << "rel error" << std::endl;
+    std::uniform_real_distribution<double> centred(-1.0, 1.0);
+    DenseMatrix base(n, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j <= i; ++j) base(i, j) = base(j, i) = centred(rng);
+    }
+    MatrixUtils::SymmetricEigenDecomposition eig = MatrixUtils::symmetricEigenDecompose(base);
+    const double base_norm = std::max(std::fabs(eig.eigenvalues.front()), std::fabs(eig.eigenvalues.back()));
+    DenseMatrix vt(n, n);
+    MatrixUtils::transposeInto(eig.eigenvectors, vt);
+    for (double target : {0.01, 1.0, 10.0, 100.0}) {
+        const double scale = target / base_norm;
+        DenseMatrix a = scale * base;
+        auto start = std::chrono::steady_clock::now();
+        DenseMatrix result = MatrixUtils::matrixExp(a);
+        double seconds = secondsSince(start);
+
+        DenseMatrix scaled_vectors = eig.eigenvectors;
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) scaled_vectors(i, j) *= std::exp(scale * eig.eigenvalues[j]);
+        }
+        DenseMatrix reference = MatrixUtils::multiplyMatrices(scaled_vectors, vt);
+        std::cout << std::setw(10) << target << std::fixed << std::setprecision(4) << std::setw(12) << seconds
+                  << std::scientific << std::setprecision(2) << std::setw(14)
+                  << maxAbsDifference(result, reference) / maxAbsDifference(reference, DenseMatrix(n, n))
+                  << std::fixed << std::setprecision(2) << std::endl;
+    }
+    return 0;
+}
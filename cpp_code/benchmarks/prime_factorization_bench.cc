@@ -0,0 +1,116 @@
+// File: prime_factorization_bench.cc
+// Factorizations per second by trial division (getPrimeFactorization(n)) and by the
+// smallest-prime-factor table, over consecutive small integers, over random integers inside
+// the table and over random integers up to INT_MAX (which fall back to trial division by the
+// table's primes until the cofactor fits). Every table result is checked against trial division.
+// The last column walks the table without building a result, i.e. the cost of the lookups alone.
+// Last, HCF and LCM of consecutive pairs by merging their factorizations, held as flat
+// PrimeFactors and converted to std::map.
+// Usage: prime_factorization_bench [count]
+#include "../real_numbers/real_numbers_utils.h"
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace michu_fr::real_numbers;
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    const int count = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+
+    auto start = std::chrono::steady_clock::now();
+    const SmallestPrimeFactorTable& table = sharedSmallestPrimeFactorTable();
+    std::cout << "Shared table: limit " << table.limit() << ", " << table.primes().size() << " primes, built in "
+              << std::fixed << std::setprecision(4) << secondsSince(start) << " s" << std::endl;
+
+    std::mt19937 rng(11);
+    struct Workload {
+        const char* name;
+        std::vector<int> numbers;
+    };
+    std::vector<Workload> workloads(3);
+    workloads[0].name = "2 .. count+1";
+    workloads[1].name = "random < table limit";
+    workloads[2].name = "random < INT_MAX";
+    std::uniform_int_distribution<int> in_table(2, static_cast<int>(table.limit()));
+    std::uniform_int_distribution<int> any_int(2, INT_MAX);
+    for (int i = 0; i < count; ++i) {
+        workloads[0].numbers.push_back(i + 2);
+        workloads[1].numbers.push_back(in_table(rng));
+        workloads[2].numbers.push_back(any_int(rng));
+    }
+
+    std::cout << std::setw(24) << "workload" << std::setw(16) << "trial /s" << std::setw(16) << "table /s"
+              << std::setw(10) << "speedup" << std::setw(18) << "lookups only /s" << std::endl;
+    for (const Workload& workload : workloads) {
+        std::vector<PrimeFactorizationResult> trial;
+        trial.reserve(workload.numbers.size());
+        start = std::chrono::steady_clock::now();
+        for (int n : workload.numbers) trial.push_back(getPrimeFactorization(n));
+        const double trial_seconds = secondsSince(start);
+
+        std::vector<PrimeFactorizationResult> looked_up;
+        looked_up.reserve(workload.numbers.size());
+        start = std::chrono::steady_clock::now();
+        for (int n : workload.numbers) looked_up.push_back(getPrimeFactorization(n, table));
+        const double table_seconds = secondsSince(start);
+
+        long long exponent_sum = 0; // Keeps the walk from being optimised away
+        start = std::chrono::steady_clock::now();
+        for (int n : workload.numbers) {
+            table.forEachPrimeFactor(static_cast<uint32_t>(n), [&](uint32_t, int e) { exponent_sum += e; });
+        }
+        const double walk_seconds = secondsSince(start);
+
+        long long expected_sum = 0;
+        for (size_t i = 0; i < trial.size(); ++i) {
+            for (const auto& factor : trial[i].factors) expected_sum += factor.second;
+            if (trial[i].factors != looked_up[i].factors) {
+                std::cout << "ERROR: factorizations of " << workload.numbers[i] << " differ" << std::endl;
+                return 1;
+            }
+        }
+        std::cout << std::setw(24) << workload.name << std::setprecision(0) << std::setw(16) << count / trial_seconds
+                  << std::setw(16) << count / table_seconds << std::setprecision(1) << std::setw(10)
+                  << trial_seconds / table_seconds << std::setprecision(0) << std::setw(18) << count / walk_seconds
+                  << std::endl;
+        if (exponent_sum != expected_sum) {
+            std::cout << "ERROR: table walk counted " << exponent_sum << " prime factors, expected " << expected_sum
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<PrimeFactors> flat;
+    std::vector<std::map<int, int>> maps;
+    for (int n : workloads[1].numbers) {
+        flat.push_back(getPrimeFactorization(n, table).factors);
+        maps.push_back(flat.back().toMap());
+    }
+    long long flat_sum = 0, map_sum = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 1; i < flat.size(); ++i) {
+        flat_sum += hcfFromPrimeFactorization(flat[i - 1], flat[i]) + lcmFromPrimeFactorization(flat[i - 1], flat[i]);
+    }
+    const double flat_seconds = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 1; i < maps.size(); ++i) {
+        map_sum += hcfFromPrimeFactorization(maps[i - 1], maps[i]) + lcmFromPrimeFactorization(maps[i - 1], maps[i]);
+    }
+    const double map_seconds = secondsSince(start);
+    if (flat_sum != map_sum) {
+        std::cout << "ERROR: HCF/LCM over flat lists and maps differ" << std::endl;
+        return 1;
+    }
+    std::cout << "HCF + LCM by merge, " << workloads[1].name << ": std::map " << std::setprecision(0)
+              << count / map_seconds << " /s, flat " << count / flat_seconds << " /s" << std::endl;
+    return 0;
+}
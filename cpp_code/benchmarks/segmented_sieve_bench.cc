@@ -0,0 +1,68 @@
+// File: segmented_sieve_bench.cc
+// countPrimesInRange and primesInRange over [0, 10^9] and [10^12, 10^12 + 10^9] for
+// 1, 2, 4, ... threads up to the hardware count, and isPrimeBasic called number by number
+// as the baseline on the 10^6 ints up to 10^9. The count below 10^9 is checked against
+// the known pi(10^9) = 50847534, and the callback's count against countPrimesInRange.
+// Usage: segmented_sieve_bench [span]   (default 10^9)
+#include "../real_numbers/real_numbers_utils.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace michu_fr::real_numbers;
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    const uint64_t span = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000000ULL;
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+
+    const uint64_t baseline_high = 1000000000ULL;
+    const uint64_t baseline_low = baseline_high - 1000000 + 1;
+    auto start = std::chrono::steady_clock::now();
+    uint64_t baseline_count = 0;
+    for (uint64_t n = baseline_low; n <= baseline_high; ++n) {
+        baseline_count += isPrimeBasic(static_cast<int>(n)) ? 1 : 0;
+    }
+    const double baseline_seconds = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    const uint64_t sieve_count = countPrimesInRange(baseline_low, baseline_high, 1);
+    const double sieve_seconds = secondsSince(start);
+    std::cout << "10^6 ints up to 10^9: isPrimeBasic " << std::fixed << std::setprecision(4)
+              << baseline_seconds << " s, sieve " << sieve_seconds << " s (" << baseline_count << " / "
+              << sieve_count << " primes)" << std::endl;
+    if (baseline_count != sieve_count) {
+        std::cout << "ERROR: counts differ" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::setw(30) << "range" << std::setw(9) << "threads" << std::setw(12) << "count s"
+              << std::setw(14) << "callback s" << std::setw(14) << "primes" << std::endl;
+    for (uint64_t low : {0ULL, 1000000000000ULL}) {
+        const uint64_t high = low + span;
+        for (unsigned threads = 1; threads <= hardware; threads *= 2) {
+            start = std::chrono::steady_clock::now();
+            const uint64_t count = countPrimesInRange(low, high, threads);
+            const double count_seconds = secondsSince(start);
+
+            uint64_t visited = 0;
+            start = std::chrono::steady_clock::now();
+            primesInRange(low, high, [&](uint64_t) { ++visited; }, threads);
+            const double visit_seconds = secondsSince(start);
+
+            std::cout << std::setw(30) << ("[" + std::to_string(low) + ", +" + std::to_string(span) + "]") << std::setw(9) << threads
+                      << std::setprecision(3) << std::setw(12) << count_seconds << std::setw(14) << visit_seconds
+                      << std::setw(14) << count << std::endl;
+            if (visited != count || (low == 0 && span == 1000000000ULL && count != 50847534ULL)) {
+                std::cout << "ERROR: prime counts disagree" << std::endl;
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+// File: sparse_bench.cc
+// CSR kernels on synthetic banded (5 nonzeros per row) and random (10 per row) matrices
+// from 100K to 10M nonzeros: assembly, SpMV, transpose, A + A^T and A * A.
+// Usage: sparse_bench [max_nnz] [threads]   (SpGEMM on random inputs stops at 1M nonzeros,
+// since its output grows ~10x and would not fit in memory at the top size)
+#include "../matrix/matrix_utils.h"
+#include "../matrix/thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using MatrixUtils::CsrMatrix;
+using MatrixUtils::SparseTriplet;
+
+template <typename Fn>
+static double secondsPerCall(Fn&& fn) {
+    int reps = 0;
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+    do {
+        fn();
+        ++reps;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (elapsed < 0.3);
+    return elapsed / reps;
+}
+
+static std::vector<SparseTriplet> bandedTriplets(int n, int half_width, std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<SparseTriplet> triplets;
+    triplets.reserve(static_cast<size_t>(n) * (2 * half_width + 1));
+    for (int r = 0; r < n; ++r) {
+        for (int c = std::max(0, r - half_width); c <= std::min(n - 1, r + half_width); ++c) {
+            triplets.push_back({r, c, dist(rng)});
+        }
+    }
+    return triplets;
+}
+
+static std::vector<SparseTriplet> randomTriplets(int n, int per_row, std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::uniform_int_distribution<int> col(0, n - 1);
+    std::vector<SparseTriplet> triplets;
+    triplets.reserve(static_cast<size_t>(n) * per_row);
+    for (int r = 0; r < n; ++r) {
+        for (int k = 0; k < per_row; ++k) triplets.push_back({r, col(rng), dist(rng)});
+    }
+    return triplets;
+}
+
+static void runCase(const std::string& kind, int n, std::vector<SparseTriplet> triplets, bool with_spgemm) {
+    auto start = std::chrono::steady_clock::now();
+    CsrMatrix a = CsrMatrix::fromTriplets(n, n, std::move(triplets));
+    double build = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> x(n, 1.0), y(n, 0.0);
+    double spmv = secondsPerCall([&] { MatrixUtils::spmv(1.0, a, x.data(), 0.0, y.data()); });
+    // Bytes streamed per SpMV: value + column index per nonzero, row pointer and y per row
+    double bytes = static_cast<double>(a.nnz()) * (sizeof(double) + sizeof(int)) +
+                   static_cast<double>(n) * (sizeof(size_t) + 2 * sizeof(double));
+
+    CsrMatrix at;
+    double transpose = secondsPerCall([&] { at = MatrixUtils::transposeMatrix(a); });
+    size_t sum_nnz = 0;
+    double add = secondsPerCall([&] { sum_nnz = MatrixUtils::addMatrices(a, at).nnz(); });
+
+    std::cout << std::setw(8) << kind << std::setw(12) << a.nnz() << std::setw(11) << build
+              << std::setw(11) << spmv * 1e3 << std::setw(9) << (2.0 * a.nnz() / spmv / 1e9)
+              << std::setw(9) << (bytes / spmv / 1e9) << std::setw(11) << transpose * 1e3
+              << std::setw(11) << add * 1e3;
+    if (with_spgemm) {
+        size_t product_nnz = 0;
+        double spgemm = secondsPerCall([&] { product_nnz = MatrixUtils::multiplyMatrices(a, a).nnz(); });
+        std::cout << std::setw(12) << spgemm * 1e3 << std::setw(12) << product_nnz;
+    } else {
+        std::cout << std::setw(12) << "-" << std::setw(12) << "-";
+    }
+    std::cout << std::endl;
+    (void)sum_nnz;
+}
+
+int main(int argc, char** argv) {
+    long long max_nnz = (argc > 1) ? std::atoll(argv[1]) : 10000000LL;
+    if (argc > 2) MatrixUtils::setMatrixThreadCount(std::atoi(argv[2]));
+    std::mt19937_64 rng(11);
+
+    std::cout << "--- Sparse CSR kernels (" << MatrixUtils::getMatrixThreadCount() << " thread(s)) ---" << std::endl;
+    std::cout << std::setw(8) << "input" << std::setw(12) << "nnz" << std::setw(11) << "build s"
+              << std::setw(11) << "spmv ms" << std::setw(9) << "GF/s" << std::setw(9) << "GB/s"
+              << std::setw(11) << "A^T ms" << std::setw(11) << "A+A^T ms" << std::setw(12) << "A*A ms"
+              << std::setw(12) << "nnz(A*A)" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (long long nnz = 100000; nnz <= max_nnz; nnz *= 10) {
+        int banded_n = static_cast<int>(nnz / 5);
+        runCase("banded", banded_n, bandedTriplets(banded_n, 2, rng), true);
+        int random_n = static_cast<int>(nnz / 10);
+        runCase("random", random_n, randomTriplets(random_n, 10, rng), nnz <= 1000000);
+    }
+    return 0;
+}
@@ -0,0 +1,65 @@
+// File: thread_scaling_bench.cc
+// Parallel efficiency of the tiled GEMM from 1 to N pool threads, plus a bitwise
+// determinism check against the single-thread result.
+// Usage: thread_scaling_bench [n] [max_threads]
+#include "../matrix/matrix_utils.h"
+#include "../matrix/thread_pool.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+
+int main(int argc, char** argv) {
+    int n = (argc > 1) ? std::atoi(argv[1]) : 2048;
+    int hw = static_cast<int>(std::thread::hardware_concurrency());
+    int max_threads = (argc > 2) ? std::atoi(argv[2]) : (hw > 0 ? hw : 1);
+
+    std::mt19937_64 rng(11);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    MatrixUtils::DenseMatrix a(n, n), b(n, n), reference(n, n), c(n, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            a(i, j) = dist(rng);
+            b(i, j) = dist(rng);
+        }
+    }
+
+    std::cout << "--- GEMM thread scaling (n=" << n << ", " << MatrixUtils::gemmKernelName() << ") ---" << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(12) << "seconds" << std::setw(12) << "GFLOP/s"
+              << std::setw(12) << "speedup" << std::setw(14) << "efficiency" << std::setw(16) << "deterministic"
+              << std::endl;
+
+    double flops = 2.0 * n * n * static_cast<double>(n);
+    double base_time = 0.0;
+    for (int threads = 1; threads <= max_threads; threads = (threads < max_threads && threads * 2 > max_threads) ? max_threads : threads * 2) {
+        MatrixUtils::setMatrixThreadCount(threads);
+        MatrixUtils::DenseMatrix& out = (threads == 1) ? reference : c;
+        MatrixUtils::gemm(1.0, a, b, 0.0, out); // Warm-up: spins up threads, sizes pack buffers
+
+        int reps = 0;
+        auto start = std::chrono::steady_clock::now();
+        double elapsed = 0.0;
+        do {
+            MatrixUtils::gemm(1.0, a, b, 0.0, out);
+            ++reps;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < 1.0);
+        double per_op = elapsed / reps;
+        if (threads == 1) base_time = per_op;
+
+        bool identical = true;
+        for (int i = 0; i < n && identical; ++i) {
+            identical = std::memcmp(out.row(i), reference.row(i), n * sizeof(double)) == 0;
+        }
+        double speedup = base_time / per_op;
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(4) << std::setw(12) << per_op
+                  << std::setprecision(2) << std::setw(12) << flops / per_op * 1e-9 << std::setw(11) << speedup << "x"
+                  << std::setw(13) << 100.0 * speedup / threads << "%" << std::setw(16) << (identical ? "yes" : "NO")
+                  << std::endl;
+        if (threads == max_threads) break;
+    }
+    return 0;
+}
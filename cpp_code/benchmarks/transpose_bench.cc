@@ -0,0 +1,70 @@
+// File: transpose_bench.cc
+// Effective bandwidth (bytes read + written per second) of a naive strided transpose,
+// the legacy Matrix transposeMatrix, the cache-oblivious transposeInto and the in-place
+// square transpose. Power-of-two sizes are included on purpose: they make the naive
+// version's column writes collide in the same cache sets.
+// Usage: transpose_bench [max_n]
+#include "../matrix/matrix_utils.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+template <typename Fn>
+static double secondsPerCall(Fn&& fn) {
+    int reps = 0;
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+    do {
+        fn();
+        ++reps;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (elapsed < 0.3);
+    return elapsed / reps;
+}
+
+static void naiveTranspose(MatrixUtils::ConstDenseMatrixView src, MatrixUtils::DenseMatrixView dst) {
+    for (int i = 0; i < src.rows(); ++i) {
+        for (int j = 0; j < src.cols(); ++j) dst(j, i) = src(i, j);
+    }
+}
+
+int main(int argc, char** argv) {
+    int max_n = (argc > 1) ? std::atoi(argv[1]) : 4096;
+    std::mt19937_64 rng(12);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    std::cout << "--- Transpose bandwidth, GB/s ---" << std::endl;
+    std::cout << std::setw(8) << "n" << std::setw(12) << "naive" << std::setw(12) << "legacy"
+              << std::setw(12) << "into" << std::setw(12) << "in-place" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::vector<int> sizes;
+    for (int n = 256; n <= max_n; n *= 2) {
+        sizes.push_back(n);
+        if (n + 100 <= max_n) sizes.push_back(n + 100);
+    }
+    volatile double sink = 0.0; // Keeps the timed calls from being optimised away
+    for (int n : sizes) {
+        MatrixUtils::DenseMatrix a(n, n), out(n, n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) a(i, j) = dist(rng);
+        }
+        Matrix legacy = a.toMatrix();
+        const double bytes = 2.0 * sizeof(double) * n * n;
+
+        double naive = secondsPerCall([&] { naiveTranspose(a, out); });
+        double legacy_time = secondsPerCall([&] { sink = MatrixUtils::transposeMatrix(legacy)[n - 1][0]; });
+        double into = secondsPerCall([&] { MatrixUtils::transposeInto(a, out); });
+        double in_place = secondsPerCall([&] { MatrixUtils::transposeInPlace(a.view()); });
+        sink = out(0, n - 1) + a(0, n - 1);
+
+        std::cout << std::setw(8) << n << std::setw(12) << bytes / naive / 1e9 << std::setw(12)
+                  << bytes / legacy_time / 1e9 << std::setw(12) << bytes / into / 1e9 << std::setw(12)
+                  << bytes / in_place / 1e9 << std::endl;
+    }
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,217 @@
+// File: big_integer.cc
+#include "big_integer.h"
+#include <algorithm> // For std::reverse
+#include <utility>   // For std::move
+#include <limits>
+#include <stdexcept>
+
+namespace MatrixUtils {
+
+    BigInteger::BigInteger(long long value) {
+        negative_ = value < 0;
+        // Negate in unsigned arithmetic so LLONG_MIN is handled
+        unsigned long long magnitude = negative_ ? 0ULL - static_cast<unsigned long long>(value)
+                                                 : static_cast<unsigned long long>(value);
+        while (magnitude != 0) {
+            limbs_.push_back(static_cast<uint32_t>(magnitude));
+            magnitude >>= 32;
+        }
+    }
+
+    bool BigInteger::fitsInt64() const {
+        if (limbs_.size() > 2) return false;
+        unsigned long long magnitude = 0;
+        for (size_t i = limbs_.size(); i-- > 0;) magnitude = (magnitude << 32) | limbs_[i];
+        unsigned long long limit = static_cast<unsigned long long>(std::numeric_limits<long long>::max());
+        return negative_ ? magnitude <= limit + 1 : magnitude <= limit;
+    }
+
+    long long BigInteger::toInt64() const {
+        unsigned long long magnitude = 0;
+        for (size_t i = limbs_.size(); i-- > 0;) magnitude = (magnitude << 32) | limbs_[i];
+        return negative_ ? static_cast<long long>(0ULL - magnitude) : static_cast<long long>(magnitude);
+    }
+
+    std::string BigInteger::toString() const {
+        if (isZero()) return "0";
+        Limbs work = limbs_;
+        std::string digits;
+        while (!work.empty()) {
+            uint32_t chunk = divideSmallInPlace(work, 1000000000u);
+            for (int i = 0; i < 9; ++i) {
+                digits.push_back(static_cast<char>('0' + chunk % 10));
+                chunk /= 10;
+                if (work.empty() && chunk == 0) break;
+            }
+        }
+        if (negative_) digits.push_back('-');
+        std::reverse(digits.begin(), digits.end());
+        return digits;
+    }
+
+    BigInteger BigInteger::operator-() const {
+        return make(limbs_, !negative_);
+    }
+
+    BigInteger operator+(const BigInteger& a, const BigInteger& b) {
+        if (a.negative_ == b.negative_) {
+            return BigInteger::make(BigInteger::addMagnitude(a.limbs_, b.limbs_), a.negative_);
+        }
+        if (BigInteger::compareMagnitude(a.limbs_, b.limbs_) >= 0) {
+            return BigInteger::make(BigInteger::subtractMagnitude(a.limbs_, b.limbs_), a.negative_);
+        }
+        return BigInteger::make(BigInteger::subtractMagnitude(b.limbs_, a.limbs_), b.negative_);
+    }
+
+    BigInteger operator-(const BigInteger& a, const BigInteger& b) {
+        return a + (-b);
+    }
+
+    BigInteger operator*(const BigInteger& a, const BigInteger& b) {
+        return BigInteger::make(BigInteger::multiplyMagnitude(a.limbs_, b.limbs_), a.negative_ != b.negative_);
+    }
+
+    BigInteger operator/(const BigInteger& a, const BigInteger& b) {
+        if (b.isZero()) {
+            throw std::domain_error("BigInteger division by zero.");
+        }
+        return BigInteger::make(BigInteger::divideMagnitude(a.limbs_, b.limbs_), a.negative_ != b.negative_);
+    }
+
+    // --- Magnitude helpers ---
+
+    BigInteger BigInteger::make(Limbs limbs, bool negative) {
+        BigInteger result;
+        trim(limbs);
+        result.limbs_ = std::move(limbs);
+        result.negative_ = negative && !result.limbs_.empty(); // No negative zero
+        return result;
+    }
+
+    void BigInteger::trim(Limbs& a) {
+        while (!a.empty() && a.back() == 0) a.pop_back();
+    }
+
+    int BigInteger::compareMagnitude(const Limbs& a, const Limbs& b) {
+        if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+        for (size_t i = a.size(); i-- > 0;) {
+            if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    BigInteger::Limbs BigInteger::addMagnitude(const Limbs& a, const Limbs& b) {
+        const Limbs& longer = a.size() >= b.size() ? a : b;
+        const Limbs& shorter = a.size() >= b.size() ? b : a;
+        Limbs out(longer.size() + 1);
+        uint64_t carry = 0;
+        for (size_t i = 0; i < longer.size(); ++i) {
+            uint64_t sum = carry + longer[i] + (i < shorter.size() ? shorter[i] : 0u);
+            out[i] = static_cast<uint32_t>(sum);
+            carry = sum >> 32;
+        }
+        out[longer.size()] = static_cast<uint32_t>(carry);
+        return out;
+    }
+
+    BigInteger::Limbs BigInteger::subtractMagnitude(const Limbs& a, const Limbs& b) {
+        Limbs out(a.size());
+        int64_t borrow = 0;
+        for (size_t i = 0; i < a.size(); ++i) {
+            int64_t diff = static_cast<int64_t>(a[i]) - borrow - (i < b.size() ? static_cast<int64_t>(b[i]) : 0);
+            borrow = diff < 0 ? 1 : 0;
+            out[i] = static_cast<uint32_t>(diff + (borrow << 32));
+        }
+        return out;
+    }
+
+    BigInteger::Limbs BigInteger::multiplyMagnitude(const Limbs& a, const Limbs& b) {
+        if (a.empty() || b.empty()) return {};
+        Limbs out(a.size() + b.size(), 0);
+        for (size_t i = 0; i < a.size(); ++i) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < b.size(); ++j) {
+                uint64_t cur = static_cast<uint64_t>(a[i]) * b[j] + out[i + j] + carry;
+                out[i + j] = static_cast<uint32_t>(cur);
+                carry = cur >> 32;
+            }
+            out[i + b.size()] = static_cast<uint32_t>(carry);
+        }
+        return out;
+    }
+
+    uint32_t BigInteger::divideSmallInPlace(Limbs& a, uint32_t divisor) {
+        uint64_t remainder = 0;
+        for (size_t i = a.size(); i-- > 0;) {
+            uint64_t cur = (remainder << 32) | a[i];
+            a[i] = static_cast<uint32_t>(cur / divisor);
+            remainder = cur % divisor;
+        }
+        trim(a);
+        return static_cast<uint32_t>(remainder);
+    }
+
+    BigInteger::Limbs BigInteger::divideMagnitude(const Limbs& a, const Limbs& b) {
+        if (compareMagnitude(a, b) < 0) return {};
+        if (b.size() == 1) {
+            Limbs q = a;
+            divideSmallInPlace(q, b[0]);
+            return q;
+        }
+
+        // Normalise so the divisor's top limb has its high bit set (Knuth vol. 2, 4.3.1)
+        const size_t n = b.size();
+        const size_t m = a.size() - n;
+        int shift = 0;
+        for (uint32_t top = b.back(); (top & 0x80000000u) == 0; top <<= 1) ++shift;
+
+        Limbs vn(n), un(a.size() + 1);
+        for (size_t i = n - 1; i > 0; --i) {
+            vn[i] = (b[i] << shift) | (shift ? static_cast<uint32_t>(static_cast<uint64_t>(b[i - 1]) >> (32 - shift)) : 0u);
+        }
+        vn[0] = b[0] << shift;
+        un[a.size()] = shift ? static_cast<uint32_t>(static_cast<uint64_t>(a.back()) >> (32 - shift)) : 0u;
+        for (size_t i = a.size() - 1; i > 0; --i) {
+            un[i] = (a[i] << shift) | (shift ? static_cast<uint32_t>(static_cast<uint64_t>(a[i - 1]) >> (32 - shift)) : 0u);
+        }
+        un[0] = a[0] << shift;
+
+        const uint64_t base = 1ULL << 32;
+        Limbs q(m + 1, 0);
+        for (size_t j = m + 1; j-- > 0;) {
+            uint64_t numerator = (static_cast<uint64_t>(un[j + n]) << 32) | un[j + n - 1];
+            uint64_t qhat = numerator / vn[n - 1];
+            uint64_t rhat = numerator % vn[n - 1];
+            while (qhat >= base || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+                --qhat;
+                rhat += vn[n - 1];
+                if (rhat >= base) break;
+            }
+
+            // Multiply and subtract qhat * vn from the current window of un
+            int64_t borrow = 0;
+            for (size_t i = 0; i < n; ++i) {
+                uint64_t product = qhat * vn[i];
+                int64_t t = static_cast<int64_t>(un[i + j]) - borrow - static_cast<int64_t>(product & 0xFFFFFFFFu);
+                un[i + j] = static_cast<uint32_t>(t);
+                borrow = static_cast<int64_t>(product >> 32) - (t >> 32);
+            }
+            int64_t t = static_cast<int64_t>(un[j + n]) - borrow;
+            un[j + n] = static_cast<uint32_t>(t);
+
+            if (t < 0) { // qhat was one too large: add the divisor back
+                --qhat;
+                uint64_t carry = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    uint64_t sum = static_cast<uint64_t>(un[i + j]) + vn[i] + carry;
+                    un[i + j] = static_cast<uint32_t>(sum);
+                    carry = sum >> 32;
+                }
+                un[j + n] += static_cast<uint32_t>(carry);
+            }
+            q[j] = static_cast<uint32_t>(qhat);
+        }
+        return q;
+    }
+
+} // namespace MatrixUtils
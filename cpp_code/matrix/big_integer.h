@@ -0,0 +1,53 @@
+// File: big_integer.h
+#ifndef BIG_INTEGER_H
+#define BIG_INTEGER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MatrixUtils {
+
+    // Minimal arbitrary-precision signed integer: sign + base 2^32 magnitude, little-endian.
+    // Provides exactly what fraction-free elimination needs; not a general bignum library.
+    class BigInteger {
+    public:
+        BigInteger() = default;
+        BigInteger(long long value);
+
+        bool isZero() const { return limbs_.empty(); }
+        bool isNegative() const { return negative_; }
+        bool fitsInt64() const;
+        long long toInt64() const; // Only meaningful when fitsInt64()
+        std::string toString() const;
+
+        BigInteger operator-() const;
+        friend BigInteger operator+(const BigInteger& a, const BigInteger& b);
+        friend BigInteger operator-(const BigInteger& a, const BigInteger& b);
+        friend BigInteger operator*(const BigInteger& a, const BigInteger& b);
+        // Truncating division (rounds toward zero, like built-in integers); throws on zero divisor
+        friend BigInteger operator/(const BigInteger& a, const BigInteger& b);
+        friend bool operator==(const BigInteger& a, const BigInteger& b) {
+            return a.negative_ == b.negative_ && a.limbs_ == b.limbs_;
+        }
+        friend bool operator!=(const BigInteger& a, const BigInteger& b) { return !(a == b); }
+
+    private:
+        using Limbs = std::vector<uint32_t>;
+
+        static int compareMagnitude(const Limbs& a, const Limbs& b);
+        static Limbs addMagnitude(const Limbs& a, const Limbs& b);
+        static Limbs subtractMagnitude(const Limbs& a, const Limbs& b); // Requires |a| >= |b|
+        static Limbs multiplyMagnitude(const Limbs& a, const Limbs& b);
+        static Limbs divideMagnitude(const Limbs& a, const Limbs& b);   // Knuth algorithm D
+        static uint32_t divideSmallInPlace(Limbs& a, uint32_t divisor); // Returns the remainder
+        static void trim(Limbs& a);
+        static BigInteger make(Limbs limbs, bool negative);
+
+        Limbs limbs_;
+        bool negative_ = false;
+    };
+
+} // namespace MatrixUtils
+
+#endif // BIG_INTEGER_H
@@ -0,0 +1,188 @@
+// File: dense_matrix.h
+#ifndef DENSE_MATRIX_H
+#define DENSE_MATRIX_H
+
+#include <vector>
+#include <cstddef>   // For size_t
+#include <cstdlib>   // For std::aligned_alloc, std::free
+#include <cstring>   // For std::memcpy
+#include <new>       // For std::bad_alloc
+#include <stdexcept>
+#include <algorithm> // For std::fill, std::copy
+#include <utility>   // For std::swap
+
+namespace MatrixUtils {
+
+    // Every DenseMatrix row starts on this boundary (one cache line, one AVX-512 register)
+    constexpr size_t DENSE_ALIGNMENT_BYTES = 64;
+    constexpr size_t DENSE_ALIGNMENT_DOUBLES = DENSE_ALIGNMENT_BYTES / sizeof(double);
+
+    inline size_t paddedStride(int cols) {
+        size_t c = cols > 0 ? static_cast<size_t>(cols) : 0;
+        return (c + DENSE_ALIGNMENT_DOUBLES - 1) / DENSE_ALIGNMENT_DOUBLES * DENSE_ALIGNMENT_DOUBLES;
+    }
+
+    inline double* allocateAlignedDoubles(size_t count) {
+        if (count == 0) return nullptr;
+        size_t bytes = (count * sizeof(double) + DENSE_ALIGNMENT_BYTES - 1) / DENSE_ALIGNMENT_BYTES * DENSE_ALIGNMENT_BYTES;
+        void* p = std::aligned_alloc(DENSE_ALIGNMENT_BYTES, bytes);
+        if (!p) throw std::bad_alloc();
+        return static_cast<double*>(p);
+    }
+
+    // --- Non-owning views ---
+    // Row-major: element (r, c) lives at data[r * stride + c]. Views never allocate and
+    // are cheap to pass by value; the viewed storage must outlive them.
+
+    class ConstDenseMatrixView {
+    public:
+        ConstDenseMatrixView() = default;
+        ConstDenseMatrixView(const double* data, int rows, int cols, size_t stride)
+            : data_(data), rows_(rows), cols_(cols), stride_(stride) {}
+
+        int rows() const { return rows_; }
+        int cols() const { return cols_; }
+        size_t stride() const { return stride_; }
+        const double* data() const { return data_; }
+        bool empty() const { return rows_ == 0 || cols_ == 0; }
+
+        const double* row(int r) const { return data_ + static_cast<size_t>(r) * stride_; }
+        double operator()(int r, int c) const { return data_[static_cast<size_t>(r) * stride_ + c]; }
+
+        ConstDenseMatrixView block(int r0, int c0, int nrows, int ncols) const {
+            return ConstDenseMatrixView(data_ + static_cast<size_t>(r0) * stride_ + c0, nrows, ncols, stride_);
+        }
+
+    private:
+        const double* data_ = nullptr;
+        int rows_ = 0;
+        int cols_ = 0;
+        size_t stride_ = 0;
+    };
+
+    class DenseMatrixView {
+    public:
+        DenseMatrixView() = default;
+        DenseMatrixView(double* data, int rows, int cols, size_t stride)
+            : data_(data), rows_(rows), cols_(cols), stride_(stride) {}
+
+        int rows() const { return rows_; }
+        int cols() const { return cols_; }
+        size_t stride() const { return stride_; }
+        double* data() const { return data_; }
+        bool empty() const { return rows_ == 0 || cols_ == 0; }
+
+        double* row(int r) const { return data_ + static_cast<size_t>(r) * stride_; }
+        double& operator()(int r, int c) const { return data_[static_cast<size_t>(r) * stride_ + c]; }
+
+        DenseMatrixView block(int r0, int c0, int nrows, int ncols) const {
+            return DenseMatrixView(data_ + static_cast<size_t>(r0) * stride_ + c0, nrows, ncols, stride_);
+        }
+
+        operator ConstDenseMatrixView() const { return ConstDenseMatrixView(data_, rows_, cols_, stride_); }
+
+    private:
+        double* data_ = nullptr;
+        int rows_ = 0;
+        int cols_ = 0;
+        size_t stride_ = 0;
+    };
+
+    template <typename E>
+    class MatrixExpression; // Lazy elementwise expressions, see matrix_expression.h
+
+    // --- Owning contiguous matrix ---
+    // One aligned allocation for the whole matrix; rows are padded to DENSE_ALIGNMENT_DOUBLES
+    // so every row is aligned. Shape queries are O(1), unlike isValidMatrix on Matrix.
+
+    class DenseMatrix {
+    public:
+        DenseMatrix() = default;
+
+        DenseMatrix(int rows, int cols, double fill = 0.0)
+            : rows_(rows), cols_(cols), stride_(paddedStride(cols)) {
+            if (rows < 0 || cols < 0) {
+                throw std::invalid_argument("DenseMatrix dimensions cannot be negative.");
+            }
+            data_ = allocateAlignedDoubles(static_cast<size_t>(rows_) * stride_);
+            std::fill(data_, data_ + static_cast<size_t>(rows_) * stride_, fill);
+        }
+
+        // Copies a legacy Matrix into one contiguous buffer; throws if rows are ragged
+        explicit DenseMatrix(const std::vector<std::vector<double>>& matrix)
+            : DenseMatrix(static_cast<int>(matrix.size()), matrix.empty() ? 0 : static_cast<int>(matrix[0].size())) {
+            for (int r = 0; r < rows_; ++r) {
+                if (static_cast<int>(matrix[r].size()) != cols_) {
+                    throw std::invalid_argument("Cannot build a DenseMatrix from rows of different lengths.");
+                }
+                std::copy(matrix[r].begin(), matrix[r].end(), row(r));
+            }
+        }
+
+        static DenseMatrix identity(int n) {
+            DenseMatrix m(n, n);
+            for (int i = 0; i < n; ++i) m(i, i) = 1.0;
+            return m;
+        }
+
+        static DenseMatrix fromView(ConstDenseMatrixView v) {
+            DenseMatrix m(v.rows(), v.cols());
+            for (int r = 0; r < v.rows(); ++r) {
+                std::memcpy(m.row(r), v.row(r), static_cast<size_t>(v.cols()) * sizeof(double));
+            }
+            return m;
+        }
+
+        // Evaluates a lazy expression in one fused pass (defined in matrix_expression.h)
+        template <typename E>
+        DenseMatrix(const MatrixExpression<E>& expression);
+        template <typename E>
+        DenseMatrix& operator=(const MatrixExpression<E>& expression);
+
+        DenseMatrix(const DenseMatrix& other) : DenseMatrix(fromView(other.view())) {}
+        DenseMatrix(DenseMatrix&& other) noexcept { swap(other); }
+        DenseMatrix& operator=(DenseMatrix other) noexcept { swap(other); return *this; }
+        ~DenseMatrix() { std::free(data_); }
+
+        void swap(DenseMatrix& other) noexcept {
+            std::swap(data_, other.data_);
+            std::swap(rows_, other.rows_);
+            std::swap(cols_, other.cols_);
+            std::swap(stride_, other.stride_);
+        }
+
+        int rows() const { return rows_; }
+        int cols() const { return cols_; }
+        size_t stride() const { return stride_; }
+        bool empty() const { return rows_ == 0 || cols_ == 0; }
+        double* data() { return data_; }
+        const double* data() const { return data_; }
+
+        double* row(int r) { return data_ + static_cast<size_t>(r) * stride_; }
+        const double* row(int r) const { return data_ + static_cast<size_t>(r) * stride_; }
+        double& operator()(int r, int c) { return data_[static_cast<size_t>(r) * stride_ + c]; }
+        double operator()(int r, int c) const { return data_[static_cast<size_t>(r) * stride_ + c]; }
+
+        DenseMatrixView view() { return DenseMatrixView(data_, rows_, cols_, stride_); }
+        ConstDenseMatrixView view() const { return ConstDenseMatrixView(data_, rows_, cols_, stride_); }
+        operator DenseMatrixView() { return view(); }
+        operator ConstDenseMatrixView() const { return view(); }
+
+        std::vector<std::vector<double>> toMatrix() const {
+            std::vector<std::vector<double>> out(rows_);
+            for (int r = 0; r < rows_; ++r) {
+                out[r].assign(row(r), row(r) + cols_);
+            }
+            return out;
+        }
+
+    private:
+        double* data_ = nullptr;
+        int rows_ = 0;
+        int cols_ = 0;
+        size_t stride_ = 0;
+    };
+
+} // namespace MatrixUtils
+
+#endif // DENSE_MATRIX_H
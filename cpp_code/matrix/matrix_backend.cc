@@ -0,0 +1,223 @@
+// File: matrix_backend.cc
+#include "matrix_backend.h"
+#include "matrix_gemm.h"
+#include <atomic>
+#include <cmath>     // For std::fabs
+#include <cstdlib>   // For std::getenv
+#include <stdexcept>
+#include <algorithm> // For std::min, std::swap_ranges
+
+#ifdef NECTAR_WITH_CBLAS
+#include <cblas.h>
+// Fortran LAPACK entry point; present in OpenBLAS, reference LAPACK and MKL alike
+extern "C" void dgetrf_(const int* m, const int* n, double* a, const int* lda, int* ipiv, int* info);
+#endif
+
+namespace MatrixUtils {
+
+    namespace {
+
+        // Columns factored per panel before the trailing update goes through GEMM
+        constexpr int GETRF_PANEL = 64;
+
+        // --- Built-in kernels ---
+
+        void builtinGemv(double alpha, ConstDenseMatrixView a, const double* x, double beta, double* y) {
+            for (int i = 0; i < a.rows(); ++i) {
+                const double* row = a.row(i);
+                double sum = 0.0;
+                for (int j = 0; j < a.cols(); ++j) sum += row[j] * x[j];
+                y[i] = alpha * sum + (beta == 0.0 ? 0.0 : beta * y[i]);
+            }
+        }
+
+        // Row-oriented substitution: every inner loop streams a whole row of B
+        void builtinTrsm(TriangularKind kind, ConstDenseMatrixView a, DenseMatrixView b) {
+            const int n = a.rows();
+            const int cols = b.cols();
+            if (kind != TriangularKind::Upper) {
+                const bool unit = kind == TriangularKind::LowerUnit;
+                for (int r = 0; r < n; ++r) {
+                    const double* l_row = a.row(r);
+                    double* b_r = b.row(r);
+                    for (int c = 0; c < r; ++c) {
+                        double l = l_row[c];
+                        if (l == 0.0) continue;
+                        const double* b_c = b.row(c);
+                        for (int j = 0; j < cols; ++j) b_r[j] -= l * b_c[j];
+                    }
+                    if (!unit) {
+                        double inv_diag = 1.0 / l_row[r];
+                        for (int j = 0; j < cols; ++j) b_r[j] *= inv_diag;
+                    }
+                }
+                return;
+            }
+            for (int r = n - 1; r >= 0; --r) {
+                const double* u_row = a.row(r);
+                double* b_r = b.row(r);
+                for (int c = r + 1; c < n; ++c) {
+                    double u = u_row[c];
+                    if (u == 0.0) continue;
+                    const double* b_c = b.row(c);
+                    for (int j = 0; j < cols; ++j) b_r[j] -= u * b_c[j];
+                }
+                double inv_diag = 1.0 / u_row[r];
+                for (int j = 0; j < cols; ++j) b_r[j] *= inv_diag;
+            }
+        }
+
+        // Right-looking blocked LU: factor a GETRF_PANEL-wide panel with row swaps applied
+        // across the full rows, solve for the U12 block, then one GEMM updates A22.
+        int blockedGetrf(DenseMatrixView a, int* pivots, const MatrixBackend& kernels) {
+            const int n = a.rows();
+            if (a.cols() != n) {
+                throw std::invalid_argument("LU factorization requires a square matrix.");
+            }
+            int info = 0;
+            for (int k = 0; k < n; k += GETRF_PANEL) {
+                const int nb = std::min(GETRF_PANEL, n - k);
+                for (int j = k; j < k + nb; ++j) {
+                    int pivot_row = j;
+                    double pivot_abs = std::fabs(a(j, j));
+                    for (int r = j + 1; r < n; ++r) {
+                        double v = std::fabs(a(r, j));
+                        if (v > pivot_abs) {
+                            pivot_abs = v;
+                            pivot_row = r;
+                        }
+                    }
+                    pivots[j] = pivot_row;
+                    if (pivot_abs == 0.0) {
+                        if (info == 0) info = j + 1; // Column already eliminated; nothing to do
+                        continue;
+                    }
+                    if (pivot_row != j) {
+                        std::swap_ranges(a.row(j), a.row(j) + n, a.row(pivot_row));
+                    }
+                    const double* row_j = a.row(j);
+                    double inv_pivot = 1.0 / row_j[j];
+                    for (int r = j + 1; r < n; ++r) {
+                        double* row_r = a.row(r);
+                        double l = row_r[j] * inv_pivot;
+                        row_r[j] = l;
+                        if (l == 0.0) continue;
+                        for (int c = j + 1; c < k + nb; ++c) {
+                            row_r[c] -= l * row_j[c];
+                        }
+                    }
+                }
+                const int rest = n - k - nb;
+                if (rest > 0) {
+                    DenseMatrixView a12 = a.block(k, k + nb, nb, rest);
+                    kernels.trsm(TriangularKind::LowerUnit, a.block(k, k, nb, nb), a12);
+                    kernels.gemm(-1.0, a.block(k + nb, k, rest, nb), a12, 1.0, a.block(k + nb, k + nb, rest, rest));
+                }
+            }
+            return info;
+        }
+
+        int builtinGetrf(DenseMatrixView a, int* pivots) {
+            return blockedGetrf(a, pivots, builtinMatrixBackend());
+        }
+
+        const MatrixBackend kBuiltinBackend = {"builtin", gemm, builtinGemv, builtinTrsm, builtinGetrf};
+
+#ifdef NECTAR_WITH_CBLAS
+        // --- CBLAS / LAPACK kernels ---
+
+        void cblasGemm(double alpha, ConstDenseMatrixView a, ConstDenseMatrixView b, double beta, DenseMatrixView c) {
+            if (b.rows() != a.cols() || c.rows() != a.rows() || c.cols() != b.cols()) {
+                throw std::invalid_argument("Incompatible dimensions for matrix multiplication (A.cols != B.rows).");
+            }
+            if (c.empty()) return;
+            cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, a.rows(), b.cols(), a.cols(),
+                        alpha, a.data(), static_cast<int>(a.stride()), b.data(), static_cast<int>(b.stride()),
+                        beta, c.data(), static_cast<int>(c.stride()));
+        }
+
+        void cblasGemv(double alpha, ConstDenseMatrixView a, const double* x, double beta, double* y) {
+            cblas_dgemv(CblasRowMajor, CblasNoTrans, a.rows(), a.cols(), alpha, a.data(),
+                        static_cast<int>(a.stride()), x, 1, beta, y, 1);
+        }
+
+        void cblasTrsm(TriangularKind kind, ConstDenseMatrixView a, DenseMatrixView b) {
+            if (b.empty()) return;
+            bool lower = kind != TriangularKind::Upper;
+            bool unit = kind == TriangularKind::LowerUnit;
+            cblas_dtrsm(CblasRowMajor, CblasLeft, lower ? CblasLower : CblasUpper, CblasNoTrans,
+                        unit ? CblasUnit : CblasNonUnit, b.rows(), b.cols(), 1.0,
+                        a.data(), static_cast<int>(a.stride()), b.data(), static_cast<int>(b.stride()));
+        }
+
+        int cblasGetrf(DenseMatrixView a, int* pivots) {
+            const int n = a.rows();
+            if (a.cols() != n) {
+                throw std::invalid_argument("LU factorization requires a square matrix.");
+            }
+            if (n == 0) return 0;
+            // LAPACK is column-major: factor a transposed copy, exactly as LAPACKE_dgetrf does
+            DenseMatrix col_major(n, n);
+            for (int r = 0; r < n; ++r) {
+                for (int c = 0; c < n; ++c) col_major(c, r) = a(r, c);
+            }
+            int lda = static_cast<int>(col_major.stride());
+            int info = 0;
+            dgetrf_(&n, &n, col_major.data(), &lda, pivots, &info);
+            if (info < 0) {
+                throw std::runtime_error("LAPACK dgetrf rejected its arguments.");
+            }
+            for (int r = 0; r < n; ++r) {
+                for (int c = 0; c < n; ++c) a(r, c) = col_major(c, r);
+                pivots[r] -= 1; // 1-based Fortran indices
+            }
+            return info;
+        }
+
+        const MatrixBackend kCblasBackend = {"cblas", cblasGemm, cblasGemv, cblasTrsm, cblasGetrf};
+#endif
+
+        const MatrixBackend* findBackend(const std::string& name) {
+            if (name == "builtin") return &kBuiltinBackend;
+#ifdef NECTAR_WITH_CBLAS
+            if (name == "cblas") return &kCblasBackend;
+#endif
+            return nullptr;
+        }
+
+        std::atomic<const MatrixBackend*>& activeBackendSlot() {
+            static std::atomic<const MatrixBackend*> slot([] {
+                const char* env = std::getenv("NECTAR_MATRIX_BACKEND");
+                const MatrixBackend* chosen = env ? findBackend(env) : nullptr;
+                return chosen ? chosen : &kBuiltinBackend;
+            }());
+            return slot;
+        }
+
+    } // namespace
+
+    const MatrixBackend& builtinMatrixBackend() {
+        return kBuiltinBackend;
+    }
+
+    const MatrixBackend& activeMatrixBackend() {
+        return *activeBackendSlot().load(std::memory_order_acquire);
+    }
+
+    void setMatrixBackend(const std::string& name) {
+        const MatrixBackend* backend = findBackend(name);
+        if (!backend) {
+            throw std::invalid_argument("Unknown or unavailable matrix backend: " + name);
+        }
+        activeBackendSlot().store(backend, std::memory_order_release);
+    }
+
+    std::vector<std::string> availableMatrixBackends() {
+        std::vector<std::string> names = {"builtin"};
+#ifdef NECTAR_WITH_CBLAS
+        names.push_back("cblas");
+#endif
+        return names;
+    }
+
+} // namespace MatrixUtils
@@ -0,0 +1,41 @@
+// File: matrix_backend.h
+#ifndef MATRIX_BACKEND_H
+#define MATRIX_BACKEND_H
+
+#include "dense_matrix.h"
+#include <string>
+#include <vector>
+
+namespace MatrixUtils {
+
+    // Which triangle of A a triangular solve uses
+    enum class TriangularKind {
+        LowerUnit, // L with an implicit unit diagonal (the L of an LU factorization)
+        Lower,     // L with its stored diagonal (the L of a Cholesky factorization)
+        Upper      // U with its stored diagonal
+    };
+
+    // The four dense kernels everything else is built on. All operands are row-major views.
+    struct MatrixBackend {
+        const char* name;
+        // C = alpha * A * B + beta * C
+        void (*gemm)(double alpha, ConstDenseMatrixView a, ConstDenseMatrixView b, double beta, DenseMatrixView c);
+        // y = alpha * A * x + beta * y
+        void (*gemv)(double alpha, ConstDenseMatrixView a, const double* x, double beta, double* y);
+        // B = T^-1 * B for the triangle of the square matrix A selected by kind
+        void (*trsm)(TriangularKind kind, ConstDenseMatrixView a, DenseMatrixView b);
+        // In-place LU with partial pivoting of a square A; pivots[k] is the row swapped with row k.
+        // Returns 0, or k + 1 if U(k, k) is exactly zero (LAPACK getrf info convention).
+        int (*getrf)(DenseMatrixView a, int* pivots);
+    };
+
+    const MatrixBackend& builtinMatrixBackend();
+    const MatrixBackend& activeMatrixBackend();
+    // Selects a backend by name ("builtin", or "cblas" when built with NECTAR_WITH_CBLAS).
+    // The initial choice comes from the NECTAR_MATRIX_BACKEND environment variable.
+    void setMatrixBackend(const std::string& name);
+    std::vector<std::string> availableMatrixBackends();
+
+} // namespace MatrixUtils
+
+#endif // MATRIX_BACKEND_H
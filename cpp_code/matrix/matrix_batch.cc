@@ -0,0 +1,193 @@
+// File: matrix_batch.cc
+#include "matrix_batch.h"
+#include "matrix_utils.h"
+#include "thread_pool.h"
+#include <algorithm> // For std::min
+#include <cmath>     // For std::fabs
+#include <limits>    // For numeric_limits
+#include <numeric>   // For std::accumulate
+
+namespace MatrixUtils {
+
+    namespace {
+
+        // Matrices per parallel task: large enough to amortise scheduling, small enough
+        // that every worker's slice of each element row stays in L2
+        constexpr int BATCH_CHUNK = 8192;
+
+        constexpr double EPSILON = std::numeric_limits<double>::epsilon();
+
+        // Runs kernel(begin, end) over [0, count) in BATCH_CHUNK slices on the matrix pool
+        template <typename Kernel>
+        void forEachChunk(int count, Kernel&& kernel) {
+            const int chunks = (count + BATCH_CHUNK - 1) / BATCH_CHUNK;
+            if (chunks <= 1) {
+                kernel(0, count, 0);
+                return;
+            }
+            matrixThreadPool().parallelFor(chunks, [&](int chunk) {
+                int begin = chunk * BATCH_CHUNK;
+                kernel(begin, std::min(count, begin + BATCH_CHUNK), chunk);
+            });
+        }
+
+        template <int N>
+        struct ElementPointers {
+            const double* at[N][N];
+            explicit ElementPointers(const SmallMatrixBatch& batch) {
+                for (int i = 0; i < N; ++i) {
+                    for (int j = 0; j < N; ++j) at[i][j] = batch.element(i, j);
+                }
+            }
+        };
+
+        // The loops below gather one matrix per lane from the element rows; every iteration is
+        // independent, which `ivdep` promises so GCC vectorises across matrices without
+        // emitting dozens of runtime alias checks.
+
+        template <int N>
+        void determinantKernel(const SmallMatrixBatch& matrices, double* out, int begin, int end) {
+            const ElementPointers<N> src(matrices);
+#pragma GCC ivdep
+            for (int k = begin; k < end; ++k) {
+                SmallMatrix<N> m;
+                for (int i = 0; i < N; ++i) {
+                    for (int j = 0; j < N; ++j) m.m[i][j] = src.at[i][j][k];
+                }
+                out[k] = m.determinant();
+            }
+        }
+
+        template <int N>
+        int inverseKernel(const SmallMatrixBatch& matrices, SmallMatrixBatch& inverses, double* determinants,
+                          int begin, int end) {
+            const ElementPointers<N> src(matrices);
+            double* dst[N][N];
+            for (int i = 0; i < N; ++i) {
+                for (int j = 0; j < N; ++j) dst[i][j] = inverses.element(i, j);
+            }
+            int singular = 0;
+#pragma GCC ivdep
+            for (int k = begin; k < end; ++k) {
+                SmallMatrix<N> m;
+                for (int i = 0; i < N; ++i) {
+                    for (int j = 0; j < N; ++j) m.m[i][j] = src.at[i][j][k];
+                }
+                const double det = m.determinant();
+                const SmallMatrix<N> adj = m.adjugate();
+                // Reciprocal 1-norm condition |det| / (||A||_1 ||adj A||_1) of at least epsilon
+                const bool invertible = det != 0.0 && std::fabs(det) >= EPSILON * m.norm1() * adj.norm1();
+                const double inv_det = invertible ? 1.0 / det : 0.0; // Select, not branch
+                singular += invertible ? 0 : 1;
+                for (int i = 0; i < N; ++i) {
+                    for (int j = 0; j < N; ++j) dst[i][j][k] = adj.m[i][j] * inv_det;
+                }
+                if (determinants) determinants[k] = det;
+            }
+            return singular;
+        }
+
+        template <int N>
+        void multiplyKernel(const SmallMatrixBatch& a, const SmallMatrixBatch& b, SmallMatrixBatch& products,
+                            int begin, int end) {
+            const ElementPointers<N> lhs(a);
+            const ElementPointers<N> rhs(b);
+            double* dst[N][N];
+            for (int i = 0; i < N; ++i) {
+                for (int j = 0; j < N; ++j) dst[i][j] = products.element(i, j);
+            }
+#pragma GCC ivdep
+            for (int k = begin; k < end; ++k) {
+                for (int i = 0; i < N; ++i) {
+                    for (int j = 0; j < N; ++j) {
+                        double sum = 0.0;
+                        for (int p = 0; p < N; ++p) sum += lhs.at[i][p][k] * rhs.at[p][j][k];
+                        dst[i][j][k] = sum;
+                    }
+                }
+            }
+        }
+
+    } // namespace
+
+    // --- SmallMatrixBatch ---
+
+    SmallMatrixBatch SmallMatrixBatch::fromMatrices(const std::vector<Matrix>& matrices) {
+        if (matrices.empty()) {
+            throw std::invalid_argument("Cannot build a SmallMatrixBatch from an empty list.");
+        }
+        int n;
+        if (!isSquareMatrix(matrices[0], n)) {
+            throw std::invalid_argument("Batched operations require square matrices.");
+        }
+        SmallMatrixBatch batch(n, static_cast<int>(matrices.size()));
+        for (int k = 0; k < batch.size(); ++k) batch.setMatrix(k, matrices[k]);
+        return batch;
+    }
+
+    Matrix SmallMatrixBatch::getMatrix(int k) const {
+        Matrix matrix(n_, std::vector<double>(n_));
+        for (int i = 0; i < n_; ++i) {
+            for (int j = 0; j < n_; ++j) matrix[i][j] = (*this)(k, i, j);
+        }
+        return matrix;
+    }
+
+    void SmallMatrixBatch::setMatrix(int k, const Matrix& matrix) {
+        int n;
+        if (!isSquareMatrix(matrix, n) || n != n_) {
+            throw std::invalid_argument("Every matrix in a batch must be " + std::to_string(n_) + "x" +
+                                        std::to_string(n_) + ".");
+        }
+        for (int i = 0; i < n_; ++i) {
+            for (int j = 0; j < n_; ++j) (*this)(k, i, j) = matrix[i][j];
+        }
+    }
+
+    // --- Batched kernels ---
+
+    void determinantBatch(const SmallMatrixBatch& matrices, double* determinants) {
+        forEachChunk(matrices.size(), [&](int begin, int end, int) {
+            dispatchSmallMatrix(matrices.n(), [&](auto size) {
+                determinantKernel<decltype(size)::value>(matrices, determinants, begin, end);
+            });
+        });
+    }
+
+    std::vector<double> determinantBatch(const SmallMatrixBatch& matrices) {
+        std::vector<double> determinants(matrices.size());
+        determinantBatch(matrices, determinants.data());
+        return determinants;
+    }
+
+    int inverseBatch(const SmallMatrixBatch& matrices, SmallMatrixBatch& inverses, double* determinants) {
+        if (inverses.n() != matrices.n() || inverses.size() != matrices.size()) {
+            inverses = SmallMatrixBatch(matrices.n(), matrices.size());
+        }
+        std::vector<int> singular((matrices.size() + BATCH_CHUNK - 1) / BATCH_CHUNK + 1, 0);
+        forEachChunk(matrices.size(), [&](int begin, int end, int chunk) {
+            dispatchSmallMatrix(matrices.n(), [&](auto size) {
+                singular[chunk] = inverseKernel<decltype(size)::value>(matrices, inverses, determinants, begin, end);
+            });
+        });
+        return std::accumulate(singular.begin(), singular.end(), 0);
+    }
+
+    void multiplyBatch(const SmallMatrixBatch& a, const SmallMatrixBatch& b, SmallMatrixBatch& products) {
+        if (a.n() != b.n() || a.size() != b.size()) {
+            throw std::invalid_argument("Batched multiplication requires batches of the same shape and length.");
+        }
+        if (&products == &a || &products == &b) {
+            throw std::invalid_argument("Batched multiplication cannot write into one of its inputs.");
+        }
+        if (products.n() != a.n() || products.size() != a.size()) {
+            products = SmallMatrixBatch(a.n(), a.size());
+        }
+        forEachChunk(a.size(), [&](int begin, int end, int) {
+            dispatchSmallMatrix(a.n(), [&](auto size) {
+                multiplyKernel<decltype(size)::value>(a, b, products, begin, end);
+            });
+        });
+    }
+
+} // namespace MatrixUtils
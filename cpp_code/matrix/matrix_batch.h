@@ -0,0 +1,75 @@
+// File: matrix_batch.h
+#ifndef MATRIX_BATCH_H
+#define MATRIX_BATCH_H
+
+#include "small_matrix.h"
+#include <vector>
+#include <stdexcept>
+
+namespace MatrixUtils {
+
+    // Structure-of-arrays storage for many N x N matrices (1 <= N <= 4): element (i, j) of
+    // every matrix is one contiguous, aligned run, so the batch kernels process several
+    // matrices per SIMD register and split the batch across matrixThreadPool().
+    class SmallMatrixBatch {
+    public:
+        SmallMatrixBatch() = default;
+        SmallMatrixBatch(int n, int count)
+            : n_(n), storage_(n * n, count) {
+            if (n < 1 || n > SMALL_MATRIX_MAX_N) {
+                throw std::invalid_argument("SmallMatrixBatch supports 1x1 through 4x4 matrices.");
+            }
+        }
+
+        // Throws unless every matrix is square and they all share one size <= 4
+        static SmallMatrixBatch fromMatrices(const std::vector<Matrix>& matrices);
+
+        int n() const { return n_; }
+        int size() const { return storage_.cols(); }
+
+        // Element (i, j) of all matrices: element(i, j)[k] belongs to matrix k
+        double* element(int i, int j) { return storage_.row(i * n_ + j); }
+        const double* element(int i, int j) const { return storage_.row(i * n_ + j); }
+        double& operator()(int k, int i, int j) { return storage_(i * n_ + j, k); }
+        double operator()(int k, int i, int j) const { return storage_(i * n_ + j, k); }
+
+        template <int N>
+        SmallMatrix<N> get(int k) const {
+            SmallMatrix<N> m;
+            for (int i = 0; i < N; ++i) {
+                for (int j = 0; j < N; ++j) m.m[i][j] = storage_(i * N + j, k);
+            }
+            return m;
+        }
+
+        template <int N>
+        void set(int k, const SmallMatrix<N>& m) {
+            for (int i = 0; i < N; ++i) {
+                for (int j = 0; j < N; ++j) storage_(i * N + j, k) = m.m[i][j];
+            }
+        }
+
+        Matrix getMatrix(int k) const;
+        void setMatrix(int k, const Matrix& matrix); // Throws if the shape is not n x n
+
+    private:
+        int n_ = 0;
+        DenseMatrix storage_; // Row i * n + j holds element (i, j) of every matrix
+    };
+
+    // determinants[k] = det(matrices[k]); the array must hold matrices.size() values
+    void determinantBatch(const SmallMatrixBatch& matrices, double* determinants);
+    std::vector<double> determinantBatch(const SmallMatrixBatch& matrices);
+
+    // inverses[k] = matrices[k]^-1. Matrices singular to working precision (reciprocal
+    // 1-norm condition number below machine epsilon) get an all-zero inverse and are
+    // counted in the return value. `inverses` is resized if needed and may
+    // be `matrices` itself; determinants (optional) receives every det.
+    int inverseBatch(const SmallMatrixBatch& matrices, SmallMatrixBatch& inverses, double* determinants = nullptr);
+
+    // products[k] = a[k] * b[k]; `products` is resized if needed and may alias neither input
+    void multiplyBatch(const SmallMatrixBatch& a, const SmallMatrixBatch& b, SmallMatrixBatch& products);
+
+} // namespace MatrixUtils
+
+#endif // MATRIX_BATCH_H
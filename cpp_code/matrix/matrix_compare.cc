@@ -0,0 +1,215 @@
+// File: matrix_compare.cc
+#include "matrix_compare.h"
+#include "matrix_utils.h"
+#include "thread_pool.h"
+#include <algorithm> // For std::min, std::max
+#include <atomic>
+#include <cmath>     // For std::fabs, std::isnan, std::isfinite
+#include <cstring>   // For std::memcpy
+#include <limits>    // For numeric_limits
+#include <stdexcept>
+#include <vector>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define MATRIX_COMPARE_AVX2 1
+#endif
+
+namespace MatrixUtils {
+
+    namespace {
+
+        // Elements per early-exit check: long enough that the check is noise, short enough
+        // that a mismatch near the start is reported after a few microseconds
+        constexpr int COMPARE_CHUNK = 2048;
+
+        // Elements per pool task on the parallel path; smaller comparisons stay serial
+        constexpr long long COMPARE_TASK_ELEMENTS = 1 << 18;
+
+        constexpr uint64_t SIGN_BIT = 0x8000000000000000ULL;
+
+        // Maps the bits of a double to an unsigned key that increases with the value, so the
+        // distance in ULPs is the difference of two keys
+        uint64_t orderedKey(double x) {
+            uint64_t bits;
+            std::memcpy(&bits, &x, sizeof bits);
+            return (bits & SIGN_BIT) ? ~bits : (bits | SIGN_BIT);
+        }
+
+        template <ToleranceMode Mode>
+        bool withinTolerance(double a, double b, const ComparisonOptions& options) {
+            if (a == b) return true;
+            if (Mode == ToleranceMode::Ulp) {
+                if (std::isnan(a) || std::isnan(b)) return false;
+                const uint64_t ka = orderedKey(a), kb = orderedKey(b);
+                return (ka > kb ? ka - kb : kb - ka) <= options.max_ulps;
+            }
+            const double diff = std::fabs(a - b);
+            if (Mode == ToleranceMode::Relative) {
+                // An infinite side makes the bound infinite too; unequal values that involve
+                // an infinity (or overflow the difference) never match
+                return std::isfinite(diff) && diff <= options.tolerance * std::max(std::fabs(a), std::fabs(b));
+            }
+            return diff <= options.tolerance; // False for NaN
+        }
+
+        // Number of mismatches among a[0, count) and b[0, count); folds max |a - b| into max_abs
+        template <ToleranceMode Mode>
+        long long countMismatches(const double* a, const double* b, int count, const ComparisonOptions& options,
+                                  double& max_abs) {
+            long long mismatches = 0;
+            int k = 0;
+#ifdef MATRIX_COMPARE_AVX2
+            const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+            const __m256d tolerance = _mm256_set1_pd(options.tolerance);
+            const __m256d infinity = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+            const __m256i sign_bit = _mm256_set1_epi64x(static_cast<long long>(SIGN_BIT));
+            const __m256i max_ulps = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(options.max_ulps)),
+                                                      sign_bit); // Biased for a signed compare
+            const __m256i zero = _mm256_setzero_si256();
+            __m256d running_max = _mm256_setzero_pd();
+            for (; k + 4 <= count; k += 4) {
+                const __m256d va = _mm256_loadu_pd(a + k);
+                const __m256d vb = _mm256_loadu_pd(b + k);
+                const __m256d diff = _mm256_and_pd(_mm256_sub_pd(va, vb), abs_mask);
+                running_max = _mm256_max_pd(diff, running_max); // Keeps running_max when diff is NaN
+                __m256d match = _mm256_cmp_pd(va, vb, _CMP_EQ_OQ);
+                if (Mode == ToleranceMode::Absolute) {
+                    match = _mm256_or_pd(match, _mm256_cmp_pd(diff, tolerance, _CMP_LE_OQ));
+                } else if (Mode == ToleranceMode::Relative) {
+                    const __m256d scale = _mm256_max_pd(_mm256_and_pd(va, abs_mask), _mm256_and_pd(vb, abs_mask));
+                    const __m256d finite = _mm256_cmp_pd(diff, infinity, _CMP_LT_OQ); // As in withinTolerance
+                    match = _mm256_or_pd(match, _mm256_and_pd(finite, _mm256_cmp_pd(diff, _mm256_mul_pd(tolerance, scale),
+                                                                                      _CMP_LE_OQ)));
+                } else {
+                    // key = bits ^ (negative ? all ones : sign bit), then |key_a - key_b| as unsigned
+                    const __m256i ia = _mm256_castpd_si256(va), ib = _mm256_castpd_si256(vb);
+                    const __m256i ka = _mm256_xor_si256(ia, _mm256_or_si256(_mm256_cmpgt_epi64(zero, ia), sign_bit));
+                    const __m256i kb = _mm256_xor_si256(ib, _mm256_or_si256(_mm256_cmpgt_epi64(zero, ib), sign_bit));
+                    const __m256i a_greater = _mm256_cmpgt_epi64(_mm256_xor_si256(ka, sign_bit),
+                                                                 _mm256_xor_si256(kb, sign_bit));
+                    const __m256i distance = _mm256_blendv_epi8(_mm256_sub_epi64(kb, ka), _mm256_sub_epi64(ka, kb),
+                                                                a_greater);
+                    const __m256i too_far = _mm256_cmpgt_epi64(_mm256_xor_si256(distance, sign_bit), max_ulps);
+                    const __m256d ordered = _mm256_cmp_pd(va, vb, _CMP_ORD_Q); // Neither is NaN
+                    match = _mm256_or_pd(match, _mm256_andnot_pd(_mm256_castsi256_pd(too_far), ordered));
+                }
+                mismatches += __builtin_popcount(~_mm256_movemask_pd(match) & 0xF);
+            }
+            __m128d half = _mm_max_pd(_mm256_castpd256_pd128(running_max), _mm256_extractf128_pd(running_max, 1));
+            half = _mm_max_pd(half, _mm_unpackhi_pd(half, half));
+            max_abs = std::max(max_abs, _mm_cvtsd_f64(half));
+#endif
+            for (; k < count; ++k) {
+                const double diff = std::fabs(a[k] - b[k]);
+                if (diff > max_abs) max_abs = diff;
+                mismatches += withinTolerance<Mode>(a[k], b[k], options) ? 0 : 1;
+            }
+            return mismatches;
+        }
+
+        // Compares rows [row_begin, row_end) chunk by chunk. `stop_after` is the row-major index
+        // of the earliest mismatch any task has found: a stopping scan gives up once it is past it.
+        template <ToleranceMode Mode, typename RowA, typename RowB>
+        void compareRows(RowA row_a, RowB row_b, int cols, int row_begin, int row_end,
+                         const ComparisonOptions& options, std::atomic<long long>& stop_after,
+                         ComparisonResult& result) {
+            for (int r = row_begin; r < row_end; ++r) {
+                const double* a = row_a(r);
+                const double* b = row_b(r);
+                for (int c0 = 0; c0 < cols; c0 += COMPARE_CHUNK) {
+                    const long long index = static_cast<long long>(r) * cols + c0;
+                    if (options.stop_at_first && index > stop_after.load(std::memory_order_relaxed)) return;
+                    const int count = std::min(COMPARE_CHUNK, cols - c0);
+                    const long long found = countMismatches<Mode>(a + c0, b + c0, count, options, result.max_abs_error);
+                    result.elements_compared += count;
+                    if (found == 0) continue;
+                    result.mismatches += found;
+                    if (result.first_row < 0) { // Rare path: locate it inside this chunk
+                        int c = c0;
+                        while (withinTolerance<Mode>(a[c], b[c], options)) ++c;
+                        result.first_row = r;
+                        result.first_col = c;
+                        result.first_a = a[c];
+                        result.first_b = b[c];
+                        long long expected = stop_after.load(std::memory_order_relaxed);
+                        const long long mine = static_cast<long long>(r) * cols + c;
+                        while (mine < expected && !stop_after.compare_exchange_weak(expected, mine)) {
+                        }
+                    }
+                    if (options.stop_at_first) return;
+                }
+            }
+        }
+
+        template <ToleranceMode Mode, typename RowA, typename RowB>
+        ComparisonResult compareWith(RowA row_a, RowB row_b, int rows, int cols, const ComparisonOptions& options) {
+            std::atomic<long long> stop_after(std::numeric_limits<long long>::max());
+            const long long elements = static_cast<long long>(rows) * cols;
+            int tasks = 1;
+            if (options.parallel && cols > 0 && elements > COMPARE_TASK_ELEMENTS) {
+                tasks = static_cast<int>(std::min<long long>(rows, elements / COMPARE_TASK_ELEMENTS));
+            }
+            std::vector<ComparisonResult> partial(tasks);
+            auto run = [&](int task) {
+                const int begin = static_cast<int>(static_cast<long long>(rows) * task / tasks);
+                const int end = static_cast<int>(static_cast<long long>(rows) * (task + 1) / tasks);
+                compareRows<Mode>(row_a, row_b, cols, begin, end, options, stop_after, partial[task]);
+            };
+            if (tasks == 1) {
+                run(0);
+            } else {
+                matrixThreadPool().parallelFor(tasks, run);
+            }
+
+            // Ranges are in row order, so the first range with a mismatch holds the first one
+            ComparisonResult result;
+            for (const ComparisonResult& part : partial) {
+                result.elements_compared += part.elements_compared;
+                result.mismatches += part.mismatches;
+                result.max_abs_error = std::max(result.max_abs_error, part.max_abs_error);
+                if (result.first_row < 0 && part.first_row >= 0) {
+                    result.first_row = part.first_row;
+                    result.first_col = part.first_col;
+                    result.first_a = part.first_a;
+                    result.first_b = part.first_b;
+                }
+            }
+            result.equal = result.mismatches == 0;
+            return result;
+        }
+
+        template <typename RowA, typename RowB>
+        ComparisonResult dispatchMode(RowA row_a, RowB row_b, int rows, int cols, const ComparisonOptions& options) {
+            if (!(options.tolerance >= 0.0)) {
+                throw std::invalid_argument("Comparison tolerance must be non-negative.");
+            }
+            switch (options.mode) {
+                case ToleranceMode::Relative:
+                    return compareWith<ToleranceMode::Relative>(row_a, row_b, rows, cols, options);
+                case ToleranceMode::Ulp:
+                    return compareWith<ToleranceMode::Ulp>(row_a, row_b, rows, cols, options);
+                default:
+                    return compareWith<ToleranceMode::Absolute>(row_a, row_b, rows, cols, options);
+            }
+        }
+
+    } // namespace
+
+    ComparisonResult compareElements(ConstDenseMatrixView a, ConstDenseMatrixView b, const ComparisonOptions& options) {
+        if (a.rows() != b.rows() || a.cols() != b.cols()) {
+            throw std::invalid_argument("Matrices have different dimensions.");
+        }
+        return dispatchMode([&](int r) { return a.row(r); }, [&](int r) { return b.row(r); }, a.rows(), a.cols(),
+                            options);
+    }
+
+    ComparisonResult compareElements(const double* const* a_rows, const double* const* b_rows, int rows, int cols,
+                                     const ComparisonOptions& options) {
+        if (rows < 0 || cols < 0) {
+            throw std::invalid_argument("Matrix dimensions cannot be negative.");
+        }
+        return dispatchMode([&](int r) { return a_rows[r]; }, [&](int r) { return b_rows[r]; }, rows, cols, options);
+    }
+
+} // namespace MatrixUtils
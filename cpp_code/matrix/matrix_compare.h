@@ -0,0 +1,52 @@
+// File: matrix_compare.h
+#ifndef MATRIX_COMPARE_H
+#define MATRIX_COMPARE_H
+
+#include "matrix_types.h"
+#include <cstdint> // For uint64_t
+
+namespace MatrixUtils {
+
+    // How two elements a and b are judged equal. Elements that compare == always match
+    // (so infinities of the same sign do); a NaN never matches anything, itself included.
+    enum class ToleranceMode {
+        Absolute, // |a - b| <= tolerance
+        Relative, // |a - b| <= tolerance * max(|a|, |b|), and |a - b| is finite
+        Ulp       // At most max_ulps representable doubles apart
+    };
+
+    struct ComparisonOptions {
+        ToleranceMode mode = ToleranceMode::Absolute;
+        double tolerance = 1e-9; // Absolute and Relative modes
+        uint64_t max_ulps = 4;   // Ulp mode
+        // Stop at the first chunk holding a mismatch. The statistics then cover the elements
+        // scanned so far; turn this off to count every mismatch.
+        bool stop_at_first = true;
+        bool parallel = true; // Split large comparisons into row ranges on the matrix pool
+    };
+
+    // Result of the comparison kernel; the caller formats it, the hot loop never does.
+    struct ComparisonResult {
+        bool equal = true;
+        long long elements_compared = 0; // Less than rows * cols after an early exit
+        long long mismatches = 0;        // Among the elements compared
+        double max_abs_error = 0.0;      // max |a - b| over the elements compared (NaN differences skipped)
+        int first_row = -1;              // First mismatch in row-major order, or -1
+        int first_col = -1;
+        double first_a = 0.0;            // The two elements at the first mismatch
+        double first_b = 0.0;
+    };
+
+    // Throws std::invalid_argument if the shapes differ. The inner loop is AVX2 (scalar
+    // elsewhere), four elements per compare with the mismatch count and the running maximum
+    // kept in registers; the exact position is located only inside the chunk that failed.
+    ComparisonResult compareElements(ConstDenseMatrixView a, ConstDenseMatrixView b,
+                                     const ComparisonOptions& options = {});
+    // Same kernel over rows given as pointers (rows x cols each side), for storage that is
+    // not one strided block, such as the rows of a Matrix
+    ComparisonResult compareElements(const double* const* a_rows, const double* const* b_rows, int rows, int cols,
+                                     const ComparisonOptions& options = {});
+
+} // namespace MatrixUtils
+
+#endif // MATRIX_COMPARE_H
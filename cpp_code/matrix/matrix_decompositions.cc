@@ -0,0 +1,521 @@
+// File: matrix_decompositions.cc
+#include "matrix_decompositions.h"
+#include "matrix_utils.h"
+#include "matrix_backend.h"
+#include "thread_pool.h"
+#include <vector>
+#include <stdexcept>
+#include <cmath>     // For std::fabs, std::log, std::sqrt, std::copysign
+#include <limits>    // For numeric_limits
+#include <utility>   // For std::swap
+#include <algorithm> // For std::swap_ranges, std::min, std::max
+
+namespace MatrixUtils {
+
+    namespace {
+
+        // Right-hand sides handled per task: a rows x RHS_BLOCK panel of B stays in cache
+        // through every sweep of a solve, and independent panels run on the matrix pool.
+        // Columns never interact, so results do not depend on the blocking.
+        constexpr int RHS_BLOCK = 256;
+
+        // Columns factored per panel before the trailing update goes through GEMM
+        constexpr int CHOLESKY_PANEL = 64;
+
+        // Solve pairs in the 1-norm condition estimator (LAPACK uses the same limit)
+        constexpr int HAGER_MAX_ITERATIONS = 5;
+
+        template <typename Fn>
+        void forEachRhsBlock(DenseMatrixView b, Fn&& fn) {
+            const int blocks = (b.cols() + RHS_BLOCK - 1) / RHS_BLOCK;
+            if (blocks <= 1) {
+                fn(b);
+                return;
+            }
+            matrixThreadPool().parallelFor(blocks, [&](int block) {
+                int c0 = block * RHS_BLOCK;
+                fn(b.block(0, c0, b.rows(), std::min(RHS_BLOCK, b.cols() - c0)));
+            });
+        }
+
+        // b = H_k * b on rows k.. of b, with v_k read from column k of qr below the diagonal.
+        // Two row-streaming passes: w = v^T * b, then b -= tau * v * w^T.
+        void applyHouseholder(ConstDenseMatrixView qr, int k, double tau, DenseMatrixView b, std::vector<double>& w) {
+            if (tau == 0.0) return;
+            const int cols = b.cols();
+            w.assign(b.row(k), b.row(k) + cols);
+            for (int i = k + 1; i < b.rows(); ++i) {
+                double v = qr(i, k);
+                if (v == 0.0) continue;
+                const double* b_i = b.row(i);
+                for (int j = 0; j < cols; ++j) w[j] += v * b_i[j];
+            }
+            for (int j = 0; j < cols; ++j) w[j] *= tau;
+            double* b_k = b.row(k);
+            for (int j = 0; j < cols; ++j) b_k[j] -= w[j];
+            for (int i = k + 1; i < b.rows(); ++i) {
+                double v = qr(i, k);
+                if (v == 0.0) continue;
+                double* b_i = b.row(i);
+                for (int j = 0; j < cols; ++j) b_i[j] -= v * w[j];
+            }
+        }
+
+    } // namespace
+
+    // --- LU Decomposition ---
+
+    LUDecomposition luDecompose(ConstDenseMatrixView matrix) {
+        int n;
+        if (!isSquareMatrix(matrix, n)) {
+            throw std::invalid_argument("LU decomposition requires a square matrix.");
+        }
+
+        LUDecomposition result;
+        result.n = n;
+        result.lu = DenseMatrix::fromView(matrix);
+        result.pivots.resize(n);
+        std::vector<double> column_sums(n, 0.0);
+        for (int r = 0; r < n; ++r) {
+            const double* row = matrix.row(r);
+            for (int c = 0; c < n; ++c) column_sums[c] += std::fabs(row[c]);
+        }
+        for (double sum : column_sums) result.norm1 = std::max(result.norm1, sum);
+
+        // Blocked, pivoted factorization from the active backend (built-in or vendor LAPACK)
+        int info = activeMatrixBackend().getrf(result.lu, result.pivots.data());
+        result.singular = info != 0;
+        for (int k = 0; k < n; ++k) {
+            if (result.pivots[k] != k) result.pivot_sign = -result.pivot_sign;
+        }
+        return result;
+    }
+
+    LUDecomposition luDecompose(const Matrix& matrix) {
+        int n;
+        if (!isSquareMatrix(matrix, n)) {
+            throw std::invalid_argument("LU decomposition requires a square matrix.");
+        }
+        return luDecompose(DenseMatrix(matrix));
+    }
+
+    double LUDecomposition::determinant() const {
+        if (singular) {
+            return 0.0;
+        }
+        double det = static_cast<double>(pivot_sign);
+        for (int k = 0; k < n; ++k) {
+            det *= at(k, k);
+        }
+        return det;
+    }
+
+    double LUDecomposition::logAbsDeterminant() const {
+        if (singular) {
+            return -std::numeric_limits<double>::infinity();
+        }
+        double sum = 0.0;
+        for (int k = 0; k < n; ++k) {
+            sum += std::log(std::fabs(at(k, k)));
+        }
+        return sum;
+    }
+
+    void LUDecomposition::solveInPlace(DenseMatrixView x) const {
+        if (x.rows() != n) {
+            throw std::invalid_argument("Right-hand side rows do not match the factorized matrix.");
+        }
+        if (singular) {
+            throw std::runtime_error("Matrix is singular; the system has no unique solution.");
+        }
+        const MatrixBackend& backend = activeMatrixBackend();
+        forEachRhsBlock(x, [&](DenseMatrixView panel) {
+            const int cols = panel.cols();
+            for (int k = 0; k < n; ++k) {
+                if (pivots[k] != k) std::swap_ranges(panel.row(k), panel.row(k) + cols, panel.row(pivots[k]));
+            }
+            backend.trsm(TriangularKind::LowerUnit, lu, panel);
+            backend.trsm(TriangularKind::Upper, lu, panel);
+        });
+    }
+
+    void LUDecomposition::solveTransposeInPlace(DenseMatrixView x) const {
+        if (x.rows() != n) {
+            throw std::invalid_argument("Right-hand side rows do not match the factorized matrix.");
+        }
+        if (singular) {
+            throw std::runtime_error("Matrix is singular; the system has no unique solution.");
+        }
+        // A^T = U^T * L^T * P: forward substitution with U^T, back substitution with L^T, then
+        // the row swaps undone in reverse. Row k of U (or L) scatters into the rows after (or
+        // before) it, so each step streams one row of the factors.
+        forEachRhsBlock(x, [&](DenseMatrixView panel) {
+            const int cols = panel.cols();
+            for (int k = 0; k < n; ++k) {
+                const double* u_row = lu.row(k);
+                double* x_k = panel.row(k);
+                const double inv_diag = 1.0 / u_row[k];
+                for (int j = 0; j < cols; ++j) x_k[j] *= inv_diag;
+                for (int r = k + 1; r < n; ++r) {
+                    const double u = u_row[r];
+                    if (u == 0.0) continue;
+                    double* x_r = panel.row(r);
+                    for (int j = 0; j < cols; ++j) x_r[j] -= u * x_k[j];
+                }
+            }
+            for (int k = n - 1; k > 0; --k) {
+                const double* l_row = lu.row(k);
+                const double* x_k = panel.row(k);
+                for (int r = 0; r < k; ++r) {
+                    const double l = l_row[r];
+                    if (l == 0.0) continue;
+                    double* x_r = panel.row(r);
+                    for (int j = 0; j < cols; ++j) x_r[j] -= l * x_k[j];
+                }
+            }
+            for (int k = n - 1; k >= 0; --k) {
+                if (pivots[k] != k) std::swap_ranges(panel.row(k), panel.row(k) + cols, panel.row(pivots[k]));
+            }
+        });
+    }
+
+    std::vector<double> LUDecomposition::solve(const std::vector<double>& b) const {
+        if (static_cast<int>(b.size()) != n) {
+            throw std::invalid_argument("Right-hand side length does not match the factorized matrix.");
+        }
+        std::vector<double> x = b;
+        solveInPlace(DenseMatrixView(x.data(), n, 1, 1));
+        return x;
+    }
+
+    DenseMatrix LUDecomposition::solve(ConstDenseMatrixView b) const {
+        DenseMatrix x = DenseMatrix::fromView(b);
+        solveInPlace(x);
+        return x;
+    }
+
+    Matrix LUDecomposition::solve(const Matrix& b) const {
+        int rows, cols;
+        if (!isValidMatrix(b, rows, cols) || rows != n) {
+            throw std::invalid_argument("Right-hand side rows do not match the factorized matrix.");
+        }
+        return solve(DenseMatrix(b).view()).toMatrix();
+    }
+
+    DenseMatrix LUDecomposition::inverse() const {
+        DenseMatrix x = DenseMatrix::identity(n);
+        solveInPlace(x);
+        return x;
+    }
+
+    double LUDecomposition::inverseNorm1Estimate() const {
+        if (singular) return std::numeric_limits<double>::infinity();
+        if (n == 0) return 0.0;
+        // Higham's refinement of Hager's method (LAPACK dlacn2): a few steps of gradient
+        // ascent for max ||A^-1 x||_1 over ||x||_1 = 1, whose maximum sits at a unit vector
+        std::vector<double> x(n, 1.0 / n), sign(n), z(n);
+        DenseMatrixView x_view(x.data(), n, 1, 1);
+        auto norm1Of = [&](const std::vector<double>& v) {
+            double sum = 0.0;
+            for (double e : v) sum += std::fabs(e);
+            return sum;
+        };
+        auto argmaxAbs = [&](const std::vector<double>& v) {
+            int best = 0;
+            for (int i = 1; i < n; ++i) {
+                if (std::fabs(v[i]) > std::fabs(v[best])) best = i;
+            }
+            return best;
+        };
+
+        solveInPlace(x_view);
+        double estimate = norm1Of(x);
+        if (n > 1) {
+            for (int i = 0; i < n; ++i) sign[i] = x[i] >= 0.0 ? 1.0 : -1.0;
+            z = sign;
+            solveTransposeInPlace(DenseMatrixView(z.data(), n, 1, 1));
+            int j = argmaxAbs(z);
+            for (int iteration = 2; iteration <= HAGER_MAX_ITERATIONS; ++iteration) {
+                std::fill(x.begin(), x.end(), 0.0);
+                x[j] = 1.0;
+                solveInPlace(x_view);
+                const double previous = estimate;
+                estimate = norm1Of(x);
+                bool same_signs = true;
+                for (int i = 0; i < n && same_signs; ++i) same_signs = (x[i] >= 0.0 ? 1.0 : -1.0) == sign[i];
+                if (same_signs || estimate <= previous) {
+                    estimate = std::max(estimate, previous);
+                    break;
+                }
+                for (int i = 0; i < n; ++i) sign[i] = x[i] >= 0.0 ? 1.0 : -1.0;
+                z = sign;
+                solveTransposeInPlace(DenseMatrixView(z.data(), n, 1, 1));
+                const int last = j;
+                j = argmaxAbs(z);
+                if (std::fabs(z[last]) == std::fabs(z[j])) break;
+            }
+            // Alternating-sign probe: catches the matrices that defeat the ascent
+            for (int i = 0; i < n; ++i) x[i] = (i % 2 ? -1.0 : 1.0) * (1.0 + static_cast<double>(i) / (n - 1));
+            solveInPlace(x_view);
+            estimate = std::max(estimate, 2.0 * norm1Of(x) / (3.0 * n));
+        }
+        return estimate;
+    }
+
+    double LUDecomposition::reciprocalConditionEstimate() const {
+        if (singular) return 0.0;
+        if (n == 0 || norm1 == 0.0) return 1.0;
+        const double inverse_norm = inverseNorm1Estimate();
+        if (!std::isfinite(inverse_norm)) return 0.0;
+        return 1.0 / (norm1 * inverse_norm);
+    }
+
+    bool LUDecomposition::invertible() const {
+        return !singular && reciprocalConditionEstimate() >= std::numeric_limits<double>::epsilon();
+    }
+
+    // --- Cholesky Decomposition ---
+
+    CholeskyDecomposition choleskyDecompose(ConstDenseMatrixView matrix) {
+        int n;
+        if (!isSquareMatrix(matrix, n)) {
+            throw std::invalid_argument("Cholesky decomposition requires a square matrix.");
+        }
+
+        CholeskyDecomposition result;
+        result.n = n;
+        result.l = DenseMatrix(n, n);
+        DenseMatrixView a = result.l;
+        for (int r = 0; r < n; ++r) {
+            std::copy(matrix.row(r), matrix.row(r) + r + 1, a.row(r));
+        }
+
+        // Right-looking blocked factorization: factor a panel, solve for the block below
+        // it, then one GEMM applies its contribution to the trailing matrix
+        const MatrixBackend& backend = activeMatrixBackend();
+        for (int k = 0; k < n; k += CHOLESKY_PANEL) {
+            const int nb = std::min(CHOLESKY_PANEL, n - k);
+            for (int j = k; j < k + nb; ++j) {
+                const double* row_j = a.row(j);
+                double d = row_j[j];
+                for (int p = k; p < j; ++p) d -= row_j[p] * row_j[p];
+                if (!(d > 0.0)) {
+                    result.positive_definite = false;
+                    return result;
+                }
+                const double l_jj = std::sqrt(d);
+                a(j, j) = l_jj;
+                for (int i = j + 1; i < k + nb; ++i) {
+                    double* row_i = a.row(i);
+                    double sum = row_i[j];
+                    for (int p = k; p < j; ++p) sum -= row_i[p] * row_j[p];
+                    row_i[j] = sum / l_jj;
+                }
+            }
+            const int rest = n - k - nb;
+            if (rest > 0) {
+                // L21 = A21 * L11^-T, computed as (L11^-1 * A21^T)^T so the left-sided trsm applies
+                DenseMatrix panel_t(nb, rest);
+                for (int i = 0; i < rest; ++i) {
+                    for (int p = 0; p < nb; ++p) panel_t(p, i) = a(k + nb + i, k + p);
+                }
+                backend.trsm(TriangularKind::Lower, a.block(k, k, nb, nb), panel_t);
+                for (int i = 0; i < rest; ++i) {
+                    for (int p = 0; p < nb; ++p) a(k + nb + i, k + p) = panel_t(p, i);
+                }
+                // A22 -= L21 * L21^T; the upper triangle gets updated too and is cleared below
+                backend.gemm(-1.0, a.block(k + nb, k, rest, nb), panel_t, 1.0, a.block(k + nb, k + nb, rest, rest));
+            }
+        }
+
+        for (int r = 0; r < n; ++r) {
+            std::fill(a.row(r) + r + 1, a.row(r) + n, 0.0);
+        }
+        result.lt = transposeMatrix(result.l);
+        return result;
+    }
+
+    CholeskyDecomposition choleskyDecompose(const Matrix& matrix) {
+        int n;
+        if (!isSquareMatrix(matrix, n)) {
+            throw std::invalid_argument("Cholesky decomposition requires a square matrix.");
+        }
+        return choleskyDecompose(DenseMatrix(matrix));
+    }
+
+    double CholeskyDecomposition::determinant() const {
+        if (!positive_definite) {
+            throw std::runtime_error("Matrix is not positive definite; Cholesky factorization failed.");
+        }
+        double det = 1.0;
+        for (int k = 0; k < n; ++k) det *= l(k, k);
+        return det * det;
+    }
+
+    double CholeskyDecomposition::logAbsDeterminant() const {
+        if (!positive_definite) {
+            throw std::runtime_error("Matrix is not positive definite; Cholesky factorization failed.");
+        }
+        double sum = 0.0;
+        for (int k = 0; k < n; ++k) sum += std::log(l(k, k));
+        return 2.0 * sum;
+    }
+
+    void CholeskyDecomposition::solveInPlace(DenseMatrixView x) const {
+        if (x.rows() != n) {
+            throw std::invalid_argument("Right-hand side rows do not match the factorized matrix.");
+        }
+        if (!positive_definite) {
+            throw std::runtime_error("Matrix is not positive definite; Cholesky factorization failed.");
+        }
+        const MatrixBackend& backend = activeMatrixBackend();
+        forEachRhsBlock(x, [&](DenseMatrixView panel) {
+            backend.trsm(TriangularKind::Lower, l, panel);
+            backend.trsm(TriangularKind::Upper, lt, panel);
+        });
+    }
+
+    std::vector<double> CholeskyDecomposition::solve(const std::vector<double>& b) const {
+        if (static_cast<int>(b.size()) != n) {
+            throw std::invalid_argument("Right-hand side length does not match the factorized matrix.");
+        }
+        std::vector<double> x = b;
+        solveInPlace(DenseMatrixView(x.data(), n, 1, 1));
+        return x;
+    }
+
+    DenseMatrix CholeskyDecomposition::solve(ConstDenseMatrixView b) const {
+        DenseMatrix x = DenseMatrix::fromView(b);
+        solveInPlace(x);
+        return x;
+    }
+
+    Matrix CholeskyDecomposition::solve(const Matrix& b) const {
+        int rows, cols;
+        if (!isValidMatrix(b, rows, cols) || rows != n) {
+            throw std::invalid_argument("Right-hand side rows do not match the factorized matrix.");
+        }
+        return solve(DenseMatrix(b).view()).toMatrix();
+    }
+
+    // --- QR Decomposition ---
+
+    QRDecomposition qrDecompose(ConstDenseMatrixView matrix) {
+        int m, n;
+        if (!isValidMatrix(matrix, m, n)) {
+            throw std::invalid_argument("QR decomposition requires a non-empty matrix.");
+        }
+        if (m < n) {
+            throw std::invalid_argument("QR decomposition requires at least as many rows as columns.");
+        }
+
+        QRDecomposition result;
+        result.rows = m;
+        result.cols = n;
+        result.qr = DenseMatrix::fromView(matrix);
+        result.tau.assign(n, 0.0);
+        DenseMatrixView a = result.qr;
+        std::vector<double> w;
+
+        for (int k = 0; k < n; ++k) {
+            // Scale by the largest entry so the norm cannot overflow or underflow
+            double scale = 0.0;
+            for (int i = k; i < m; ++i) scale = std::max(scale, std::fabs(a(i, k)));
+            if (scale == 0.0) {
+                result.rank_deficient = true; // Zero column: H_k = I, R(k, k) = 0
+                continue;
+            }
+            double tail_sq = 0.0;
+            for (int i = k + 1; i < m; ++i) {
+                double v = a(i, k) / scale;
+                tail_sq += v * v;
+            }
+            const double alpha = a(k, k);
+            if (tail_sq == 0.0) {
+                continue; // Already upper triangular in this column: H_k = I
+            }
+            const double beta = -std::copysign(scale * std::sqrt((alpha / scale) * (alpha / scale) + tail_sq), alpha);
+            result.tau[k] = (beta - alpha) / beta;
+            const double inv_head = 1.0 / (alpha - beta);
+            for (int i = k + 1; i < m; ++i) a(i, k) *= inv_head;
+            a(k, k) = beta;
+            if (k + 1 < n) {
+                applyHouseholder(a, k, result.tau[k], a.block(0, k + 1, m, n - k - 1), w);
+            }
+        }
+        return result;
+    }
+
+    QRDecomposition qrDecompose(const Matrix& matrix) {
+        int rows, cols;
+        if (!isValidMatrix(matrix, rows, cols)) {
+            throw std::invalid_argument("QR decomposition requires a non-empty matrix.");
+        }
+        return qrDecompose(DenseMatrix(matrix));
+    }
+
+    void QRDecomposition::applyQTransposeInPlace(DenseMatrixView b) const {
+        if (b.rows() != rows) {
+            throw std::invalid_argument("Right-hand side rows do not match the factorized matrix.");
+        }
+        forEachRhsBlock(b, [&](DenseMatrixView panel) {
+            std::vector<double> w;
+            for (int k = 0; k < cols; ++k) applyHouseholder(qr, k, tau[k], panel, w);
+        });
+    }
+
+    void QRDecomposition::applyQInPlace(DenseMatrixView b) const {
+        if (b.rows() != rows) {
+            throw std::invalid_argument("Right-hand side rows do not match the factorized matrix.");
+        }
+        forEachRhsBlock(b, [&](DenseMatrixView panel) {
+            std::vector<double> w;
+            for (int k = cols - 1; k >= 0; --k) applyHouseholder(qr, k, tau[k], panel, w);
+        });
+    }
+
+    DenseMatrix QRDecomposition::solve(ConstDenseMatrixView b) const {
+        if (b.rows() != rows) {
+            throw std::invalid_argument("Right-hand side rows do not match the factorized matrix.");
+        }
+        if (rank_deficient) {
+            throw std::runtime_error("Matrix is rank deficient; the least-squares solution is not unique.");
+        }
+        DenseMatrix work = DenseMatrix::fromView(b);
+        const MatrixBackend& backend = activeMatrixBackend();
+        ConstDenseMatrixView r_factor = qr.view().block(0, 0, cols, cols);
+        forEachRhsBlock(work, [&](DenseMatrixView panel) {
+            std::vector<double> w;
+            for (int k = 0; k < cols; ++k) applyHouseholder(qr, k, tau[k], panel, w);
+            backend.trsm(TriangularKind::Upper, r_factor, panel.block(0, 0, cols, panel.cols()));
+        });
+        return DenseMatrix::fromView(work.view().block(0, 0, cols, work.cols()));
+    }
+
+    std::vector<double> QRDecomposition::solve(const std::vector<double>& b) const {
+        if (static_cast<int>(b.size()) != rows) {
+            throw std::invalid_argument("Right-hand side length does not match the factorized matrix.");
+        }
+        DenseMatrix x = solve(ConstDenseMatrixView(b.data(), rows, 1, 1));
+        std::vector<double> out(cols);
+        for (int k = 0; k < cols; ++k) out[k] = x(k, 0);
+        return out;
+    }
+
+    Matrix QRDecomposition::solve(const Matrix& b) const {
+        int b_rows, b_cols;
+        if (!isValidMatrix(b, b_rows, b_cols) || b_rows != rows) {
+            throw std::invalid_argument("Right-hand side rows do not match the factorized matrix.");
+        }
+        return solve(DenseMatrix(b).view()).toMatrix();
+    }
+
+    DenseMatrix QRDecomposition::r() const {
+        DenseMatrix out(cols, cols);
+        for (int i = 0; i < cols; ++i) {
+            for (int j = i; j < cols; ++j) out(i, j) = qr(i, j);
+        }
+        return out;
+    }
+
+} // namespace MatrixUtils
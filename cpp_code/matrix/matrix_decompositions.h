@@ -0,0 +1,98 @@
+// File: matrix_decompositions.h
+#ifndef MATRIX_DECOMPOSITIONS_H
+#define MATRIX_DECOMPOSITIONS_H
+
+#include "matrix_types.h"
+#include <vector>
+
+namespace MatrixUtils {
+
+    // Factorization used by solve(); Auto picks Cholesky for symmetric matrices with a
+    // positive diagonal (falling back to LU if that fails), LU for other square matrices
+    // and QR for tall ones. MixedPrecision (never picked by Auto) is a float LU refined to
+    // double accuracy, see matrix_refinement.h.
+    enum class SolveMethod { Auto, LU, Cholesky, QR, MixedPrecision };
+
+    // LU factorization with partial pivoting: P*A = L*U.
+    // L (unit lower) and U (upper) are packed into `lu`; `pivots[k]` is the row that was
+    // swapped with row k at step k (LAPACK getrf convention).
+    // One factorization can serve the determinant, the inverse and any number of solves.
+    struct LUDecomposition {
+        int n = 0;
+        DenseMatrix lu;
+        std::vector<int> pivots;
+        int pivot_sign = 1;    // (-1)^(number of row swaps)
+        bool singular = false; // True if an exactly zero pivot was met
+        double norm1 = 0.0;    // ||A||_1 (largest absolute column sum) of the factorized matrix
+
+        double at(int r, int c) const { return lu(r, c); }
+
+        double determinant() const;
+        double logAbsDeterminant() const; // log|det|, safe from overflow for large n
+        void solveInPlace(DenseMatrixView b) const; // Overwrites every column of b with A^-1 * b
+        void solveTransposeInPlace(DenseMatrixView b) const; // b = A^-T * b
+        std::vector<double> solve(const std::vector<double>& b) const;
+        DenseMatrix solve(ConstDenseMatrixView b) const;
+        Matrix solve(const Matrix& b) const;
+        DenseMatrix inverse() const;
+
+        // Hager/Higham estimate of ||A^-1||_1 from a handful of solves with A and A^T, so
+        // O(n^2) on top of the factorization; it is a lower bound that is almost always
+        // within a factor of 3 of the true norm. Infinity if singular.
+        double inverseNorm1Estimate() const;
+        // 1 / (||A||_1 * ||A^-1||_1) estimated as above: 1 for orthogonal matrices, near
+        // machine epsilon or below when A is singular to working precision. Unlike |det|,
+        // it is invariant under scaling A.
+        double reciprocalConditionEstimate() const;
+        // False if A is exactly singular or its reciprocal condition is below machine
+        // epsilon, where solves and the inverse carry no correct digits.
+        bool invertible() const;
+    };
+
+    LUDecomposition luDecompose(ConstDenseMatrixView matrix);
+    LUDecomposition luDecompose(const Matrix& matrix);
+
+    // Cholesky factorization of a symmetric positive definite matrix: A = L*L^T.
+    // Only the lower triangle of A is read. About half the work of LU and needs no pivoting.
+    struct CholeskyDecomposition {
+        int n = 0;
+        DenseMatrix l;  // Lower triangle holds L; the strict upper triangle is zero
+        DenseMatrix lt; // L^T, kept so both triangular solves stream rows
+        bool positive_definite = true; // False if a non-positive pivot was met
+
+        double determinant() const;
+        double logAbsDeterminant() const;
+        void solveInPlace(DenseMatrixView b) const;
+        std::vector<double> solve(const std::vector<double>& b) const;
+        DenseMatrix solve(ConstDenseMatrixView b) const;
+        Matrix solve(const Matrix& b) const;
+    };
+
+    CholeskyDecomposition choleskyDecompose(ConstDenseMatrixView matrix);
+    CholeskyDecomposition choleskyDecompose(const Matrix& matrix);
+
+    // Householder QR of an m x n matrix with m >= n: A = Q*R.
+    // R sits on and above the diagonal of `qr`; below it, column k holds the Householder
+    // vector v_k (implicit leading 1) with H_k = I - tau[k] * v_k * v_k^T (LAPACK geqrf layout).
+    struct QRDecomposition {
+        int rows = 0;
+        int cols = 0;
+        DenseMatrix qr;
+        std::vector<double> tau;
+        bool rank_deficient = false; // True if some R(k, k) is exactly zero
+
+        void applyQTransposeInPlace(DenseMatrixView b) const; // b = Q^T * b, b has `rows` rows
+        void applyQInPlace(DenseMatrixView b) const;          // b = Q * b
+        // Least-squares solution minimising ||A x - b||_2 (the exact solution when A is square)
+        DenseMatrix solve(ConstDenseMatrixView b) const;
+        std::vector<double> solve(const std::vector<double>& b) const;
+        Matrix solve(const Matrix& b) const;
+        DenseMatrix r() const; // The n x n upper triangular factor
+    };
+
+    QRDecomposition qrDecompose(ConstDenseMatrixView matrix);
+    QRDecomposition qrDecompose(const Matrix& matrix);
+
+} // namespace MatrixUtils
+
+#endif // MATRIX_DECOMPOSITIONS_H
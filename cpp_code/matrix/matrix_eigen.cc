@@ -0,0 +1,787 @@
+// File: matrix_eigen.cc
+#include "matrix_eigen.h"
+#include "matrix_utils.h"
+#include "matrix_backend.h"
+#include "thread_pool.h"
+#include <algorithm> // For std::sort, std::min, std::max
+#include <cmath>     // For std::fabs, std::sqrt, std::hypot, std::copysign
+#include <limits>    // For numeric_limits
+#include <numeric>   // For std::iota
+#include <stdexcept>
+#include <vector>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define MATRIX_EIGEN_AVX2 1
+#endif
+
+namespace MatrixUtils {
+
+    namespace {
+
+        // Reflectors per panel in the blocked tridiagonalization and the WY back-transformation
+        constexpr int EIGEN_PANEL = 32;
+
+        // Columns of the eigenvector matrix per task when replaying QL rotations
+        constexpr int ROTATION_STRIP = 256;
+
+        // Rows (or columns) per task in the Hessenberg updates; small updates stay serial
+        constexpr int HESSENBERG_GRAIN = 64;
+
+        // Bytes of rows (of g and w) two Jacobi blocks may hold so a block pair stays in cache
+        constexpr size_t JACOBI_BLOCK_BYTES = size_t(256) << 10;
+
+        constexpr int QL_MAX_ITERATIONS = 60;    // Per eigenvalue
+        constexpr int HQR_MAX_ITERATIONS = 60;   // Per eigenvalue, exceptional shift every 10
+        constexpr int JACOBI_MAX_SWEEPS = 60;
+
+        const double EPS = std::numeric_limits<double>::epsilon();
+
+        // Runs fn(begin, end) over [0, count) in chunks of `grain` on the matrix pool
+        template <typename Fn>
+        void parallelRanges(int count, int grain, Fn&& fn) {
+            const int chunks = (count + grain - 1) / grain;
+            if (chunks <= 1) {
+                if (count > 0) fn(0, count);
+                return;
+            }
+            matrixThreadPool().parallelFor(chunks, [&](int chunk) {
+                int begin = chunk * grain;
+                fn(begin, std::min(count, begin + grain));
+            });
+        }
+
+        // Householder reflector H = I - tau * v * v^T with H * [alpha; x] = [beta; 0] and v(0) = 1
+        // (LAPACK dlarfg). Overwrites x with v(1:), returns tau and sets alpha = beta.
+        double makeReflector(double& alpha, double* x, int count, size_t x_stride) {
+            double scale = 0.0;
+            for (int i = 0; i < count; ++i) scale = std::max(scale, std::fabs(x[i * x_stride]));
+            if (scale == 0.0) return 0.0;
+            double sum_sq = 0.0;
+            for (int i = 0; i < count; ++i) {
+                double t = x[i * x_stride] / scale;
+                sum_sq += t * t;
+            }
+            const double xnorm = scale * std::sqrt(sum_sq);
+            const double beta = -std::copysign(std::hypot(alpha, xnorm), alpha);
+            const double tau = (beta - alpha) / beta;
+            const double inv_head = 1.0 / (alpha - beta);
+            for (int i = 0; i < count; ++i) x[i * x_stride] *= inv_head;
+            alpha = beta;
+            return tau;
+        }
+
+        DenseMatrix transposed(ConstDenseMatrixView m) {
+            DenseMatrix t(m.cols(), m.rows());
+            transposeInto(m, t);
+            return t;
+        }
+
+        // --- Symmetric: tridiagonalization (LAPACK dsytrd/dlatrd, lower, full storage) ---
+        // On return d/e hold the tridiagonal matrix (e[k] couples k and k + 1) and column k of
+        // `a` below row k + 1 holds reflector k's vector, with the implicit 1 stored at (k + 1, k).
+        void tridiagonalize(DenseMatrix& a, std::vector<double>& d, std::vector<double>& e, std::vector<double>& tau) {
+            const int n = a.rows();
+            const MatrixBackend& backend = activeMatrixBackend();
+            d.assign(n, 0.0);
+            e.assign(n, 0.0);
+            tau.assign(n, 0.0);
+            DenseMatrix w(n, EIGEN_PANEL);
+            std::vector<double> v(n), wcol(n), wv(EIGEN_PANEL), vv(EIGEN_PANEL);
+
+            for (int i = 0; i < n - 1; i += EIGEN_PANEL) {
+                const int nb = std::min(EIGEN_PANEL, n - 1 - i);
+                for (int j = 0; j < nb; ++j) {
+                    const int c = i + j;
+                    // Bring column c up to date: A(c:, c) -= V * W(c, :)^T + W * V(c, :)^T
+                    if (j > 0) {
+                        const double* v_c = a.row(c) + i;
+                        const double* w_c = w.row(c);
+                        for (int r = c; r < n; ++r) {
+                            const double* v_r = a.row(r) + i;
+                            const double* w_r = w.row(r);
+                            double s = 0.0;
+                            for (int jj = 0; jj < j; ++jj) s += v_r[jj] * w_c[jj] + w_r[jj] * v_c[jj];
+                            a(r, c) -= s;
+                        }
+                    }
+
+                    const int len = n - c - 1;
+                    double alpha = a(c + 1, c);
+                    double t = makeReflector(alpha, len > 1 ? &a(c + 2, c) : nullptr, len - 1, a.stride());
+                    e[c] = alpha;
+                    tau[c] = t;
+                    a(c + 1, c) = 1.0;
+                    for (int r = 0; r < len; ++r) v[r] = a(c + 1 + r, c);
+
+                    // w = tau * (A_trailing - V W^T - W V^T) v, then w -= (tau / 2)(w.v) v
+                    if (t != 0.0) {
+                        backend.gemv(1.0, a.view().block(c + 1, c + 1, len, len), v.data(), 0.0, wcol.data());
+                        if (j > 0) {
+                            std::fill(wv.begin(), wv.begin() + j, 0.0);
+                            std::fill(vv.begin(), vv.begin() + j, 0.0);
+                            for (int r = 0; r < len; ++r) {
+                                const double* v_r = a.row(c + 1 + r) + i;
+                                const double* w_r = w.row(c + 1 + r);
+                                for (int jj = 0; jj < j; ++jj) {
+                                    wv[jj] += w_r[jj] * v[r];
+                                    vv[jj] += v_r[jj] * v[r];
+                                }
+                            }
+                            for (int r = 0; r < len; ++r) {
+                                const double* v_r = a.row(c + 1 + r) + i;
+                                const double* w_r = w.row(c + 1 + r);
+                                double s = 0.0;
+                                for (int jj = 0; jj < j; ++jj) s += v_r[jj] * wv[jj] + w_r[jj] * vv[jj];
+                                wcol[r] -= s;
+                            }
+                        }
+                        double dot = 0.0;
+                        for (int r = 0; r < len; ++r) {
+                            wcol[r] *= t;
+                            dot += wcol[r] * v[r];
+                        }
+                        const double correction = -0.5 * t * dot;
+                        for (int r = 0; r < len; ++r) wcol[r] += correction * v[r];
+                    } else {
+                        std::fill(wcol.begin(), wcol.begin() + len, 0.0);
+                    }
+                    for (int r = i; r <= c; ++r) w(r, j) = 0.0;
+                    for (int r = 0; r < len; ++r) w(c + 1 + r, j) = wcol[r];
+                    d[c] = a(c, c);
+                }
+
+                // Trailing update A22 -= V2 * W2^T + W2 * V2^T through two GEMMs
+                const int t0 = i + nb;
+                const int tn = n - t0;
+                if (tn > 0) {
+                    ConstDenseMatrixView v2 = a.view().block(t0, i, tn, nb);
+                    ConstDenseMatrixView w2 = w.view().block(t0, 0, tn, nb);
+                    DenseMatrix v2_copy = DenseMatrix::fromView(v2);
+                    DenseMatrix v2_t = transposed(v2_copy);
+                    DenseMatrix w2_t = transposed(w2);
+                    DenseMatrixView trailing = a.view().block(t0, t0, tn, tn);
+                    backend.gemm(-1.0, v2_copy, w2_t, 1.0, trailing);
+                    backend.gemm(-1.0, w2, v2_t, 1.0, trailing);
+                }
+            }
+            d[n - 1] = a(n - 1, n - 1);
+        }
+
+        // z = Q * z with Q = H_0 * H_1 * ... * H_{n-2} from tridiagonalize, one block of
+        // EIGEN_PANEL reflectors at a time as I - V * T * V^T (LAPACK dlarft/dlarfb).
+        void applyTridiagonalQ(const DenseMatrix& a, const std::vector<double>& tau, DenseMatrix& z) {
+            const int n = a.rows();
+            const int reflectors = n - 1;
+            if (reflectors <= 0) return;
+            const MatrixBackend& backend = activeMatrixBackend();
+            const int last_block = (reflectors - 1) / EIGEN_PANEL * EIGEN_PANEL;
+            for (int kb = last_block; kb >= 0; kb -= EIGEN_PANEL) {
+                const int nb = std::min(EIGEN_PANEL, reflectors - kb);
+                const int r0 = kb + 1;
+                const int rows = n - r0;
+                DenseMatrix v(rows, nb);
+                for (int j = 0; j < nb; ++j) {
+                    const int k = kb + j;
+                    v(k + 1 - r0, j) = 1.0;
+                    for (int r = k + 2; r < n; ++r) v(r - r0, j) = a(r, k);
+                }
+                DenseMatrix v_t = transposed(v);
+
+                // T(0:j, j) = -tau_j * T(0:j, 0:j) * V(:, 0:j)^T v_j
+                DenseMatrix t(nb, nb);
+                std::vector<double> tmp(nb);
+                for (int j = 0; j < nb; ++j) {
+                    const double tau_j = tau[kb + j];
+                    t(j, j) = tau_j;
+                    if (j == 0 || tau_j == 0.0) continue;
+                    for (int p = 0; p < j; ++p) {
+                        const double* vp = v_t.row(p);
+                        const double* vj = v_t.row(j);
+                        double s = 0.0;
+                        for (int r = 0; r < rows; ++r) s += vp[r] * vj[r];
+                        tmp[p] = s;
+                    }
+                    for (int p = 0; p < j; ++p) {
+                        double s = 0.0;
+                        for (int q = p; q < j; ++q) s += t(p, q) * tmp[q];
+                        t(p, j) = -tau_j * s;
+                    }
+                }
+
+                DenseMatrixView zb = z.view().block(r0, 0, rows, z.cols());
+                DenseMatrix vtz(nb, z.cols());
+                backend.gemm(1.0, v_t, zb, 0.0, vtz);
+                DenseMatrix tvtz(nb, z.cols());
+                backend.gemm(1.0, t, vtz, 0.0, tvtz);
+                backend.gemm(-1.0, v, tvtz, 1.0, zb);
+            }
+        }
+
+        struct PlaneRotation {
+            int row; // Rotates rows row and row + 1
+            double c;
+            double s;
+        };
+
+        // Replays one QL sweep's rotations on the rows of zt, in column strips on the pool
+        void applyRotations(const std::vector<PlaneRotation>& rotations, DenseMatrix& zt) {
+            if (rotations.empty()) return;
+            const int cols = zt.cols();
+            parallelRanges(cols, ROTATION_STRIP, [&](int begin, int end) {
+                for (const PlaneRotation& rot : rotations) {
+                    double* upper = zt.row(rot.row);
+                    double* lower = zt.row(rot.row + 1);
+                    const double c = rot.c, s = rot.s;
+                    for (int k = begin; k < end; ++k) {
+                        double f = lower[k];
+                        lower[k] = s * upper[k] + c * f;
+                        upper[k] = c * upper[k] - s * f;
+                    }
+                }
+            });
+        }
+
+        // Implicit QL with Wilkinson shifts on the symmetric tridiagonal (d, e) (EISPACK tql2).
+        // Row j of zt (if given) accumulates the eigenvector of d[j] in the tridiagonal basis.
+        void tridiagonalQL(std::vector<double>& d, std::vector<double>& e, DenseMatrix* zt) {
+            const int n = static_cast<int>(d.size());
+            if (n == 0) return;
+            e[n - 1] = 0.0;
+            std::vector<PlaneRotation> rotations;
+            for (int l = 0; l < n; ++l) {
+                int iterations = 0;
+                int m;
+                do {
+                    for (m = l; m < n - 1; ++m) {
+                        double dd = std::fabs(d[m]) + std::fabs(d[m + 1]);
+                        if (std::fabs(e[m]) <= EPS * dd) break;
+                    }
+                    if (m == l) break;
+                    if (++iterations > QL_MAX_ITERATIONS) {
+                        throw std::runtime_error("Symmetric eigenvalue iteration did not converge.");
+                    }
+                    double g = (d[l + 1] - d[l]) / (2.0 * e[l]);
+                    double r = std::hypot(g, 1.0);
+                    g = d[m] - d[l] + e[l] / (g + std::copysign(r, g));
+                    double s = 1.0, c = 1.0, p = 0.0;
+                    int i;
+                    rotations.clear();
+                    for (i = m - 1; i >= l; --i) {
+                        double f = s * e[i];
+                        double b = c * e[i];
+                        r = std::hypot(f, g);
+                        e[i + 1] = r;
+                        if (r == 0.0) { // Underflow: split the matrix here and retry
+                            d[i + 1] -= p;
+                            e[m] = 0.0;
+                            break;
+                        }
+                        s = f / r;
+                        c = g / r;
+                        g = d[i + 1] - p;
+                        r = (d[i] - g) * s + 2.0 * c * b;
+                        p = s * r;
+                        d[i + 1] = g + p;
+                        g = c * r - b;
+                        if (zt) rotations.push_back({i, c, s});
+                    }
+                    if (zt) applyRotations(rotations, *zt);
+                    if (r == 0.0 && i >= l) continue;
+                    d[l] -= p;
+                    e[l] = g;
+                    e[m] = 0.0;
+                } while (m != l);
+            }
+        }
+
+        // --- General: balancing, Hessenberg reduction, Francis QR ---
+
+        // Diagonal similarity by powers of two so rows and columns have comparable norms
+        // (EISPACK balanc); eigenvalues are unchanged and rounding no longer favours large entries.
+        void balance(DenseMatrix& a) {
+            const int n = a.rows();
+            const double radix = 2.0, radix_sq = radix * radix;
+            bool done = false;
+            while (!done) {
+                done = true;
+                for (int i = 0; i < n; ++i) {
+                    double c = 0.0, r = 0.0;
+                    for (int j = 0; j < n; ++j) {
+                        if (j == i) continue;
+                        c += std::fabs(a(j, i));
+                        r += std::fabs(a(i, j));
+                    }
+                    if (c == 0.0 || r == 0.0) continue;
+                    double g = r / radix, f = 1.0, s = c + r;
+                    while (c < g) {
+                        f *= radix;
+                        c *= radix_sq;
+                    }
+                    g = r * radix;
+                    while (c > g) {
+                        f /= radix;
+                        c /= radix_sq;
+                    }
+                    if ((c + r) / f < 0.95 * s) {
+                        done = false;
+                        double inv_f = 1.0 / f;
+                        double* row = a.row(i);
+                        for (int j = 0; j < n; ++j) row[j] *= inv_f;
+                        for (int j = 0; j < n; ++j) a(j, i) *= f;
+                    }
+                }
+            }
+        }
+
+        // A = H^T * A * H with Householder reflectors; afterwards a(i, j) = 0 for i > j + 1.
+        // The left update streams rows twice (w = v^T A, then A -= tau v w^T) with column
+        // strips on the pool; the right update is one pass per row, rows on the pool.
+        void reduceToHessenberg(DenseMatrix& a) {
+            const int n = a.rows();
+            std::vector<double> v(n), w(n);
+            for (int k = 0; k + 2 < n; ++k) {
+                const int len = n - k - 1;
+                double alpha = a(k + 1, k);
+                double tau = makeReflector(alpha, &a(k + 2, k), len - 1, a.stride());
+                a(k + 1, k) = alpha;
+                v[0] = 1.0;
+                for (int r = 1; r < len; ++r) {
+                    v[r] = a(k + 1 + r, k);
+                    a(k + 1 + r, k) = 0.0;
+                }
+                if (tau == 0.0) continue;
+
+                // Left: rows k+1.., columns k+1..
+                const int c0 = k + 1;
+                const int width = n - c0;
+                parallelRanges(width, HESSENBERG_GRAIN * 4, [&](int begin, int end) {
+                    for (int j = begin; j < end; ++j) w[j] = 0.0;
+                    for (int r = 0; r < len; ++r) {
+                        const double vr = v[r];
+                        const double* row = a.row(k + 1 + r) + c0;
+                        for (int j = begin; j < end; ++j) w[j] += vr * row[j];
+                    }
+                    for (int r = 0; r < len; ++r) {
+                        const double scale = tau * v[r];
+                        double* row = a.row(k + 1 + r) + c0;
+                        for (int j = begin; j < end; ++j) row[j] -= scale * w[j];
+                    }
+                });
+
+                // Right: every row, columns k+1..
+                parallelRanges(n, HESSENBERG_GRAIN, [&](int begin, int end) {
+                    for (int i = begin; i < end; ++i) {
+                        double* row = a.row(i) + c0;
+                        double s = 0.0;
+                        for (int j = 0; j < len; ++j) s += row[j] * v[j];
+                        s *= tau;
+                        for (int j = 0; j < len; ++j) row[j] -= s * v[j];
+                    }
+                });
+            }
+        }
+
+        // Eigenvalues of an upper Hessenberg matrix by the Francis double-shift QR iteration
+        // (EISPACK hqr). Works in place on the active window; written with 1-based indices
+        // through h() to stay close to the published algorithm.
+        void hessenbergEigenvalues(DenseMatrix& a, std::vector<double>& wr, std::vector<double>& wi) {
+            const int n = a.rows();
+            wr.assign(n + 1, 0.0);
+            wi.assign(n + 1, 0.0);
+            auto h = [&](int i, int j) -> double& { return a(i - 1, j - 1); };
+
+            double anorm = 0.0;
+            for (int i = 1; i <= n; ++i) {
+                for (int j = std::max(i - 1, 1); j <= n; ++j) anorm += std::fabs(h(i, j));
+            }
+            int nn = n;
+            double t = 0.0;
+            while (nn >= 1) {
+                int its = 0;
+                int l;
+                do {
+                    for (l = nn; l >= 2; --l) {
+                        double s = std::fabs(h(l - 1, l - 1)) + std::fabs(h(l, l));
+                        if (s == 0.0) s = anorm;
+                        if (std::fabs(h(l, l - 1)) <= EPS * s) {
+                            h(l, l - 1) = 0.0;
+                            break;
+                        }
+                    }
+                    double x = h(nn, nn);
+                    if (l == nn) { // One root found
+                        wr[nn] = x + t;
+                        wi[nn] = 0.0;
+                        --nn;
+                    } else {
+                        double y = h(nn - 1, nn - 1);
+                        double w = h(nn, nn - 1) * h(nn - 1, nn);
+                        if (l == nn - 1) { // Two roots found
+                            double p = 0.5 * (y - x);
+                            double q = p * p + w;
+                            double z = std::sqrt(std::fabs(q));
+                            x += t;
+                            if (q >= 0.0) {
+                                z = p + std::copysign(z, p);
+                                wr[nn - 1] = wr[nn] = x + z;
+                                if (z != 0.0) wr[nn] = x - w / z;
+                                wi[nn - 1] = wi[nn] = 0.0;
+                            } else {
+                                wr[nn - 1] = wr[nn] = x + p;
+                                wi[nn] = z;
+                                wi[nn - 1] = -z;
+                            }
+                            nn -= 2;
+                        } else {
+                            if (its == HQR_MAX_ITERATIONS) {
+                                throw std::runtime_error("Hessenberg QR iteration did not converge.");
+                            }
+                            if (its > 0 && its % 10 == 0) { // Exceptional shift
+                                t += x;
+                                for (int i = 1; i <= nn; ++i) h(i, i) -= x;
+                                double s = std::fabs(h(nn, nn - 1)) + std::fabs(h(nn - 1, nn - 2));
+                                y = x = 0.75 * s;
+                                w = -0.4375 * s * s;
+                            }
+                            ++its;
+                            int m;
+                            double p = 0.0, q = 0.0, r = 0.0, z = 0.0;
+                            for (m = nn - 2; m >= l; --m) {
+                                z = h(m, m);
+                                r = x - z;
+                                double s = y - z;
+                                p = (r * s - w) / h(m + 1, m) + h(m, m + 1);
+                                q = h(m + 1, m + 1) - z - r - s;
+                                r = h(m + 2, m + 1);
+                                s = std::fabs(p) + std::fabs(q) + std::fabs(r);
+                                p /= s;
+                                q /= s;
+                                r /= s;
+                                if (m == l) break;
+                                double u = std::fabs(h(m, m - 1)) * (std::fabs(q) + std::fabs(r));
+                                double v = std::fabs(p) * (std::fabs(h(m - 1, m - 1)) + std::fabs(z) + std::fabs(h(m + 1, m + 1)));
+                                if (u <= EPS * v) break;
+                            }
+                            for (int i = m + 2; i <= nn; ++i) {
+                                h(i, i - 2) = 0.0;
+                                if (i != m + 2) h(i, i - 3) = 0.0;
+                            }
+                            for (int k = m; k <= nn - 1; ++k) {
+                                if (k != m) {
+                                    p = h(k, k - 1);
+                                    q = h(k + 1, k - 1);
+                                    r = (k != nn - 1) ? h(k + 2, k - 1) : 0.0;
+                                    x = std::fabs(p) + std::fabs(q) + std::fabs(r);
+                                    if (x != 0.0) {
+                                        p /= x;
+                                        q /= x;
+                                        r /= x;
+                                    }
+                                }
+                                double s = std::copysign(std::sqrt(p * p + q * q + r * r), p);
+                                if (s == 0.0) continue;
+                                if (k == m) {
+                                    if (l != m) h(k, k - 1) = -h(k, k - 1);
+                                } else {
+                                    h(k, k - 1) = -s * x;
+                                }
+                                p += s;
+                                x = p / s;
+                                y = q / s;
+                                z = r / s;
+                                q /= p;
+                                r /= p;
+                                for (int j = k; j <= nn; ++j) { // Row modification
+                                    p = h(k, j) + q * h(k + 1, j);
+                                    if (k != nn - 1) {
+                                        p += r * h(k + 2, j);
+                                        h(k + 2, j) -= p * z;
+                                    }
+                                    h(k + 1, j) -= p * y;
+                                    h(k, j) -= p * x;
+                                }
+                                int mmin = nn < k + 3 ? nn : k + 3;
+                                for (int i = l; i <= mmin; ++i) { // Column modification
+                                    p = x * h(i, k) + y * h(i, k + 1);
+                                    if (k != nn - 1) {
+                                        p += z * h(i, k + 2);
+                                        h(i, k + 2) -= p * r;
+                                    }
+                                    h(i, k + 1) -= p * q;
+                                    h(i, k) -= p;
+                                }
+                            }
+                        }
+                    }
+                } while (l < nn - 1);
+            }
+            wr.erase(wr.begin());
+            wi.erase(wi.begin());
+        }
+
+        // --- One-sided Jacobi ---
+
+        double dot(const double* x, const double* y, int count) {
+            int k = 0;
+            double sum = 0.0;
+#ifdef MATRIX_EIGEN_AVX2
+            // Four vector accumulators hide the FMA latency
+            __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+            __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+            for (; k + 16 <= count; k += 16) {
+                s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + k), _mm256_loadu_pd(y + k), s0);
+                s1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + k + 4), _mm256_loadu_pd(y + k + 4), s1);
+                s2 = _mm256_fmadd_pd(_mm256_loadu_pd(x + k + 8), _mm256_loadu_pd(y + k + 8), s2);
+                s3 = _mm256_fmadd_pd(_mm256_loadu_pd(x + k + 12), _mm256_loadu_pd(y + k + 12), s3);
+            }
+            for (; k + 4 <= count; k += 4) s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + k), _mm256_loadu_pd(y + k), s0);
+            __m256d v = _mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3));
+            __m128d h = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+            sum = _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+#else
+            // Four accumulators break the dependency chain of a single running sum
+            double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+            for (; k + 4 <= count; k += 4) {
+                s0 += x[k] * y[k];
+                s1 += x[k + 1] * y[k + 1];
+                s2 += x[k + 2] * y[k + 2];
+                s3 += x[k + 3] * y[k + 3];
+            }
+            sum = (s0 + s1) + (s2 + s3);
+#endif
+            for (; k < count; ++k) sum += x[k] * y[k];
+            return sum;
+        }
+
+        void rotateRows(double* x, double* y, int count, double c, double s) {
+            for (int k = 0; k < count; ++k) {
+                double xk = x[k], yk = y[k];
+                x[k] = c * xk - s * yk;
+                y[k] = s * xk + c * yk;
+            }
+        }
+
+        // Orthogonalises the rows of g (q x p) against each other by plane rotations, applying
+        // the same rotations to the rows of w (q x q, initially I, or empty). Rows are grouped
+        // into blocks small enough that two fit in cache; a sweep first rotates the pairs inside
+        // each block, then visits every pair of blocks in round-robin order (each round's block
+        // pairs are disjoint and run in parallel) and rotates all cross pairs while both blocks
+        // are resident. Without blocking every rotation streams its rows from memory.
+        int jacobiOrthogonaliseRows(DenseMatrix& g, DenseMatrix& w) {
+            const int q = g.rows();
+            const int p = g.cols();
+            const bool track = !w.empty();
+            const double tolerance = std::sqrt(static_cast<double>(std::max(p, 1))) * EPS;
+            const size_t row_bytes = sizeof(double) * (static_cast<size_t>(p) + (track ? q : 0));
+            int block = static_cast<int>(std::max<size_t>(1, JACOBI_BLOCK_BYTES / (2 * row_bytes)));
+            block = std::min(block, std::max(1, (q + 7) / 8)); // Leave some block pairs to share out
+            const int blocks = (q + block - 1) / block;
+            const int players = blocks + (blocks % 2); // An odd count gets a bye, marked by index blocks
+            std::vector<int> order(players);
+            std::vector<double> norm_sq(q);
+            std::vector<char> rotated(std::max(players / 2, blocks));
+
+            // Rotates rows i < j if they are not yet orthogonal to working precision
+            auto rotatePair = [&](int i, int j) {
+                const double alpha = norm_sq[i], beta = norm_sq[j];
+                if (alpha == 0.0 || beta == 0.0) return false;
+                const double gamma = dot(g.row(i), g.row(j), p);
+                if (std::fabs(gamma) <= tolerance * std::sqrt(alpha * beta)) return false;
+                const double zeta = (beta - alpha) / (2.0 * gamma);
+                const double t = std::copysign(1.0, zeta) / (std::fabs(zeta) + std::sqrt(1.0 + zeta * zeta));
+                const double c = 1.0 / std::sqrt(1.0 + t * t);
+                const double s = c * t;
+                rotateRows(g.row(i), g.row(j), p, c, s);
+                if (track) rotateRows(w.row(i), w.row(j), q, c, s);
+                norm_sq[i] = alpha - t * gamma;
+                norm_sq[j] = beta + t * gamma;
+                return true;
+            };
+
+            for (int sweep = 1; sweep <= JACOBI_MAX_SWEEPS; ++sweep) {
+                for (int i = 0; i < q; ++i) norm_sq[i] = dot(g.row(i), g.row(i), p); // Refresh: no drift
+                bool any = false;
+                std::fill(rotated.begin(), rotated.end(), 0);
+                matrixThreadPool().parallelFor(blocks, [&](int b) {
+                    const int end = std::min(q, (b + 1) * block);
+                    for (int i = b * block; i < end; ++i) {
+                        for (int j = i + 1; j < end; ++j) rotated[b] |= rotatePair(i, j);
+                    }
+                });
+                for (char r : rotated) any = any || r;
+
+                std::iota(order.begin(), order.end(), 0);
+                for (int round = 0; round + 1 < players; ++round) {
+                    std::fill(rotated.begin(), rotated.end(), 0);
+                    matrixThreadPool().parallelFor(players / 2, [&](int pair) {
+                        int bi = order[pair];
+                        int bj = order[players - 1 - pair];
+                        if (bi >= blocks || bj >= blocks) return;
+                        if (bi > bj) std::swap(bi, bj);
+                        const int i_end = std::min(q, (bi + 1) * block);
+                        const int j_end = std::min(q, (bj + 1) * block);
+                        for (int i = bi * block; i < i_end; ++i) {
+                            for (int j = bj * block; j < j_end; ++j) rotated[pair] |= rotatePair(i, j);
+                        }
+                    });
+                    for (char r : rotated) any = any || r;
+                    // Keep order[0] fixed and rotate the rest one place (circle method)
+                    std::rotate(order.begin() + 1, order.end() - 1, order.end());
+                }
+                if (!any) return sweep;
+            }
+            throw std::runtime_error("Jacobi SVD did not converge.");
+        }
+
+    } // namespace
+
+    // --- Symmetric eigendecomposition ---
+
+    SymmetricEigenDecomposition symmetricEigenDecompose(ConstDenseMatrixView matrix, bool compute_vectors) {
+        int n;
+        if (!isSquareMatrix(matrix, n)) {
+            throw std::invalid_argument("Symmetric eigendecomposition requires a square matrix.");
+        }
+        DenseMatrix a(n, n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j <= i; ++j) a(i, j) = a(j, i) = matrix(i, j); // Mirror the lower triangle
+        }
+
+        std::vector<double> d, e, tau;
+        tridiagonalize(a, d, e, tau);
+
+        SymmetricEigenDecomposition result;
+        result.n = n;
+        DenseMatrix zt = compute_vectors ? DenseMatrix::identity(n) : DenseMatrix();
+        tridiagonalQL(d, e, compute_vectors ? &zt : nullptr);
+
+        std::vector<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int x, int y) { return d[x] < d[y]; });
+        result.eigenvalues.resize(n);
+        for (int k = 0; k < n; ++k) result.eigenvalues[k] = d[order[k]];
+        if (compute_vectors) {
+            DenseMatrix sorted(n, n); // Row k: eigenvector k in the tridiagonal basis
+            for (int k = 0; k < n; ++k) std::copy(zt.row(order[k]), zt.row(order[k]) + n, sorted.row(k));
+            result.eigenvectors = transposed(sorted);
+            applyTridiagonalQ(a, tau, result.eigenvectors);
+        }
+        return result;
+    }
+
+    SymmetricEigenDecomposition symmetricEigenDecompose(const Matrix& matrix, bool compute_vectors) {
+        int rows, cols;
+        if (!isValidMatrix(matrix, rows, cols) || rows != cols) {
+            throw std::invalid_argument("Symmetric eigendecomposition requires a square matrix.");
+        }
+        return symmetricEigenDecompose(DenseMatrix(matrix), compute_vectors);
+    }
+
+    // --- General eigenvalues ---
+
+    std::vector<std::complex<double>> calculateEigenvalues(ConstDenseMatrixView matrix) {
+        int n;
+        if (!isSquareMatrix(matrix, n)) {
+            throw std::invalid_argument("Eigenvalues require a square matrix.");
+        }
+        DenseMatrix a = DenseMatrix::fromView(matrix);
+        balance(a);
+        reduceToHessenberg(a);
+        std::vector<double> wr, wi;
+        hessenbergEigenvalues(a, wr, wi);
+
+        std::vector<std::complex<double>> values(n);
+        for (int i = 0; i < n; ++i) values[i] = {wr[i], wi[i]};
+        std::sort(values.begin(), values.end(), [](const std::complex<double>& x, const std::complex<double>& y) {
+            return x.real() != y.real() ? x.real() < y.real() : x.imag() < y.imag();
+        });
+        return values;
+    }
+
+    std::vector<std::complex<double>> calculateEigenvalues(const Matrix& matrix) {
+        int rows, cols;
+        if (!isValidMatrix(matrix, rows, cols) || rows != cols) {
+            throw std::invalid_argument("Eigenvalues require a square matrix.");
+        }
+        return calculateEigenvalues(DenseMatrix(matrix));
+    }
+
+    // --- Singular value decomposition ---
+
+    SingularValueDecomposition singularValueDecompose(ConstDenseMatrixView matrix, bool compute_vectors) {
+        int m, n;
+        if (!isValidMatrix(matrix, m, n)) {
+            throw std::invalid_argument("SVD requires a non-empty matrix.");
+        }
+        // Work on B = A (tall) or B = A^T (wide), so B is m' x k with k = min(m, n). B = Q R,
+        // and one-sided Jacobi orthogonalises the rows of R: W R = S Y with W orthogonal and
+        // S = diag(row norms). Then B = (Q W^T) S Y, so U_B = Q W^T and V_B = Y^T. The QR step
+        // concentrates the column norms on the diagonal of R, which roughly halves the sweeps
+        // on graded matrices.
+        const bool tall = m >= n;
+        const int k = std::min(m, n);
+        const int long_len = std::max(m, n);
+        QRDecomposition qr = qrDecompose(tall ? DenseMatrix::fromView(matrix) : transposed(matrix));
+        DenseMatrix g = qr.r();
+        DenseMatrix w = compute_vectors ? DenseMatrix::identity(k) : DenseMatrix();
+
+        SingularValueDecomposition result;
+        result.rows = m;
+        result.cols = n;
+        result.sweeps = jacobiOrthogonaliseRows(g, w);
+
+        std::vector<double> sigma(k);
+        for (int i = 0; i < k; ++i) sigma[i] = std::sqrt(dot(g.row(i), g.row(i), k));
+        std::vector<int> order(k);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int x, int y) { return sigma[x] > sigma[y]; });
+        result.singular_values.resize(k);
+        for (int j = 0; j < k; ++j) result.singular_values[j] = sigma[order[j]];
+        if (!compute_vectors) return result;
+
+        // Column j of the long side is Q times row order[j] of W (zero-padded to m' rows); column
+        // j of the short side is the normalised row order[j] of g. A zero singular value leaves
+        // its short-side vector zero.
+        DenseMatrix long_vectors(long_len, k), short_vectors(k, k);
+        for (int j = 0; j < k; ++j) {
+            const int src = order[j];
+            const double inv = sigma[src] > 0.0 ? 1.0 / sigma[src] : 0.0;
+            const double* g_row = g.row(src);
+            for (int r = 0; r < k; ++r) short_vectors(r, j) = g_row[r] * inv;
+            const double* w_row = w.row(src);
+            for (int r = 0; r < k; ++r) long_vectors(r, j) = w_row[r];
+        }
+        qr.applyQInPlace(long_vectors);
+        if (tall) {
+            result.u = std::move(long_vectors);
+            result.v = std::move(short_vectors);
+        } else {
+            result.u = std::move(short_vectors);
+            result.v = std::move(long_vectors);
+        }
+        return result;
+    }
+
+    SingularValueDecomposition singularValueDecompose(const Matrix& matrix, bool compute_vectors) {
+        int rows, cols;
+        if (!isValidMatrix(matrix, rows, cols)) {
+            throw std::invalid_argument("SVD requires a non-empty matrix.");
+        }
+        return singularValueDecompose(DenseMatrix(matrix), compute_vectors);
+    }
+
+    int SingularValueDecomposition::rank(double tolerance) const {
+        if (singular_values.empty()) return 0;
+        if (tolerance < 0.0) tolerance = std::max(rows, cols) * EPS * singular_values.front();
+        int r = 0;
+        for (double s : singular_values) r += s > tolerance ? 1 : 0;
+        return r;
+    }
+
+    double SingularValueDecomposition::conditionNumber() const {
+        if (singular_values.empty() || singular_values.back() == 0.0) return std::numeric_limits<double>::infinity();
+        return singular_values.front() / singular_values.back();
+    }
+
+} // namespace MatrixUtils
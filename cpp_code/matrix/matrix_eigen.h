@@ -0,0 +1,57 @@
+// File: matrix_eigen.h
+#ifndef MATRIX_EIGEN_H
+#define MATRIX_EIGEN_H
+
+#include "matrix_types.h"
+#include <complex>
+#include <vector>
+
+namespace MatrixUtils {
+
+    // Symmetric eigendecomposition A = V * diag(eigenvalues) * V^T.
+    // Blocked Householder tridiagonalization (panel columns are reduced with GEMV, the
+    // trailing matrix is updated with two GEMMs), then implicit QL with Wilkinson shifts on
+    // the tridiagonal matrix. Plane rotations are recorded per QL sweep and replayed over
+    // column strips of the eigenvector matrix on the matrix pool; the Householder
+    // reflectors are applied last as blocked WY updates through GEMM.
+    struct SymmetricEigenDecomposition {
+        int n = 0;
+        std::vector<double> eigenvalues; // Ascending
+        DenseMatrix eigenvectors;        // Column j belongs to eigenvalues[j]; empty if not computed
+    };
+
+    // Only the lower triangle of the matrix is read. Throws std::runtime_error if QL fails to
+    // converge (practically unheard of for finite input).
+    SymmetricEigenDecomposition symmetricEigenDecompose(ConstDenseMatrixView matrix, bool compute_vectors = true);
+    SymmetricEigenDecomposition symmetricEigenDecompose(const Matrix& matrix, bool compute_vectors = true);
+
+    // Eigenvalues of a general square matrix: Householder reduction to upper Hessenberg form,
+    // then the Francis double-shift QR iteration, so complex pairs come out conjugate and
+    // real matrices never need complex arithmetic. Sorted by real part, then imaginary part.
+    std::vector<std::complex<double>> calculateEigenvalues(ConstDenseMatrixView matrix);
+    std::vector<std::complex<double>> calculateEigenvalues(const Matrix& matrix);
+
+    // Thin SVD A = U * diag(singular_values) * V^T of an m x n matrix, k = min(m, n).
+    // A (or A^T when A is wide) is first reduced to its k x k R factor by QR, then one-sided
+    // Jacobi (Hestenes) orthogonalises the rows of R by plane rotations, in cache-sized
+    // blocks whose disjoint pairs run in parallel. Jacobi is slower than bidiagonalization
+    // but computes small singular values to high relative accuracy.
+    struct SingularValueDecomposition {
+        int rows = 0;
+        int cols = 0;
+        std::vector<double> singular_values; // Descending, k of them
+        DenseMatrix u;                       // rows x k, orthonormal columns; empty if not computed
+        DenseMatrix v;                       // cols x k
+        int sweeps = 0;                      // Jacobi sweeps until convergence
+
+        // Singular values above tolerance; a negative tolerance means max(m, n) * eps * sigma_max
+        int rank(double tolerance = -1.0) const;
+        double conditionNumber() const; // sigma_max / sigma_min (infinity if singular)
+    };
+
+    SingularValueDecomposition singularValueDecompose(ConstDenseMatrixView matrix, bool compute_vectors = true);
+    SingularValueDecomposition singularValueDecompose(const Matrix& matrix, bool compute_vectors = true);
+
+} // namespace MatrixUtils
+
+#endif // MATRIX_EIGEN_H
@@ -0,0 +1,153 @@
+// File: matrix_exact.cc
+#include "matrix_utils.h"
+#include "big_integer.h"
+#include <vector>
+#include <stdexcept>
+#include <cmath>     // For std::trunc, std::fabs
+#include <utility>   // For std::swap, std::move
+#include <limits>
+
+namespace MatrixUtils {
+
+    namespace {
+
+        __extension__ typedef __int128 Int128; // GCC/Clang extension; -pedantic would warn on the bare keyword
+
+        // Largest magnitude at which every integer is exactly representable as a double
+        constexpr double MAX_EXACT_DOUBLE_INTEGER = 9007199254740992.0; // 2^53
+
+        // Fraction-free Gaussian elimination. Every intermediate entry is a minor of the input,
+        // so the division by the previous pivot is always exact.
+        // Returns false (leaving `det` untouched) if a checked Int128 operation overflows.
+        bool bareissInt128(std::vector<Int128> a, int n, Int128& det) {
+            int sign = 1;
+            Int128 prev = 1;
+            for (int k = 0; k < n - 1; ++k) {
+                if (a[k * n + k] == 0) {
+                    int swap_row = k + 1;
+                    while (swap_row < n && a[swap_row * n + k] == 0) ++swap_row;
+                    if (swap_row == n) {
+                        det = 0;
+                        return true;
+                    }
+                    for (int c = 0; c < n; ++c) std::swap(a[k * n + c], a[swap_row * n + c]);
+                    sign = -sign;
+                }
+                const Int128 pivot = a[k * n + k];
+                for (int i = k + 1; i < n; ++i) {
+                    const Int128 a_ik = a[i * n + k];
+                    for (int j = k + 1; j < n; ++j) {
+                        Int128 lhs, rhs, diff;
+                        if (__builtin_mul_overflow(a[i * n + j], pivot, &lhs) ||
+                            __builtin_mul_overflow(a_ik, a[k * n + j], &rhs) ||
+                            __builtin_sub_overflow(lhs, rhs, &diff)) {
+                            return false;
+                        }
+                        a[i * n + j] = diff / prev;
+                    }
+                }
+                prev = pivot;
+            }
+            det = sign < 0 ? -a[(n - 1) * n + (n - 1)] : a[(n - 1) * n + (n - 1)];
+            return true;
+        }
+
+        BigInteger bareissBig(const std::vector<std::vector<long long>>& matrix, int n) {
+            std::vector<BigInteger> a(static_cast<size_t>(n) * n);
+            for (int r = 0; r < n; ++r) {
+                for (int c = 0; c < n; ++c) a[r * n + c] = BigInteger(matrix[r][c]);
+            }
+            bool negate = false;
+            BigInteger prev(1);
+            for (int k = 0; k < n - 1; ++k) {
+                if (a[k * n + k].isZero()) {
+                    int swap_row = k + 1;
+                    while (swap_row < n && a[swap_row * n + k].isZero()) ++swap_row;
+                    if (swap_row == n) return BigInteger(0);
+                    for (int c = 0; c < n; ++c) std::swap(a[k * n + c], a[swap_row * n + c]);
+                    negate = !negate;
+                }
+                const BigInteger pivot = a[k * n + k];
+                for (int i = k + 1; i < n; ++i) {
+                    const BigInteger a_ik = a[i * n + k];
+                    for (int j = k + 1; j < n; ++j) {
+                        a[i * n + j] = (a[i * n + j] * pivot - a_ik * a[k * n + j]) / prev;
+                    }
+                }
+                prev = pivot;
+            }
+            const BigInteger& last = a[(n - 1) * n + (n - 1)];
+            return negate ? -last : last;
+        }
+
+        std::string int128ToString(Int128 value) {
+            if (value == 0) return "0";
+            bool negative = value < 0;
+            std::string digits;
+            while (value != 0) {
+                int digit = static_cast<int>(value % 10);
+                digits.insert(digits.begin(), static_cast<char>('0' + (negative ? -digit : digit)));
+                value /= 10;
+            }
+            return negative ? "-" + digits : digits;
+        }
+
+    } // namespace
+
+    ExactDeterminantResponse calculateDeterminantExact(const std::vector<std::vector<long long>>& matrix) {
+        const int n = static_cast<int>(matrix.size());
+        if (n == 0) {
+            throw std::invalid_argument("Determinant requires a square matrix.");
+        }
+        for (const auto& row : matrix) {
+            if (static_cast<int>(row.size()) != n) {
+                throw std::invalid_argument("Determinant requires a square matrix.");
+            }
+        }
+
+        ExactDeterminantResponse response;
+        std::vector<Int128> a(static_cast<size_t>(n) * n);
+        for (int r = 0; r < n; ++r) {
+            for (int c = 0; c < n; ++c) a[r * n + c] = matrix[r][c];
+        }
+
+        Int128 det128;
+        if (bareissInt128(std::move(a), n, det128)) {
+            response.determinant = int128ToString(det128);
+            response.fits_in_int64 = det128 >= static_cast<Int128>(std::numeric_limits<long long>::min()) &&
+                                     det128 <= static_cast<Int128>(std::numeric_limits<long long>::max());
+            response.determinant_int64 = response.fits_in_int64 ? static_cast<long long>(det128) : 0;
+            response.used_multiprecision = false;
+            return response;
+        }
+
+        // Intermediates outgrew 127 bits: redo the elimination in arbitrary precision
+        BigInteger det = bareissBig(matrix, n);
+        response.determinant = det.toString();
+        response.fits_in_int64 = det.fitsInt64();
+        response.determinant_int64 = response.fits_in_int64 ? det.toInt64() : 0;
+        response.used_multiprecision = true;
+        return response;
+    }
+
+    ExactDeterminantResponse calculateDeterminantExact(const MatrixInput& input) {
+        int n;
+        if (!isSquareMatrix(input.matrix, n)) {
+            throw std::invalid_argument("Determinant requires a square matrix.");
+        }
+        std::vector<std::vector<long long>> integers(n, std::vector<long long>(n));
+        for (int r = 0; r < n; ++r) {
+            for (int c = 0; c < n; ++c) {
+                double v = input.matrix[r][c];
+                if (std::trunc(v) != v || std::fabs(v) > MAX_EXACT_DOUBLE_INTEGER) {
+                    throw std::invalid_argument("Exact determinant requires integer entries with |value| <= 2^53.");
+                }
+                integers[r][c] = static_cast<long long>(v);
+            }
+        }
+        ExactDeterminantResponse response = calculateDeterminantExact(integers);
+        response.input_matrix = input.matrix;
+        return response;
+    }
+
+} // namespace MatrixUtils
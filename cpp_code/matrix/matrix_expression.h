@@ -0,0 +1,239 @@
+// File: matrix_expression.h
+#ifndef MATRIX_EXPRESSION_H
+#define MATRIX_EXPRESSION_H
+
+#include "dense_matrix.h"
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility> // For std::declval
+
+namespace MatrixUtils {
+
+    // Lazy elementwise arithmetic over DenseMatrix. `alpha * a + b - c` builds a small tree
+    // of nodes that hold views, not data; nothing is computed until the tree is assigned to
+    // a DenseMatrix or passed to evaluateInto, which then runs one fused loop with no
+    // temporaries. Like views, expressions must not outlive the matrices they refer to.
+    //
+    // Every node is elementwise, so `a = a + b` is safe: each output element depends only
+    // on the inputs at the same position. (Matrix products are not expressions; use
+    // multiplyMatrices.)
+
+    template <typename E>
+    class MatrixExpression {
+    public:
+        const E& derived() const { return static_cast<const E&>(*this); }
+        int rows() const { return derived().rows(); }
+        int cols() const { return derived().cols(); }
+        double operator()(int r, int c) const { return derived()(r, c); }
+    };
+
+    // Leaf: reads straight from a matrix or view
+    class MatrixLeaf : public MatrixExpression<MatrixLeaf> {
+    public:
+        explicit MatrixLeaf(ConstDenseMatrixView view) : view_(view) {}
+        int rows() const { return view_.rows(); }
+        int cols() const { return view_.cols(); }
+        double operator()(int r, int c) const { return view_(r, c); }
+
+    private:
+        ConstDenseMatrixView view_;
+    };
+
+    template <typename Op, typename L, typename R>
+    class BinaryExpression : public MatrixExpression<BinaryExpression<Op, L, R>> {
+    public:
+        BinaryExpression(const L& lhs, const R& rhs, Op op = Op()) : lhs_(lhs), rhs_(rhs), op_(op) {
+            if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols()) {
+                throw std::invalid_argument("Matrices must have the same dimensions for elementwise operations.");
+            }
+        }
+        int rows() const { return lhs_.rows(); }
+        int cols() const { return lhs_.cols(); }
+        double operator()(int r, int c) const { return op_(lhs_(r, c), rhs_(r, c)); }
+
+    private:
+        L lhs_;
+        R rhs_;
+        Op op_;
+    };
+
+    template <typename Op, typename E>
+    class UnaryExpression : public MatrixExpression<UnaryExpression<Op, E>> {
+    public:
+        UnaryExpression(const E& operand, Op op) : operand_(operand), op_(op) {}
+        int rows() const { return operand_.rows(); }
+        int cols() const { return operand_.cols(); }
+        double operator()(int r, int c) const { return op_(operand_(r, c)); }
+
+    private:
+        E operand_;
+        Op op_;
+    };
+
+    namespace expression_ops {
+        struct Add { double operator()(double a, double b) const { return a + b; } };
+        struct Subtract { double operator()(double a, double b) const { return a - b; } };
+        struct Multiply { double operator()(double a, double b) const { return a * b; } };
+        struct Divide { double operator()(double a, double b) const { return a / b; } };
+        struct Scale {
+            double factor;
+            double operator()(double a) const { return factor * a; }
+        };
+        struct DivideBy {
+            double divisor;
+            double operator()(double a) const { return a / divisor; }
+        };
+        struct Shift {
+            double offset;
+            double operator()(double a) const { return a + offset; }
+        };
+    } // namespace expression_ops
+
+    namespace expression_detail {
+        // Anything usable as an operand: an expression, a DenseMatrix or a view
+        inline MatrixLeaf toExpression(ConstDenseMatrixView view) { return MatrixLeaf(view); }
+        inline MatrixLeaf toExpression(const DenseMatrix& matrix) { return MatrixLeaf(matrix.view()); }
+        inline MatrixLeaf toExpression(DenseMatrixView view) { return MatrixLeaf(view); }
+        template <typename E>
+        const E& toExpression(const MatrixExpression<E>& expression) { return expression.derived(); }
+
+        template <typename T, typename = void>
+        struct IsOperand : std::false_type {};
+        template <typename T>
+        struct IsOperand<T, decltype(void(toExpression(std::declval<const T&>())))> : std::true_type {};
+
+        template <typename T>
+        using ExpressionOf = std::decay_t<decltype(toExpression(std::declval<const T&>()))>;
+
+        template <typename A, typename B>
+        using EnableIfOperands = std::enable_if_t<IsOperand<std::decay_t<A>>::value && IsOperand<std::decay_t<B>>::value>;
+        template <typename A>
+        using EnableIfOperand = std::enable_if_t<IsOperand<std::decay_t<A>>::value>;
+    } // namespace expression_detail
+
+    // Wraps a matrix or view so it can start an expression explicitly, e.g. lazy(a).
+    inline MatrixLeaf lazy(ConstDenseMatrixView view) { return MatrixLeaf(view); }
+
+    // --- Operators ---
+    // Defined for expressions, DenseMatrix and views alike; each returns a new node.
+
+    template <typename A, typename B, typename = expression_detail::EnableIfOperands<A, B>>
+    auto operator+(const A& a, const B& b) {
+        using namespace expression_detail;
+        return BinaryExpression<expression_ops::Add, ExpressionOf<A>, ExpressionOf<B>>(toExpression(a), toExpression(b));
+    }
+
+    template <typename A, typename B, typename = expression_detail::EnableIfOperands<A, B>>
+    auto operator-(const A& a, const B& b) {
+        using namespace expression_detail;
+        return BinaryExpression<expression_ops::Subtract, ExpressionOf<A>, ExpressionOf<B>>(toExpression(a), toExpression(b));
+    }
+
+    template <typename A, typename = expression_detail::EnableIfOperand<A>>
+    auto operator*(double factor, const A& a) {
+        using namespace expression_detail;
+        return UnaryExpression<expression_ops::Scale, ExpressionOf<A>>(toExpression(a), expression_ops::Scale{factor});
+    }
+
+    template <typename A, typename = expression_detail::EnableIfOperand<A>>
+    auto operator*(const A& a, double factor) {
+        return factor * a;
+    }
+
+    // A true division per element, not a multiply by 1 / divisor: (a / d)(r, c) is exactly
+    // a(r, c) / d, as in the eager, non-fused code
+    template <typename A, typename = expression_detail::EnableIfOperand<A>>
+    auto operator/(const A& a, double divisor) {
+        using namespace expression_detail;
+        return UnaryExpression<expression_ops::DivideBy, ExpressionOf<A>>(toExpression(a), expression_ops::DivideBy{divisor});
+    }
+
+    template <typename A, typename = expression_detail::EnableIfOperand<A>>
+    auto operator-(const A& a) {
+        return -1.0 * a;
+    }
+
+    // a + offset applied to every element
+    template <typename A, typename = expression_detail::EnableIfOperand<A>>
+    auto operator+(const A& a, double offset) {
+        using namespace expression_detail;
+        return UnaryExpression<expression_ops::Shift, ExpressionOf<A>>(toExpression(a), expression_ops::Shift{offset});
+    }
+
+    template <typename A, typename = expression_detail::EnableIfOperand<A>>
+    auto operator-(const A& a, double offset) {
+        return a + (-offset);
+    }
+
+    // Elementwise (Hadamard) product and quotient; `*` between matrices is deliberately absent
+    template <typename A, typename B, typename = expression_detail::EnableIfOperands<A, B>>
+    auto hadamard(const A& a, const B& b) {
+        using namespace expression_detail;
+        return BinaryExpression<expression_ops::Multiply, ExpressionOf<A>, ExpressionOf<B>>(toExpression(a), toExpression(b));
+    }
+
+    template <typename A, typename B, typename = expression_detail::EnableIfOperands<A, B>>
+    auto elementwiseDivide(const A& a, const B& b) {
+        using namespace expression_detail;
+        return BinaryExpression<expression_ops::Divide, ExpressionOf<A>, ExpressionOf<B>>(toExpression(a), toExpression(b));
+    }
+
+    // fn(x) applied to every element; fn should be a cheap, inlinable callable (e.g. a lambda)
+    template <typename A, typename Fn, typename = expression_detail::EnableIfOperand<A>>
+    auto map(const A& a, Fn fn) {
+        using namespace expression_detail;
+        return UnaryExpression<Fn, ExpressionOf<A>>(toExpression(a), fn);
+    }
+
+    // fn(x, y) applied to matching elements of a and b
+    template <typename A, typename B, typename Fn, typename = expression_detail::EnableIfOperands<A, B>>
+    auto zipWith(const A& a, const B& b, Fn fn) {
+        using namespace expression_detail;
+        return BinaryExpression<Fn, ExpressionOf<A>, ExpressionOf<B>>(toExpression(a), toExpression(b), fn);
+    }
+
+    // --- Evaluation ---
+
+    // One pass, row by row; the inner loop is a flat, vectorisable run over columns
+    template <typename E>
+    void evaluateInto(const MatrixExpression<E>& expression, DenseMatrixView dst) {
+        const E& e = expression.derived();
+        if (dst.rows() != e.rows() || dst.cols() != e.cols()) {
+            throw std::invalid_argument("Expression result is " + std::to_string(e.rows()) + "x" +
+                                        std::to_string(e.cols()) + " but the destination is " +
+                                        std::to_string(dst.rows()) + "x" + std::to_string(dst.cols()) + ".");
+        }
+        const int rows = e.rows();
+        const int cols = e.cols();
+        for (int r = 0; r < rows; ++r) {
+            double* out = dst.row(r);
+            for (int c = 0; c < cols; ++c) out[c] = e(r, c);
+        }
+    }
+
+    template <typename E>
+    DenseMatrix evaluate(const MatrixExpression<E>& expression) {
+        return DenseMatrix(expression);
+    }
+
+    template <typename E>
+    DenseMatrix::DenseMatrix(const MatrixExpression<E>& expression)
+        : DenseMatrix(expression.rows(), expression.cols()) {
+        evaluateInto(expression, view());
+    }
+
+    template <typename E>
+    DenseMatrix& DenseMatrix::operator=(const MatrixExpression<E>& expression) {
+        if (rows_ == expression.rows() && cols_ == expression.cols()) {
+            evaluateInto(expression, view()); // Reuse storage; safe even if *this is an operand
+        } else {
+            DenseMatrix fresh(expression);
+            swap(fresh);
+        }
+        return *this;
+    }
+
+} // namespace MatrixUtils
+
+#endif // MATRIX_EXPRESSION_H
@@ -0,0 +1,514 @@
+// File: matrix_file.cc
+#include "matrix_file.h"
+#include "matrix_transpose.h"
+#include <algorithm> // For std::min
+#include <cerrno>
+#include <climits>   // For INT_MAX
+#include <cstring>   // For std::memcpy, std::strerror
+#include <stdexcept>
+#include <utility>   // For std::move
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace MatrixUtils {
+
+    namespace {
+
+        constexpr char MATRIX_FILE_MAGIC[8] = {'N', 'M', 'A', 'T', 'R', 'I', 'X', '\0'};
+        constexpr uint32_t BYTE_ORDER_MARK = 0x01020304u;
+        constexpr size_t WRITE_BUFFER_BYTES = size_t(4) << 20;
+        constexpr size_t READ_CHUNK_BYTES = size_t(64) << 20; // Also bounds the conversion scratch buffer
+
+        [[noreturn]] void throwIoError(const std::string& what, const std::string& path) {
+            throw std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+        }
+
+        size_t elementBytes(MatrixFileDType dtype) {
+            return dtype == MatrixFileDType::Float32 ? sizeof(float) : sizeof(double);
+        }
+
+        // Lines (rows, or columns when column-major) are padded to 64 bytes, like DenseMatrix rows
+        size_t fileStride(size_t length, MatrixFileDType dtype) {
+            size_t per_line = DENSE_ALIGNMENT_BYTES / elementBytes(dtype);
+            return (length + per_line - 1) / per_line * per_line;
+        }
+
+        void encodeHeader(const MatrixFileInfo& info, char* out) {
+            std::memset(out, 0, MATRIX_FILE_HEADER_BYTES);
+            uint32_t version = MATRIX_FILE_VERSION;
+            uint32_t bom = BYTE_ORDER_MARK;
+            uint32_t dtype = static_cast<uint32_t>(info.dtype);
+            uint32_t layout = static_cast<uint32_t>(info.layout);
+            uint64_t rows = static_cast<uint64_t>(info.rows);
+            uint64_t cols = static_cast<uint64_t>(info.cols);
+            uint64_t stride = info.stride;
+            uint64_t offset = info.payload_offset;
+            std::memcpy(out, MATRIX_FILE_MAGIC, 8);
+            std::memcpy(out + 8, &version, 4);
+            std::memcpy(out + 12, &bom, 4);
+            std::memcpy(out + 16, &dtype, 4);
+            std::memcpy(out + 20, &layout, 4);
+            std::memcpy(out + 24, &rows, 8);
+            std::memcpy(out + 32, &cols, 8);
+            std::memcpy(out + 40, &stride, 8);
+            std::memcpy(out + 48, &offset, 8);
+        }
+
+        // Validates everything the header claims against the actual file size
+        MatrixFileInfo decodeHeader(const char* in, size_t file_bytes, const std::string& path) {
+            auto fail = [&](const std::string& why) -> std::runtime_error {
+                return std::runtime_error("Invalid matrix file '" + path + "': " + why);
+            };
+            if (file_bytes < MATRIX_FILE_HEADER_BYTES || std::memcmp(in, MATRIX_FILE_MAGIC, 8) != 0) {
+                throw fail("missing NMATRIX header.");
+            }
+            uint32_t version, bom, dtype, layout;
+            uint64_t rows, cols, stride, offset;
+            std::memcpy(&version, in + 8, 4);
+            std::memcpy(&bom, in + 12, 4);
+            std::memcpy(&dtype, in + 16, 4);
+            std::memcpy(&layout, in + 20, 4);
+            std::memcpy(&rows, in + 24, 8);
+            std::memcpy(&cols, in + 32, 8);
+            std::memcpy(&stride, in + 40, 8);
+            std::memcpy(&offset, in + 48, 8);
+
+            if (version != MATRIX_FILE_VERSION) throw fail("unsupported version " + std::to_string(version) + ".");
+            if (bom != BYTE_ORDER_MARK) throw fail("written with a different byte order.");
+            if (dtype != static_cast<uint32_t>(MatrixFileDType::Float64) &&
+                dtype != static_cast<uint32_t>(MatrixFileDType::Float32)) {
+                throw fail("unknown element type " + std::to_string(dtype) + ".");
+            }
+            if (layout > static_cast<uint32_t>(MatrixFileLayout::ColumnMajor)) {
+                throw fail("unknown layout " + std::to_string(layout) + ".");
+            }
+            if (rows > static_cast<uint64_t>(INT_MAX) || cols > static_cast<uint64_t>(INT_MAX)) {
+                throw fail("dimensions exceed the supported range.");
+            }
+
+            MatrixFileInfo info;
+            info.rows = static_cast<int>(rows);
+            info.cols = static_cast<int>(cols);
+            info.stride = static_cast<size_t>(stride);
+            info.dtype = static_cast<MatrixFileDType>(dtype);
+            info.layout = static_cast<MatrixFileLayout>(layout);
+            info.payload_offset = static_cast<size_t>(offset);
+
+            bool row_major = info.layout == MatrixFileLayout::RowMajor;
+            uint64_t lines = row_major ? rows : cols;
+            uint64_t length = row_major ? cols : rows;
+            if (stride < length) throw fail("stride is smaller than a row.");
+            if (offset < MATRIX_FILE_HEADER_BYTES || offset % DENSE_ALIGNMENT_BYTES != 0) {
+                throw fail("payload offset is not 64-byte aligned.");
+            }
+            // Rows/cols are at most INT_MAX, so only the stride product can overflow
+            if (lines != 0 && stride > (UINT64_MAX / elementBytes(info.dtype)) / lines) {
+                throw fail("payload size overflows.");
+            }
+            info.payload_bytes = static_cast<size_t>(lines * stride * elementBytes(info.dtype));
+            if (file_bytes < info.payload_offset || file_bytes - info.payload_offset < info.payload_bytes) {
+                throw fail("file is truncated (" + std::to_string(file_bytes) + " bytes).");
+            }
+            return info;
+        }
+
+        void writeAll(int fd, const char* data, size_t count, const std::string& path) {
+            while (count > 0) {
+                ssize_t n = ::write(fd, data, count);
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    throwIoError("Failed to write", path);
+                }
+                data += n;
+                count -= static_cast<size_t>(n);
+            }
+        }
+
+        void writeAllAt(int fd, const char* data, size_t count, size_t offset, const std::string& path) {
+            while (count > 0) {
+                ssize_t n = ::pwrite(fd, data, count, static_cast<off_t>(offset));
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    throwIoError("Failed to write", path);
+                }
+                data += n;
+                count -= static_cast<size_t>(n);
+                offset += static_cast<size_t>(n);
+            }
+        }
+
+        void readAllAt(int fd, char* data, size_t count, size_t offset, const std::string& path) {
+            while (count > 0) {
+                ssize_t n = ::pread(fd, data, count, static_cast<off_t>(offset));
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    throwIoError("Failed to read", path);
+                }
+                if (n == 0) {
+                    throw std::runtime_error("Unexpected end of matrix file '" + path + "'.");
+                }
+                data += n;
+                count -= static_cast<size_t>(n);
+                offset += static_cast<size_t>(n);
+            }
+        }
+
+        // Owns a descriptor for the duration of a read
+        struct FileDescriptor {
+            int fd;
+            ~FileDescriptor() { if (fd >= 0) ::close(fd); }
+        };
+
+        MatrixFileInfo readInfo(int fd, const std::string& path) {
+            struct stat st;
+            if (::fstat(fd, &st) != 0) throwIoError("Cannot stat", path);
+            char header[MATRIX_FILE_HEADER_BYTES] = {};
+            size_t file_bytes = static_cast<size_t>(st.st_size);
+            if (file_bytes >= MATRIX_FILE_HEADER_BYTES) readAllAt(fd, header, sizeof(header), 0, path);
+            return decodeHeader(header, file_bytes, path);
+        }
+
+        // Reads the stored lines into dst (lines x length). Float64 lines whose stride matches
+        // dst's are read straight into place; anything else goes through a bounded scratch buffer.
+        void readPayload(int fd, const MatrixFileInfo& info, DenseMatrixView dst, const std::string& path) {
+            const size_t elem = elementBytes(info.dtype);
+            const size_t line_bytes = info.stride * elem;
+            const int lines = dst.rows();
+            const int length = dst.cols();
+            if (lines == 0 || length == 0) return;
+
+            if (info.dtype == MatrixFileDType::Float64 && info.stride == dst.stride()) {
+                readAllAt(fd, reinterpret_cast<char*>(dst.data()), info.payload_bytes, info.payload_offset, path);
+                return;
+            }
+            int lines_per_chunk = static_cast<int>(std::max<size_t>(1, READ_CHUNK_BYTES / line_bytes));
+            std::vector<char> scratch(static_cast<size_t>(std::min(lines_per_chunk, lines)) * line_bytes);
+            for (int first = 0; first < lines; first += lines_per_chunk) {
+                int count = std::min(lines_per_chunk, lines - first);
+                readAllAt(fd, scratch.data(), static_cast<size_t>(count) * line_bytes,
+                          info.payload_offset + static_cast<size_t>(first) * line_bytes, path);
+                for (int i = 0; i < count; ++i) {
+                    const char* src = scratch.data() + static_cast<size_t>(i) * line_bytes;
+                    double* out = dst.row(first + i);
+                    if (info.dtype == MatrixFileDType::Float32) {
+                        const float* f = reinterpret_cast<const float*>(src);
+                        for (int j = 0; j < length; ++j) out[j] = static_cast<double>(f[j]);
+                    } else {
+                        std::memcpy(out, src, static_cast<size_t>(length) * sizeof(double));
+                    }
+                }
+            }
+        }
+
+    } // namespace
+
+    MatrixFileInfo readMatrixFileInfo(const std::string& path) {
+        FileDescriptor file{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+        if (file.fd < 0) throwIoError("Cannot open matrix file", path);
+        return readInfo(file.fd, path);
+    }
+
+    // --- Streaming writer ---
+
+    MatrixFileWriter::MatrixFileWriter(const std::string& path, int cols, MatrixFileDType dtype)
+        : path_(path), cols_(cols), dtype_(dtype) {
+        if (cols < 0) {
+            throw std::invalid_argument("Matrix file column count cannot be negative.");
+        }
+        if (dtype != MatrixFileDType::Float64 && dtype != MatrixFileDType::Float32) {
+            throw std::invalid_argument("Unknown matrix file element type.");
+        }
+        row_bytes_ = fileStride(static_cast<size_t>(cols), dtype) * elementBytes(dtype);
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd_ < 0) throwIoError("Cannot create matrix file", path);
+        buffer_.resize(WRITE_BUFFER_BYTES);
+        row_scratch_.assign(row_bytes_, 0);
+
+        // Placeholder header; close() rewrites it with the final row count
+        char header[MATRIX_FILE_HEADER_BYTES];
+        MatrixFileInfo info;
+        info.cols = cols;
+        info.dtype = dtype;
+        info.stride = fileStride(static_cast<size_t>(cols), dtype);
+        encodeHeader(info, header);
+        append(header, sizeof(header));
+    }
+
+    MatrixFileWriter::~MatrixFileWriter() {
+        if (fd_ < 0) return;
+        try {
+            close();
+        } catch (...) {
+            // Destructors must not throw; call close() explicitly to see write errors
+        }
+        if (fd_ >= 0) ::close(fd_);
+    }
+
+    void MatrixFileWriter::append(const void* bytes, size_t count) {
+        const char* src = static_cast<const char*>(bytes);
+        if (buffered_ == 0 && count >= buffer_.size()) {
+            writeAll(fd_, src, count, path_); // Large blocks skip the copy
+            return;
+        }
+        while (count > 0) {
+            size_t take = std::min(count, buffer_.size() - buffered_);
+            std::memcpy(buffer_.data() + buffered_, src, take);
+            buffered_ += take;
+            src += take;
+            count -= take;
+            if (buffered_ == buffer_.size()) flushBuffer();
+        }
+    }
+
+    void MatrixFileWriter::flushBuffer() {
+        writeAll(fd_, buffer_.data(), buffered_, path_);
+        buffered_ = 0;
+    }
+
+    void MatrixFileWriter::writeRow(const double* values) {
+        if (fd_ < 0) {
+            throw std::logic_error("MatrixFileWriter is already closed.");
+        }
+        if (rows_written_ == INT_MAX) {
+            throw std::length_error("Matrix file row count exceeds the supported range.");
+        }
+        const size_t value_bytes = static_cast<size_t>(cols_) * elementBytes(dtype_);
+        if (dtype_ == MatrixFileDType::Float32) {
+            float* out = reinterpret_cast<float*>(row_scratch_.data());
+            for (int j = 0; j < cols_; ++j) out[j] = static_cast<float>(values[j]);
+            append(row_scratch_.data(), row_bytes_); // Padding tail of the scratch row stays zero
+        } else {
+            append(values, value_bytes);
+            append(row_scratch_.data(), row_bytes_ - value_bytes);
+        }
+        ++rows_written_;
+    }
+
+    void MatrixFileWriter::writeRows(ConstDenseMatrixView rows) {
+        if (rows.cols() != cols_ && rows.rows() > 0) {
+            throw std::invalid_argument("Row block has " + std::to_string(rows.cols()) + " columns; the file has " +
+                                        std::to_string(cols_) + ".");
+        }
+        // A float64 block whose rows need no padding (cols a multiple of eight) is
+        // already the on-disk image. Padded views go row by row: their padding may hold fill
+        // values or, in a block of a wider matrix, the neighbouring columns, and the last
+        // row's padding can lie past the end of the allocation.
+        if (dtype_ == MatrixFileDType::Float64 && rows.stride() == static_cast<size_t>(cols_) &&
+            rows.stride() * sizeof(double) == row_bytes_ && rows_written_ + rows.rows() <= INT_MAX && fd_ >= 0) {
+            append(rows.data(), static_cast<size_t>(rows.rows()) * row_bytes_);
+            rows_written_ += rows.rows();
+            return;
+        }
+        for (int r = 0; r < rows.rows(); ++r) writeRow(rows.row(r));
+    }
+
+    void MatrixFileWriter::close() {
+        if (fd_ < 0) return;
+        flushBuffer();
+        MatrixFileInfo info;
+        info.rows = static_cast<int>(rows_written_);
+        info.cols = cols_;
+        info.dtype = dtype_;
+        info.stride = fileStride(static_cast<size_t>(cols_), dtype_);
+        char header[MATRIX_FILE_HEADER_BYTES];
+        encodeHeader(info, header);
+        writeAllAt(fd_, header, sizeof(header), 0, path_);
+        int fd = fd_;
+        fd_ = -1;
+        if (::close(fd) != 0) throwIoError("Failed to close", path_);
+    }
+
+    void writeMatrixFile(const std::string& path, ConstDenseMatrixView matrix, MatrixFileDType dtype,
+                         MatrixFileLayout layout) {
+        if (layout == MatrixFileLayout::RowMajor) {
+            MatrixFileWriter writer(path, matrix.cols(), dtype);
+            writer.writeRows(matrix);
+            writer.close();
+            return;
+        }
+        // Column-major: the stored lines are the transpose's rows; only the header differs
+        DenseMatrix transposed(matrix.cols(), matrix.rows());
+        transposeInto(matrix, transposed);
+        {
+            MatrixFileWriter writer(path, transposed.cols(), dtype);
+            writer.writeRows(transposed);
+            writer.close();
+        }
+        MatrixFileInfo info;
+        info.rows = matrix.rows();
+        info.cols = matrix.cols();
+        info.dtype = dtype;
+        info.layout = MatrixFileLayout::ColumnMajor;
+        info.stride = fileStride(static_cast<size_t>(matrix.rows()), dtype);
+        char header[MATRIX_FILE_HEADER_BYTES];
+        encodeHeader(info, header);
+        FileDescriptor file{::open(path.c_str(), O_WRONLY | O_CLOEXEC)};
+        if (file.fd < 0) throwIoError("Cannot reopen matrix file", path);
+        writeAllAt(file.fd, header, sizeof(header), 0, path);
+    }
+
+    DenseMatrix loadMatrixFile(const std::string& path) {
+        FileDescriptor file{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+        if (file.fd < 0) throwIoError("Cannot open matrix file", path);
+        MatrixFileInfo info = readInfo(file.fd, path);
+        if (info.layout == MatrixFileLayout::RowMajor) {
+            DenseMatrix result(info.rows, info.cols);
+            readPayload(file.fd, info, result, path);
+            return result;
+        }
+        DenseMatrix stored(info.cols, info.rows);
+        readPayload(file.fd, info, stored, path);
+        DenseMatrix result(info.rows, info.cols);
+        transposeInto(stored, result);
+        return result;
+    }
+
+    void createMatrixFile(const std::string& path, int rows, int cols) {
+        if (rows < 0 || cols < 0) {
+            throw std::invalid_argument("Matrix file dimensions cannot be negative.");
+        }
+        MatrixFileInfo info;
+        info.rows = rows;
+        info.cols = cols;
+        info.stride = fileStride(static_cast<size_t>(cols), MatrixFileDType::Float64);
+        char header[MATRIX_FILE_HEADER_BYTES];
+        encodeHeader(info, header);
+        FileDescriptor file{::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)};
+        if (file.fd < 0) throwIoError("Cannot create matrix file", path);
+        writeAllAt(file.fd, header, sizeof(header), 0, path);
+        off_t total = static_cast<off_t>(info.payload_offset + static_cast<size_t>(rows) * info.stride * sizeof(double));
+        if (::ftruncate(file.fd, total) != 0) throwIoError("Cannot size matrix file", path);
+    }
+
+    // --- Block access ---
+
+    MatrixFileBlockIO::MatrixFileBlockIO(const std::string& path, bool writable) : path_(path), writable_(writable) {
+        fd_ = ::open(path.c_str(), (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+        if (fd_ < 0) throwIoError("Cannot open matrix file", path);
+        try {
+            info_ = readInfo(fd_, path);
+        } catch (...) {
+            ::close(fd_);
+            throw;
+        }
+        if (info_.layout != MatrixFileLayout::RowMajor) {
+            ::close(fd_);
+            throw std::invalid_argument("Block access needs a row-major matrix file: '" + path + "'.");
+        }
+        if (writable && info_.dtype != MatrixFileDType::Float64) {
+            ::close(fd_);
+            throw std::invalid_argument("Block writes need a float64 matrix file: '" + path + "'.");
+        }
+    }
+
+    MatrixFileBlockIO::~MatrixFileBlockIO() {
+        if (fd_ >= 0) ::close(fd_);
+    }
+
+    void MatrixFileBlockIO::checkBlock(int r0, int c0, int rows, int cols) const {
+        if (r0 < 0 || c0 < 0 || rows < 0 || cols < 0 || r0 > info_.rows - rows || c0 > info_.cols - cols) {
+            throw std::out_of_range("Block " + std::to_string(rows) + "x" + std::to_string(cols) + " at (" +
+                                    std::to_string(r0) + ", " + std::to_string(c0) + ") lies outside the " +
+                                    std::to_string(info_.rows) + "x" + std::to_string(info_.cols) + " matrix file.");
+        }
+    }
+
+    void MatrixFileBlockIO::readBlock(int r0, int c0, DenseMatrixView dst) const {
+        checkBlock(r0, c0, dst.rows(), dst.cols());
+        const size_t elem = elementBytes(info_.dtype);
+        const size_t line_bytes = info_.stride * elem;
+        const size_t segment_bytes = static_cast<size_t>(dst.cols()) * elem;
+        std::vector<float> scratch(info_.dtype == MatrixFileDType::Float32 ? dst.cols() : 0);
+        for (int r = 0; r < dst.rows(); ++r) {
+            size_t offset = info_.payload_offset + static_cast<size_t>(r0 + r) * line_bytes + static_cast<size_t>(c0) * elem;
+            if (info_.dtype == MatrixFileDType::Float64) {
+                readAllAt(fd_, reinterpret_cast<char*>(dst.row(r)), segment_bytes, offset, path_);
+            } else {
+                readAllAt(fd_, reinterpret_cast<char*>(scratch.data()), segment_bytes, offset, path_);
+                double* out = dst.row(r);
+                for (int j = 0; j < dst.cols(); ++j) out[j] = static_cast<double>(scratch[j]);
+            }
+        }
+    }
+
+    void MatrixFileBlockIO::writeBlock(int r0, int c0, ConstDenseMatrixView src) {
+        if (!writable_) {
+            throw std::logic_error("Matrix file '" + path_ + "' was opened read-only.");
+        }
+        checkBlock(r0, c0, src.rows(), src.cols());
+        const size_t line_bytes = info_.stride * sizeof(double);
+        for (int r = 0; r < src.rows(); ++r) {
+            size_t offset = info_.payload_offset + static_cast<size_t>(r0 + r) * line_bytes + static_cast<size_t>(c0) * sizeof(double);
+            writeAllAt(fd_, reinterpret_cast<const char*>(src.row(r)), static_cast<size_t>(src.cols()) * sizeof(double),
+                       offset, path_);
+        }
+    }
+
+    // --- Memory mapping ---
+
+    MappedMatrixFile::MappedMatrixFile(const std::string& path, bool writable) : writable_(writable) {
+        FileDescriptor file{::open(path.c_str(), (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC)};
+        if (file.fd < 0) throwIoError("Cannot open matrix file", path);
+        info_ = readInfo(file.fd, path);
+        mapping_bytes_ = info_.payload_offset + info_.payload_bytes;
+        void* p = ::mmap(nullptr, mapping_bytes_, PROT_READ | (writable ? PROT_WRITE : 0), MAP_SHARED, file.fd, 0);
+        if (p == MAP_FAILED) throwIoError("Cannot map matrix file", path);
+        mapping_ = p; // The mapping stays valid after the descriptor is closed
+    }
+
+    MappedMatrixFile::~MappedMatrixFile() {
+        release();
+    }
+
+    MappedMatrixFile::MappedMatrixFile(MappedMatrixFile&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedMatrixFile& MappedMatrixFile::operator=(MappedMatrixFile&& other) noexcept {
+        if (this != &other) {
+            release();
+            info_ = other.info_;
+            mapping_ = other.mapping_;
+            mapping_bytes_ = other.mapping_bytes_;
+            writable_ = other.writable_;
+            other.mapping_ = nullptr;
+            other.mapping_bytes_ = 0;
+        }
+        return *this;
+    }
+
+    void MappedMatrixFile::release() noexcept {
+        if (mapping_) ::munmap(mapping_, mapping_bytes_);
+        mapping_ = nullptr;
+        mapping_bytes_ = 0;
+    }
+
+    bool MappedMatrixFile::supportsView() const {
+        return isOpen() && info_.dtype == MatrixFileDType::Float64 && info_.layout == MatrixFileLayout::RowMajor;
+    }
+
+    ConstDenseMatrixView MappedMatrixFile::view() const {
+        if (!supportsView()) {
+            throw std::logic_error("Only open float64 row-major matrix files can be viewed in place; use loadMatrixFile.");
+        }
+        const char* payload = static_cast<const char*>(mapping_) + info_.payload_offset;
+        return ConstDenseMatrixView(reinterpret_cast<const double*>(payload), info_.rows, info_.cols, info_.stride);
+    }
+
+    DenseMatrixView MappedMatrixFile::mutableView() {
+        if (!writable_) {
+            throw std::logic_error("Matrix file was mapped read-only.");
+        }
+        ConstDenseMatrixView v = view();
+        return DenseMatrixView(const_cast<double*>(v.data()), v.rows(), v.cols(), v.stride());
+    }
+
+    void MappedMatrixFile::adviseSequential() const {
+        if (!mapping_) return;
+        ::madvise(mapping_, mapping_bytes_, MADV_SEQUENTIAL);
+        ::madvise(mapping_, mapping_bytes_, MADV_WILLNEED);
+    }
+
+} // namespace MatrixUtils
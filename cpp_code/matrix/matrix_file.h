@@ -0,0 +1,160 @@
+// File: matrix_file.h
+#ifndef MATRIX_FILE_H
+#define MATRIX_FILE_H
+
+#include "matrix_types.h"
+#include <cstddef> // For size_t
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MatrixUtils {
+
+    // --- Binary matrix files ---
+    // A fixed 64-byte little-endian header followed by the payload:
+    //
+    //   offset  size  field
+    //        0     8  magic "NMATRIX\0"
+    //        8     4  format version (MATRIX_FILE_VERSION)
+    //       12     4  byte-order mark 0x01020304, as written by the producer
+    //       16     4  element type (MatrixFileDType)
+    //       20     4  layout (MatrixFileLayout)
+    //       24     8  rows
+    //       32     8  cols
+    //       40     8  stride in elements between consecutive rows (or columns, if column-major)
+    //       48     8  payload offset in bytes (a multiple of 64)
+    //       56     8  reserved, zero
+    //
+    // The writer pads every row to the same stride DenseMatrix uses, so a mapped float64
+    // row-major file has exactly DenseMatrix's in-memory shape: rows start on 64-byte
+    // boundaries, and the payload can be used in place without copying. Readers ignore
+    // the padding bytes.
+
+    constexpr uint32_t MATRIX_FILE_VERSION = 1;
+    constexpr size_t MATRIX_FILE_HEADER_BYTES = 64;
+
+    enum class MatrixFileDType : uint32_t { Float64 = 1, Float32 = 2 };
+    enum class MatrixFileLayout : uint32_t { RowMajor = 0, ColumnMajor = 1 };
+
+    struct MatrixFileInfo {
+        int rows = 0;
+        int cols = 0;
+        size_t stride = 0; // Elements between the starts of consecutive rows (columns when column-major)
+        MatrixFileDType dtype = MatrixFileDType::Float64;
+        MatrixFileLayout layout = MatrixFileLayout::RowMajor;
+        size_t payload_offset = MATRIX_FILE_HEADER_BYTES;
+        size_t payload_bytes = 0;
+    };
+
+    // Reads and validates just the header; throws std::runtime_error on I/O errors or a
+    // malformed, truncated or foreign-endian file.
+    MatrixFileInfo readMatrixFileInfo(const std::string& path);
+
+    // Streaming writer. Rows are buffered and written sequentially, so a matrix of any size
+    // can be produced one row (or one block of rows) at a time without holding it in memory.
+    // The row count does not have to be known up front: it is patched into the header by
+    // close(). Float32 files store each value rounded to float.
+    class MatrixFileWriter {
+    public:
+        MatrixFileWriter(const std::string& path, int cols, MatrixFileDType dtype = MatrixFileDType::Float64);
+        ~MatrixFileWriter(); // Closes if close() was not called; errors are swallowed there
+        MatrixFileWriter(const MatrixFileWriter&) = delete;
+        MatrixFileWriter& operator=(const MatrixFileWriter&) = delete;
+
+        void writeRow(const double* values); // cols() values
+        void writeRows(ConstDenseMatrixView rows); // rows.cols() must equal cols()
+        void close(); // Flushes, writes the final row count and closes; throws on I/O errors
+
+        int cols() const { return cols_; }
+        long long rowsWritten() const { return rows_written_; }
+
+    private:
+        void append(const void* bytes, size_t count);
+        void flushBuffer();
+
+        std::string path_;
+        int fd_ = -1;
+        int cols_ = 0;
+        MatrixFileDType dtype_;
+        size_t row_bytes_ = 0; // Padded, on disk
+        long long rows_written_ = 0;
+        std::vector<char> buffer_;
+        size_t buffered_ = 0;
+        std::vector<char> row_scratch_;
+    };
+
+    // Writes a whole matrix in one call. Column-major output stores the transpose's rows.
+    void writeMatrixFile(const std::string& path, ConstDenseMatrixView matrix,
+                         MatrixFileDType dtype = MatrixFileDType::Float64,
+                         MatrixFileLayout layout = MatrixFileLayout::RowMajor);
+
+    // Reads a file into a new DenseMatrix, converting float32 and column-major payloads.
+    DenseMatrix loadMatrixFile(const std::string& path);
+
+    // Creates a float64 row-major rows x cols file of zeros. The payload is allocated with
+    // ftruncate, so it costs no I/O (and, on most filesystems, no disk) until written.
+    void createMatrixFile(const std::string& path, int rows, int cols);
+
+    // Random access to rectangular blocks of a row-major file through pread/pwrite, for
+    // callers that stream tiles with their own buffers rather than mapping the whole file.
+    // Reads convert float32 payloads; writes need a float64 file. Concurrent calls on
+    // distinct blocks are safe.
+    class MatrixFileBlockIO {
+    public:
+        explicit MatrixFileBlockIO(const std::string& path, bool writable = false);
+        ~MatrixFileBlockIO();
+        MatrixFileBlockIO(const MatrixFileBlockIO&) = delete;
+        MatrixFileBlockIO& operator=(const MatrixFileBlockIO&) = delete;
+
+        const MatrixFileInfo& info() const { return info_; }
+
+        // Copies the dst.rows() x dst.cols() block whose top-left element is (r0, c0)
+        void readBlock(int r0, int c0, DenseMatrixView dst) const;
+        void writeBlock(int r0, int c0, ConstDenseMatrixView src);
+
+    private:
+        void checkBlock(int r0, int c0, int rows, int cols) const;
+
+        std::string path_;
+        int fd_ = -1;
+        bool writable_ = false;
+        MatrixFileInfo info_;
+    };
+
+    // Memory-mapped file. For a float64 row-major file, view() points straight into the
+    // mapping, so any MatrixUtils function taking a ConstDenseMatrixView works on it
+    // with no copy. Pages are read in lazily by the kernel as they are touched. Other
+    // dtypes or layouts can still be mapped, but they have to go through loadMatrixFile.
+    class MappedMatrixFile {
+    public:
+        MappedMatrixFile() = default;
+        // writable maps the payload shared, so stores through mutableView() reach the file
+        explicit MappedMatrixFile(const std::string& path, bool writable = false);
+        ~MappedMatrixFile();
+        MappedMatrixFile(MappedMatrixFile&& other) noexcept;
+        MappedMatrixFile& operator=(MappedMatrixFile&& other) noexcept;
+        MappedMatrixFile(const MappedMatrixFile&) = delete;
+        MappedMatrixFile& operator=(const MappedMatrixFile&) = delete;
+
+        const MatrixFileInfo& info() const { return info_; }
+        bool isOpen() const { return mapping_ != nullptr; }
+        bool supportsView() const; // float64 and row-major
+
+        ConstDenseMatrixView view() const; // Throws std::logic_error unless supportsView()
+        DenseMatrixView mutableView();     // Additionally requires a writable mapping
+
+        // Hints that the whole payload is about to be read front to back
+        void adviseSequential() const;
+
+    private:
+        void release() noexcept;
+
+        MatrixFileInfo info_;
+        void* mapping_ = nullptr;
+        size_t mapping_bytes_ = 0;
+        bool writable_ = false;
+    };
+
+} // namespace MatrixUtils
+
+#endif // MATRIX_FILE_H
@@ -0,0 +1,194 @@
+// File: matrix_functions.cc
+#include "matrix_functions.h"
+#include "matrix_utils.h"
+#include "matrix_backend.h"
+#include <algorithm> // For std::max
+#include <cmath>     // For std::fabs, std::ceil, std::log2, std::ldexp, std::isfinite, std::isnan
+#include <stdexcept>
+#include <vector>
+
+namespace MatrixUtils {
+
+    namespace {
+
+        // Largest ||A||_1 for which the [m/m] Pade approximant meets double precision
+        // (Higham 2005, Table 2.3)
+        constexpr double PADE_THETA_3 = 1.495585217958292e-2;
+        constexpr double PADE_THETA_5 = 2.539398330063230e-1;
+        constexpr double PADE_THETA_7 = 9.504178996162932e-1;
+        constexpr double PADE_THETA_9 = 2.097847961257068e0;
+        constexpr double PADE_THETA_13 = 5.371920351148152e0;
+
+        // Pade numerator coefficients b_0..b_m; the denominator is the same with odd terms negated
+        constexpr double PADE_3[] = {120.0, 60.0, 12.0, 1.0};
+        constexpr double PADE_5[] = {30240.0, 15120.0, 3360.0, 420.0, 30.0, 1.0};
+        constexpr double PADE_7[] = {17297280.0, 8648640.0, 1995840.0, 277200.0, 25200.0, 1512.0, 56.0, 1.0};
+        constexpr double PADE_9[] = {17643225600.0, 8821612800.0, 2075673600.0, 302702400.0, 30270240.0,
+                                     2162160.0, 110880.0, 3960.0, 90.0, 1.0};
+        constexpr double PADE_13[] = {64764752532480000.0, 32382376266240000.0, 7771770303897600.0,
+                                      1187353796428800.0, 129060195264000.0, 10559470521600.0,
+                                      670442572800.0, 33522128640.0, 1323241920.0, 40840800.0,
+                                      960960.0, 16380.0, 182.0, 1.0};
+
+        double norm1(ConstDenseMatrixView a) {
+            std::vector<double> column_sums(a.cols(), 0.0);
+            for (int i = 0; i < a.rows(); ++i) {
+                const double* row = a.row(i);
+                for (int j = 0; j < a.cols(); ++j) column_sums[j] += std::fabs(row[j]);
+            }
+            double result = 0.0;
+            for (double sum : column_sums) {
+                if (std::isnan(sum)) return sum; // std::max would skip it; the caller rejects it
+                result = std::max(result, sum);
+            }
+            return result;
+        }
+
+        void addToDiagonal(DenseMatrix& a, double value) {
+            for (int i = 0; i < a.rows(); ++i) a(i, i) += value;
+        }
+
+        // u and v with r_m(A) = (v - u)^-1 (v + u) for m in {3, 5, 7, 9}: v collects the even
+        // powers, u = A times the odd ones
+        void padeLowOrder(const DenseMatrix& a, const double* b, int m, DenseMatrix& u, DenseMatrix& v) {
+            const MatrixBackend& backend = activeMatrixBackend();
+            const int n = a.rows();
+            DenseMatrix square(n, n);
+            backend.gemm(1.0, a, a, 0.0, square);
+            DenseMatrix power = square; // A^2j
+            DenseMatrix next(n, n);
+            DenseMatrix odd = b[3] * square;
+            v = b[2] * square;
+            for (int j = 2; 2 * j <= m; ++j) {
+                backend.gemm(1.0, power, square, 0.0, next);
+                power.swap(next);
+                odd = odd + b[2 * j + 1] * power;
+                v = v + b[2 * j] * power;
+            }
+            addToDiagonal(odd, b[1]);
+            addToDiagonal(v, b[0]);
+            backend.gemm(1.0, a, odd, 0.0, u);
+        }
+
+        // The same for m = 13 with six multiplies, grouping the powers as A^6 * (...) + (...)
+        void padeOrder13(const DenseMatrix& a, DenseMatrix& u, DenseMatrix& v) {
+            const MatrixBackend& backend = activeMatrixBackend();
+            const double* b = PADE_13;
+            const int n = a.rows();
+            DenseMatrix a2(n, n), a4(n, n), a6(n, n);
+            backend.gemm(1.0, a, a, 0.0, a2);
+            backend.gemm(1.0, a2, a2, 0.0, a4);
+            backend.gemm(1.0, a4, a2, 0.0, a6);
+
+            DenseMatrix high = b[13] * a6 + b[11] * a4 + b[9] * a2;
+            DenseMatrix odd = b[7] * a6 + b[5] * a4 + b[3] * a2;
+            addToDiagonal(odd, b[1]);
+            backend.gemm(1.0, a6, high, 1.0, odd);
+            backend.gemm(1.0, a, odd, 0.0, u);
+
+            high = b[12] * a6 + b[10] * a4 + b[8] * a2;
+            v = b[6] * a6 + b[4] * a4 + b[2] * a2;
+            addToDiagonal(v, b[0]);
+            backend.gemm(1.0, a6, high, 1.0, v);
+        }
+
+    } // namespace
+
+    DenseMatrix matrixPower(ConstDenseMatrixView matrix, long long exponent) {
+        int n;
+        if (!isSquareMatrix(matrix, n)) {
+            throw std::invalid_argument("Matrix power requires a square matrix.");
+        }
+        if (exponent == 0) return DenseMatrix::identity(n);
+
+        DenseMatrix base;
+        unsigned long long k;
+        if (exponent < 0) {
+            LUDecomposition lu = luDecompose(matrix);
+            if (!lu.invertible()) {
+                throw std::domain_error("Matrix is singular; negative powers do not exist.");
+            }
+            base = lu.inverse();
+            k = 0ULL - static_cast<unsigned long long>(exponent); // |LLONG_MIN| without overflow
+        } else {
+            base = DenseMatrix::fromView(matrix);
+            k = static_cast<unsigned long long>(exponent);
+        }
+
+        // Left-to-right binary method: square for every bit below the leading one, and
+        // multiply by the base where that bit is set. Each product lands in `scratch` and
+        // the two buffers swap, so the loop never allocates.
+        const MatrixBackend& backend = activeMatrixBackend();
+        DenseMatrix result = base;
+        DenseMatrix scratch(n, n);
+        for (int bit = 62 - __builtin_clzll(k); bit >= 0; --bit) {
+            backend.gemm(1.0, result, result, 0.0, scratch);
+            result.swap(scratch);
+            if ((k >> bit) & 1ULL) {
+                backend.gemm(1.0, result, base, 0.0, scratch);
+                result.swap(scratch);
+            }
+        }
+        return result;
+    }
+
+    Matrix matrixPower(const Matrix& matrix, long long exponent) {
+        int n;
+        if (!isSquareMatrix(matrix, n)) {
+            throw std::invalid_argument("Matrix power requires a square matrix.");
+        }
+        return matrixPower(DenseMatrix(matrix), exponent).toMatrix();
+    }
+
+    DenseMatrix matrixExp(ConstDenseMatrixView matrix) {
+        int n;
+        if (!isSquareMatrix(matrix, n)) {
+            throw std::invalid_argument("Matrix exponential requires a square matrix.");
+        }
+        DenseMatrix a = DenseMatrix::fromView(matrix);
+        const double norm = norm1(a);
+        if (!std::isfinite(norm)) { // Any Inf or NaN entry makes its column sum, and so the norm, non-finite
+            throw std::invalid_argument("Matrix exponential requires finite entries.");
+        }
+
+        DenseMatrix u(n, n), v;
+        int squarings = 0;
+        if (norm <= PADE_THETA_3) {
+            padeLowOrder(a, PADE_3, 3, u, v);
+        } else if (norm <= PADE_THETA_5) {
+            padeLowOrder(a, PADE_5, 5, u, v);
+        } else if (norm <= PADE_THETA_7) {
+            padeLowOrder(a, PADE_7, 7, u, v);
+        } else if (norm <= PADE_THETA_9) {
+            padeLowOrder(a, PADE_9, 9, u, v);
+        } else {
+            squarings = std::max(0, static_cast<int>(std::ceil(std::log2(norm / PADE_THETA_13))));
+            if (squarings > 0) a = std::ldexp(1.0, -squarings) * a; // Exact: a power of two
+            padeOrder13(a, u, v);
+        }
+
+        // r = (v - u)^-1 (v + u); v - u is well conditioned for these norms (Higham, Sec. 2)
+        DenseMatrix denominator = v - u;
+        DenseMatrix result = v + u;
+        LUDecomposition lu = luDecompose(denominator);
+        lu.solveInPlace(result);
+
+        // exp(A) = r(A / 2^s)^(2^s), squaring between the result and a scratch buffer
+        const MatrixBackend& backend = activeMatrixBackend();
+        DenseMatrix& scratch = denominator;
+        for (int s = 0; s < squarings; ++s) {
+            backend.gemm(1.0, result, result, 0.0, scratch);
+            result.swap(scratch);
+        }
+        return result;
+    }
+
+    Matrix matrixExp(const Matrix& matrix) {
+        int n;
+        if (!isSquareMatrix(matrix, n)) {
+            throw std::invalid_argument("Matrix exponential requires a square matrix.");
+        }
+        return matrixExp(DenseMatrix(matrix)).toMatrix();
+    }
+
+} // namespace MatrixUtils
@@ -0,0 +1,26 @@
+// File: matrix_functions.h
+#ifndef MATRIX_FUNCTIONS_H
+#define MATRIX_FUNCTIONS_H
+
+#include "matrix_types.h"
+
+namespace MatrixUtils {
+
+    // A^k by binary exponentiation: floor(log2 k) squarings plus one multiply per further set
+    // bit of k, all through the active backend's GEMM. Products alternate between two
+    // preallocated buffers, so no matrix is allocated inside the loop. k = 0 gives I; a
+    // negative k raises A^-1 (throws std::domain_error if A is singular to working precision).
+    DenseMatrix matrixPower(ConstDenseMatrixView matrix, long long exponent);
+    Matrix matrixPower(const Matrix& matrix, long long exponent);
+
+    // exp(A) by scaling and squaring (Higham 2005): the [m/m] Pade approximant with the
+    // smallest m in {3, 5, 7, 9, 13} accurate for ||A||_1, and for m = 13 A is first scaled
+    // by 2^-s so that ||A / 2^s||_1 <= 5.37; the approximant is then squared s times in the
+    // same ping-pong buffers. Costs at most 6 multiplies, one LU solve and s squarings.
+    // Throws std::invalid_argument if any entry is infinite or NaN.
+    DenseMatrix matrixExp(ConstDenseMatrixView matrix);
+    Matrix matrixExp(const Matrix& matrix);
+
+} // namespace MatrixUtils
+
+#endif // MATRIX_FUNCTIONS_H
@@ -0,0 +1,266 @@
+// File: matrix_gemm.cc
+#include "matrix_gemm.h"
+#include "thread_pool.h"
+#include <stdexcept>
+#include <cmath>     // For std::fma
+#include <algorithm> // For std::min, std::max, std::fill
+#include <cstdlib>   // For std::free
+#include <memory>    // For std::unique_ptr
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define MATRIX_GEMM_AVX2 1
+#endif
+
+namespace MatrixUtils {
+
+    namespace {
+
+        GemmBlocking g_blocking;
+
+        // Below this many multiply-adds the packing overhead outweighs the blocked kernel
+        constexpr double GEMM_SMALL_WORK = 48.0 * 48.0 * 48.0;
+        // Below this many multiply-adds the product stays on the calling thread
+        constexpr double GEMM_PARALLEL_WORK = 160.0 * 160.0 * 160.0;
+        // Output tile handed to one pool task: GemmBlocking::mc rows by this many columns
+        constexpr int GEMM_TILE_COLS = 512;
+
+        struct AlignedFree {
+            void operator()(double* p) const { std::free(p); }
+        };
+
+        // Grow-only packing buffer; one per thread so concurrent products never share panels
+        struct PackBuffer {
+            std::unique_ptr<double[], AlignedFree> data;
+            size_t capacity = 0;
+
+            double* reserve(size_t count) {
+                if (count > capacity) {
+                    data.reset(allocateAlignedDoubles(count));
+                    capacity = count;
+                }
+                return data.get();
+            }
+        };
+
+        thread_local PackBuffer t_pack_a;
+        thread_local PackBuffer t_pack_b;
+
+        int roundUp(int value, int multiple) {
+            return (value + multiple - 1) / multiple * multiple;
+        }
+
+        // Packs an mb x kb block of A into MR-row slivers: for each k, MR consecutive values.
+        // Rows past mb are zero so the micro-kernel never needs an edge case on the read side.
+        void packA(ConstDenseMatrixView a, int row0, int col0, int mb, int kb, double* dst) {
+            for (int ir = 0; ir < mb; ir += GEMM_MR) {
+                int rows = std::min(GEMM_MR, mb - ir);
+                for (int p = 0; p < kb; ++p) {
+                    for (int i = 0; i < rows; ++i) {
+                        dst[i] = a(row0 + ir + i, col0 + p);
+                    }
+                    for (int i = rows; i < GEMM_MR; ++i) {
+                        dst[i] = 0.0;
+                    }
+                    dst += GEMM_MR;
+                }
+            }
+        }
+
+        // Packs a kb x nb block of B into NR-column slivers: for each k, NR consecutive values.
+        void packB(ConstDenseMatrixView b, int row0, int col0, int kb, int nb, double* dst) {
+            for (int jr = 0; jr < nb; jr += GEMM_NR) {
+                int cols = std::min(GEMM_NR, nb - jr);
+                for (int p = 0; p < kb; ++p) {
+                    const double* src = b.row(row0 + p) + col0 + jr;
+                    for (int j = 0; j < cols; ++j) {
+                        dst[j] = src[j];
+                    }
+                    for (int j = cols; j < GEMM_NR; ++j) {
+                        dst[j] = 0.0;
+                    }
+                    dst += GEMM_NR;
+                }
+            }
+        }
+
+        // C[0:mr, 0:nr] += alpha * (packed A sliver) * (packed B sliver)
+        void microKernel(int kc, const double* a, const double* b, double alpha,
+                         double* c, size_t ldc, int mr, int nr) {
+#ifdef MATRIX_GEMM_AVX2
+            __m256d acc[GEMM_MR][2];
+            for (int i = 0; i < GEMM_MR; ++i) {
+                acc[i][0] = _mm256_setzero_pd();
+                acc[i][1] = _mm256_setzero_pd();
+            }
+            for (int p = 0; p < kc; ++p) {
+                __m256d b0 = _mm256_load_pd(b);
+                __m256d b1 = _mm256_load_pd(b + 4);
+                for (int i = 0; i < GEMM_MR; ++i) {
+                    __m256d ai = _mm256_broadcast_sd(a + i);
+                    acc[i][0] = _mm256_fmadd_pd(ai, b0, acc[i][0]);
+                    acc[i][1] = _mm256_fmadd_pd(ai, b1, acc[i][1]);
+                }
+                a += GEMM_MR;
+                b += GEMM_NR;
+            }
+            __m256d va = _mm256_set1_pd(alpha);
+            if (mr == GEMM_MR && nr == GEMM_NR) {
+                for (int i = 0; i < GEMM_MR; ++i) {
+                    double* ci = c + i * ldc;
+                    _mm256_storeu_pd(ci, _mm256_fmadd_pd(va, acc[i][0], _mm256_loadu_pd(ci)));
+                    _mm256_storeu_pd(ci + 4, _mm256_fmadd_pd(va, acc[i][1], _mm256_loadu_pd(ci + 4)));
+                }
+                return;
+            }
+            alignas(32) double tile[GEMM_MR][GEMM_NR];
+            for (int i = 0; i < GEMM_MR; ++i) {
+                _mm256_store_pd(tile[i], acc[i][0]);
+                _mm256_store_pd(tile[i] + 4, acc[i][1]);
+            }
+#else
+            double tile[GEMM_MR][GEMM_NR] = {};
+            for (int p = 0; p < kc; ++p) {
+                for (int i = 0; i < GEMM_MR; ++i) {
+                    double ai = a[i];
+                    for (int j = 0; j < GEMM_NR; ++j) {
+                        tile[i][j] += ai * b[j];
+                    }
+                }
+                a += GEMM_MR;
+                b += GEMM_NR;
+            }
+#endif
+            // Same rounding as the full-tile path, so an element's value never depends on
+            // where the tiling put it (this is what keeps threaded results deterministic)
+            for (int i = 0; i < mr; ++i) {
+                double* ci = c + i * ldc;
+                for (int j = 0; j < nr; ++j) {
+#ifdef MATRIX_GEMM_AVX2
+                    ci[j] = std::fma(alpha, tile[i][j], ci[j]);
+#else
+                    ci[j] += alpha * tile[i][j];
+#endif
+                }
+            }
+        }
+
+        void scaleMatrix(DenseMatrixView c, double beta) {
+            if (beta == 1.0) return;
+            for (int i = 0; i < c.rows(); ++i) {
+                double* row = c.row(i);
+                if (beta == 0.0) {
+                    std::fill(row, row + c.cols(), 0.0); // Also clears NaN/Inf, as BLAS does
+                } else {
+                    for (int j = 0; j < c.cols(); ++j) row[j] *= beta;
+                }
+            }
+        }
+
+        // i-k-j loop for products too small to amortise packing
+        void gemmSmall(double alpha, ConstDenseMatrixView a, ConstDenseMatrixView b, DenseMatrixView c) {
+            for (int i = 0; i < a.rows(); ++i) {
+                const double* a_row = a.row(i);
+                double* c_row = c.row(i);
+                for (int k = 0; k < a.cols(); ++k) {
+                    double a_ik = alpha * a_row[k];
+                    const double* b_row = b.row(k);
+                    for (int j = 0; j < c.cols(); ++j) {
+                        c_row[j] += a_ik * b_row[j];
+                    }
+                }
+            }
+        }
+
+        // C += alpha * A * B with packed panels; C must already hold beta * C
+        void gemmBlocked(double alpha, ConstDenseMatrixView a, ConstDenseMatrixView b, DenseMatrixView c,
+                         const GemmBlocking& blk) {
+            const int m = a.rows();
+            const int k = a.cols();
+            const int n = b.cols();
+            double* pack_a = t_pack_a.reserve(static_cast<size_t>(roundUp(std::min(blk.mc, m), GEMM_MR)) * blk.kc);
+            double* pack_b = t_pack_b.reserve(static_cast<size_t>(roundUp(std::min(blk.nc, n), GEMM_NR)) * blk.kc);
+
+            for (int jc = 0; jc < n; jc += blk.nc) {
+                const int nb = std::min(blk.nc, n - jc);
+                for (int pc = 0; pc < k; pc += blk.kc) {
+                    const int kb = std::min(blk.kc, k - pc);
+                    packB(b, pc, jc, kb, nb, pack_b);
+                    for (int ic = 0; ic < m; ic += blk.mc) {
+                        const int mb = std::min(blk.mc, m - ic);
+                        packA(a, ic, pc, mb, kb, pack_a);
+                        for (int jr = 0; jr < nb; jr += GEMM_NR) {
+                            const double* b_sliver = pack_b + static_cast<size_t>(jr) * kb;
+                            const int nr = std::min(GEMM_NR, nb - jr);
+                            for (int ir = 0; ir < mb; ir += GEMM_MR) {
+                                const double* a_sliver = pack_a + static_cast<size_t>(ir) * kb;
+                                const int mr = std::min(GEMM_MR, mb - ir);
+                                microKernel(kb, a_sliver, b_sliver, alpha,
+                                            c.row(ic + ir) + jc + jr, c.stride(), mr, nr);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+    } // namespace
+
+    void setGemmBlocking(const GemmBlocking& blocking) {
+        if (blocking.mc <= 0 || blocking.kc <= 0 || blocking.nc <= 0) {
+            throw std::invalid_argument("GEMM block sizes must be positive.");
+        }
+        g_blocking.mc = roundUp(blocking.mc, GEMM_MR);
+        g_blocking.kc = blocking.kc;
+        g_blocking.nc = roundUp(blocking.nc, GEMM_NR);
+    }
+
+    GemmBlocking getGemmBlocking() {
+        return g_blocking;
+    }
+
+    const char* gemmKernelName() {
+#ifdef MATRIX_GEMM_AVX2
+        return "avx2-fma 6x8";
+#else
+        return "scalar 6x8";
+#endif
+    }
+
+    void gemm(double alpha, ConstDenseMatrixView a, ConstDenseMatrixView b, double beta, DenseMatrixView c) {
+        const int m = a.rows();
+        const int k = a.cols();
+        const int n = b.cols();
+        if (b.rows() != k || c.rows() != m || c.cols() != n) {
+            throw std::invalid_argument("Incompatible dimensions for matrix multiplication (A.cols != B.rows).");
+        }
+
+        scaleMatrix(c, beta);
+        if (m == 0 || n == 0 || k == 0 || alpha == 0.0) {
+            return;
+        }
+        if (static_cast<double>(m) * n * k <= GEMM_SMALL_WORK) {
+            gemmSmall(alpha, a, b, c);
+            return;
+        }
+
+        const GemmBlocking blk = g_blocking;
+        if (static_cast<double>(m) * n * k <= GEMM_PARALLEL_WORK) {
+            gemmBlocked(alpha, a, b, c, blk);
+            return;
+        }
+
+        // Each task owns one output tile end to end with the same k order, so the result is
+        // bit-identical for any thread count or steal pattern
+        const int row_tiles = (m + blk.mc - 1) / blk.mc;
+        const int col_tiles = (n + GEMM_TILE_COLS - 1) / GEMM_TILE_COLS;
+        matrixThreadPool().parallelFor(row_tiles * col_tiles, [&](int tile) {
+            int i0 = (tile / col_tiles) * blk.mc;
+            int j0 = (tile % col_tiles) * GEMM_TILE_COLS;
+            int mt = std::min(blk.mc, m - i0);
+            int nt = std::min(GEMM_TILE_COLS, n - j0);
+            gemmBlocked(alpha, a.block(i0, 0, mt, k), b.block(0, j0, k, nt), c.block(i0, j0, mt, nt), blk);
+        });
+    }
+
+} // namespace MatrixUtils
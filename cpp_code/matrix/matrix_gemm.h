@@ -0,0 +1,34 @@
+// File: matrix_gemm.h
+#ifndef MATRIX_GEMM_H
+#define MATRIX_GEMM_H
+
+#include "dense_matrix.h"
+
+namespace MatrixUtils {
+
+    // Cache blocking for the packed GEMM (Goto/BLIS loop order).
+    //   kc: depth of a packed panel; one MR x kc sliver of A plus a kc x NR sliver of B stay in L1.
+    //   mc: rows of A packed per block; the mc x kc block of A should sit in L2.
+    //   nc: columns of B packed per block; the kc x nc panel of B should sit in L3.
+    struct GemmBlocking {
+        int mc = 120;
+        int kc = 256;
+        int nc = 4096;
+    };
+
+    // Register tile computed by the micro-kernel
+    constexpr int GEMM_MR = 6;
+    constexpr int GEMM_NR = 8;
+
+    void setGemmBlocking(const GemmBlocking& blocking); // Rounded to multiples of the register tile
+    GemmBlocking getGemmBlocking();
+    const char* gemmKernelName(); // "avx2-fma 6x8" or "scalar 6x8"
+
+    // C = alpha * A * B + beta * C. C must not alias A or B.
+    // Large products are split into output tiles on matrixThreadPool(); results are
+    // bit-identical whatever the thread count.
+    void gemm(double alpha, ConstDenseMatrixView a, ConstDenseMatrixView b, double beta, DenseMatrixView c);
+
+} // namespace MatrixUtils
+
+#endif // MATRIX_GEMM_H
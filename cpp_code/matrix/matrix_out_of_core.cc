@@ -0,0 +1,237 @@
+// File: matrix_out_of_core.cc
+#include "matrix_out_of_core.h"
+#include "matrix_backend.h"
+#include "matrix_file.h"
+#include <algorithm> // For std::min, std::max
+#include <chrono>
+#include <cmath>     // For std::sqrt
+#include <condition_variable>
+#include <exception>
+#include <filesystem> // For std::filesystem::equivalent
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace MatrixUtils {
+
+    namespace {
+
+        constexpr int MIN_TILE = 16;
+
+        using Clock = std::chrono::steady_clock;
+
+        double secondsSince(Clock::time_point start) {
+            return std::chrono::duration<double>(Clock::now() - start).count();
+        }
+
+        // Same file however it is spelled (./a.bin, a symlink, a hard link). A path that does
+        // not exist yet names no input, and equivalent() then reports false through the error.
+        bool sameFile(const std::string& x, const std::string& y) {
+            std::error_code error;
+            return std::filesystem::equivalent(x, y, error);
+        }
+
+        int roundDownToEight(long long value) {
+            return static_cast<int>(std::max<long long>(MIN_TILE, value / 8 * 8));
+        }
+
+        // Splits the budget between one C tile (rows x cols) and `slots` pairs of A
+        // (rows x depth) and B (depth x cols) tiles. Traffic is m*n*k * (1/rows + 1/cols)
+        // elements whatever the depth, so the square C tile gets most of the memory and the
+        // depth takes what is left (with depth = tile / 4 as the starting split).
+        void chooseTiles(size_t budget, int slots, int m, int n, int k, OutOfCoreStats& stats) {
+            const double elements = static_cast<double>(budget) / sizeof(double);
+            long long tile = static_cast<long long>(std::sqrt(elements / (1.0 + slots * 0.5)));
+            if (tile < MIN_TILE) {
+                throw std::invalid_argument("Memory budget of " + std::to_string(budget) +
+                                            " bytes is too small for out-of-core tiles.");
+            }
+            int rows = std::min(roundDownToEight(tile), std::max(m, 1));
+            int cols = std::min(roundDownToEight(tile), std::max(n, 1));
+            // Strides are padded to 8 doubles, so size every tile by its padded width. That
+            // includes the depth, which is the width of the A tiles: a depth below 8 still
+            // costs 8 columns of A, so shrink it until the padded tiles fit.
+            const double c_elements = static_cast<double>(rows) * paddedStride(cols);
+            auto paddedElements = [&](long long depth) {
+                return c_elements + slots * (static_cast<double>(depth) * paddedStride(cols) +
+                                             static_cast<double>(rows) * paddedStride(static_cast<int>(depth)));
+            };
+            double per_depth = slots * (static_cast<double>(paddedStride(cols)) + rows); // Exact at multiples of 8
+            long long depth = static_cast<long long>((elements - c_elements) / per_depth);
+            if (depth > 8) depth = depth / 8 * 8;
+            depth = std::min<long long>(depth, std::max(k, 1));
+            while (depth >= 1 && paddedElements(depth) > elements) --depth;
+            if (depth < 1) {
+                throw std::invalid_argument("Memory budget of " + std::to_string(budget) +
+                                            " bytes is too small for out-of-core tiles.");
+            }
+            stats.tile_rows = rows;
+            stats.tile_cols = cols;
+            stats.tile_depth = static_cast<int>(depth);
+        }
+
+        struct TileSlot {
+            DenseMatrix a;
+            DenseMatrix b;
+        };
+
+        // Hand-off between the prefetch thread and the compute loop: slot_task[s] is the
+        // schedule index whose tiles slot s holds, or -1 while the slot is free.
+        struct PrefetchState {
+            std::mutex mutex;
+            std::condition_variable changed;
+            std::vector<long long> slot_task;
+            bool abort = false;
+            std::exception_ptr error;
+        };
+
+    } // namespace
+
+    OutOfCoreStats multiplyMatrixFiles(const std::string& a_path, const std::string& b_path,
+                                       const std::string& c_path, const OutOfCoreOptions& options) {
+        auto start = Clock::now();
+        if (sameFile(c_path, a_path) || sameFile(c_path, b_path)) {
+            throw std::invalid_argument("The output file must differ from both input files.");
+        }
+        if (options.prefetch_depth < 0) {
+            throw std::invalid_argument("Prefetch depth cannot be negative.");
+        }
+        MatrixFileBlockIO a_io(a_path);
+        MatrixFileBlockIO b_io(b_path);
+        const int m = a_io.info().rows;
+        const int k = a_io.info().cols;
+        const int n = b_io.info().cols;
+        if (b_io.info().rows != k) {
+            throw std::invalid_argument("Incompatible dimensions for matrix multiplication (A.cols != B.rows).");
+        }
+
+        OutOfCoreStats stats;
+        const int slot_count = options.prefetch_depth + 1;
+        chooseTiles(options.memory_budget_bytes, slot_count, m, n, k, stats);
+        createMatrixFile(c_path, m, n);
+        if (m == 0 || n == 0) {
+            stats.total_seconds = secondsSince(start);
+            return stats;
+        }
+        MatrixFileBlockIO c_io(c_path, true);
+
+        const int tm = stats.tile_rows, tn = stats.tile_cols, tk = stats.tile_depth;
+        DenseMatrix c_tile(tm, tn);
+        std::vector<TileSlot> slots(slot_count);
+        for (TileSlot& slot : slots) {
+            slot.a = DenseMatrix(tm, tk);
+            slot.b = DenseMatrix(tk, tn);
+        }
+        stats.buffer_bytes = sizeof(double) * (static_cast<size_t>(tm) * c_tile.stride() +
+                                               slot_count * (static_cast<size_t>(tm) * slots[0].a.stride() +
+                                                             static_cast<size_t>(tk) * slots[0].b.stride()));
+
+        // Schedule: C tiles row by row, and for each the k-steps in order. Task t covers
+        // C tile (t / k_steps) and k-step (t % k_steps); an empty k has one zero-width step.
+        const int row_tiles = (m + tm - 1) / tm;
+        const int col_tiles = (n + tn - 1) / tn;
+        const int k_steps = std::max(1, (k + tk - 1) / tk);
+        const long long task_count = static_cast<long long>(row_tiles) * col_tiles * k_steps;
+        struct TileTask {
+            int i0, j0, p0, rows, cols, depth;
+            bool first, last;
+        };
+        auto taskAt = [&](long long t) {
+            long long tile = t / k_steps;
+            int step = static_cast<int>(t % k_steps);
+            TileTask task;
+            task.i0 = static_cast<int>(tile / col_tiles) * tm;
+            task.j0 = static_cast<int>(tile % col_tiles) * tn;
+            task.p0 = step * tk;
+            task.rows = std::min(tm, m - task.i0);
+            task.cols = std::min(tn, n - task.j0);
+            task.depth = std::max(0, std::min(tk, k - task.p0));
+            task.first = step == 0;
+            task.last = step == k_steps - 1;
+            return task;
+        };
+
+        PrefetchState state;
+        state.slot_task.assign(slot_count, -1);
+        size_t bytes_read = 0; // Written by the prefetch thread only; read after join
+        std::thread prefetcher([&] {
+            try {
+                for (long long t = 0; t < task_count; ++t) {
+                    const int s = static_cast<int>(t % slot_count);
+                    {
+                        std::unique_lock<std::mutex> lock(state.mutex);
+                        state.changed.wait(lock, [&] { return state.abort || state.slot_task[s] == -1; });
+                        if (state.abort) return;
+                    }
+                    TileTask task = taskAt(t);
+                    a_io.readBlock(task.i0, task.p0, slots[s].a.view().block(0, 0, task.rows, task.depth));
+                    b_io.readBlock(task.p0, task.j0, slots[s].b.view().block(0, 0, task.depth, task.cols));
+                    bytes_read += sizeof(double) * static_cast<size_t>(task.depth) * (task.rows + task.cols);
+                    {
+                        std::lock_guard<std::mutex> lock(state.mutex);
+                        state.slot_task[s] = t;
+                    }
+                    state.changed.notify_all();
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                state.error = std::current_exception();
+                state.abort = true;
+                state.changed.notify_all();
+            }
+        });
+
+        try {
+            const MatrixBackend& backend = activeMatrixBackend();
+            for (long long t = 0; t < task_count; ++t) {
+                const int s = static_cast<int>(t % slot_count);
+                auto wait_start = Clock::now();
+                {
+                    std::unique_lock<std::mutex> lock(state.mutex);
+                    state.changed.wait(lock, [&] { return state.error || state.slot_task[s] == t; });
+                    if (state.error) break;
+                }
+                stats.wait_seconds += secondsSince(wait_start);
+
+                TileTask task = taskAt(t);
+                DenseMatrixView c = c_tile.view().block(0, 0, task.rows, task.cols);
+                auto compute_start = Clock::now();
+                if (task.depth == 0) {
+                    for (int r = 0; r < task.rows; ++r) std::fill(c.row(r), c.row(r) + task.cols, 0.0);
+                } else {
+                    backend.gemm(1.0, slots[s].a.view().block(0, 0, task.rows, task.depth),
+                                 slots[s].b.view().block(0, 0, task.depth, task.cols), task.first ? 0.0 : 1.0, c);
+                }
+                stats.compute_seconds += secondsSince(compute_start);
+                {
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    state.slot_task[s] = -1;
+                }
+                state.changed.notify_all();
+
+                if (task.last) {
+                    auto write_start = Clock::now();
+                    c_io.writeBlock(task.i0, task.j0, c);
+                    stats.write_seconds += secondsSince(write_start);
+                    stats.bytes_written += sizeof(double) * static_cast<size_t>(task.rows) * task.cols;
+                }
+            }
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                state.abort = true;
+            }
+            state.changed.notify_all();
+            prefetcher.join();
+            throw;
+        }
+        prefetcher.join();
+        if (state.error) std::rethrow_exception(state.error);
+
+        stats.bytes_read = bytes_read;
+        stats.total_seconds = secondsSince(start);
+        return stats;
+    }
+
+} // namespace MatrixUtils
@@ -0,0 +1,41 @@
+// File: matrix_out_of_core.h
+#ifndef MATRIX_OUT_OF_CORE_H
+#define MATRIX_OUT_OF_CORE_H
+
+#include <cstddef> // For size_t
+#include <string>
+
+namespace MatrixUtils {
+
+    // Out-of-core C = A * B over matrix files (see matrix_file.h). Only tiles are resident:
+    // one C tile accumulates in memory while A and B tiles stream in through pread. A
+    // dedicated I/O thread reads ahead into a ring of prefetch_depth + 1 tile slots, so the
+    // compute of one k-step overlaps the reads for the next ones. The kernel is the active
+    // backend's gemm, so it runs on the matrix thread pool.
+    struct OutOfCoreOptions {
+        size_t memory_budget_bytes = size_t(256) << 20; // Total for all tile buffers
+        int prefetch_depth = 2;                          // Tile pairs read ahead of the compute
+    };
+
+    struct OutOfCoreStats {
+        int tile_rows = 0;  // C tile is tile_rows x tile_cols; A tiles tile_rows x tile_depth
+        int tile_cols = 0;
+        int tile_depth = 0;
+        size_t buffer_bytes = 0; // Tile buffers actually allocated (<= the budget)
+        size_t bytes_read = 0;
+        size_t bytes_written = 0;
+        double compute_seconds = 0.0; // In gemm
+        double wait_seconds = 0.0;    // Compute stalled waiting for a prefetched tile
+        double write_seconds = 0.0;   // Writing finished C tiles
+        double total_seconds = 0.0;
+    };
+
+    // Reads row-major a_path (m x k) and b_path (k x n), float64 or float32, and writes
+    // c_path as a new float64 m x n file. Throws std::invalid_argument on mismatched shapes
+    // or a budget too small for the minimum tile, std::runtime_error on I/O failure.
+    OutOfCoreStats multiplyMatrixFiles(const std::string& a_path, const std::string& b_path,
+                                       const std::string& c_path, const OutOfCoreOptions& options = {});
+
+} // namespace MatrixUtils
+
+#endif // MATRIX_OUT_OF_CORE_H
@@ -0,0 +1,318 @@
+// File: matrix_refinement.cc
+#include "matrix_refinement.h"
+#include "matrix_utils.h"
+#include "matrix_backend.h"
+#include "thread_pool.h"
+#include <algorithm> // For std::min, std::max, std::swap_ranges
+#include <cmath>     // For std::fabs, std::sqrt
+#include <limits>    // For numeric_limits
+#include <stdexcept>
+#include <utility>   // For std::swap
+#include <vector>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define MATRIX_REFINEMENT_AVX2 1
+#endif
+
+namespace MatrixUtils {
+
+    namespace {
+
+        // Columns factored per panel before the trailing update (as GETRF_PANEL for double)
+        constexpr int FLOAT_PANEL = 64;
+
+        // Trailing-update register tile: FLOAT_MR rows x FLOAT_NR columns of accumulators
+        // (12 AVX2 registers), so every loaded vector of U feeds FLOAT_MR multiply-adds
+        constexpr int FLOAT_MR = 6;
+        constexpr int FLOAT_NR = 16;
+
+        // Rows of the trailing matrix per pool task (a multiple of FLOAT_MR)
+        constexpr int FLOAT_ROW_GRAIN = 48;
+
+        // Independent partial sums in float dot products; lanes never mix, so the compiler
+        // vectorises the loop without reassociating
+        constexpr int DOT_LANES = 16;
+
+        // Row-major float copy of A, factored in place like LUDecomposition::lu
+        struct FloatLU {
+            int n = 0;
+            size_t stride = 0;
+            std::vector<float> lu;
+            std::vector<int> pivots;
+
+            float* row(int r) { return lu.data() + r * stride; }
+            const float* row(int r) const { return lu.data() + r * stride; }
+        };
+
+        float dotFloat(const float* x, const float* y, int count) {
+            float lanes[DOT_LANES] = {};
+            int k = 0;
+            for (; k + DOT_LANES <= count; k += DOT_LANES) {
+                for (int t = 0; t < DOT_LANES; ++t) lanes[t] += x[k + t] * y[k + t];
+            }
+            float sum = 0.0f;
+            for (; k < count; ++k) sum += x[k] * y[k];
+            for (float lane : lanes) sum += lane;
+            return sum;
+        }
+
+        // c[0:rows, 0:cols] -= (packed L sliver, depth x FLOAT_MR) * (packed U sliver,
+        // depth x FLOAT_NR); rows <= FLOAT_MR and cols <= FLOAT_NR
+        void floatMicroKernel(int depth, const float* l, const float* u, float* c, size_t c_stride, int rows,
+                              int cols) {
+            alignas(32) float tile[FLOAT_MR][FLOAT_NR];
+#ifdef MATRIX_REFINEMENT_AVX2
+            __m256 acc[FLOAT_MR][2];
+            for (int i = 0; i < FLOAT_MR; ++i) {
+                acc[i][0] = _mm256_setzero_ps();
+                acc[i][1] = _mm256_setzero_ps();
+            }
+            for (int p = 0; p < depth; ++p) {
+                __m256 u0 = _mm256_loadu_ps(u);
+                __m256 u1 = _mm256_loadu_ps(u + 8);
+                for (int i = 0; i < FLOAT_MR; ++i) {
+                    __m256 li = _mm256_broadcast_ss(l + i);
+                    acc[i][0] = _mm256_fmadd_ps(li, u0, acc[i][0]);
+                    acc[i][1] = _mm256_fmadd_ps(li, u1, acc[i][1]);
+                }
+                l += FLOAT_MR;
+                u += FLOAT_NR;
+            }
+            if (rows == FLOAT_MR && cols == FLOAT_NR) {
+                for (int i = 0; i < FLOAT_MR; ++i) {
+                    float* ci = c + i * c_stride;
+                    _mm256_storeu_ps(ci, _mm256_sub_ps(_mm256_loadu_ps(ci), acc[i][0]));
+                    _mm256_storeu_ps(ci + 8, _mm256_sub_ps(_mm256_loadu_ps(ci + 8), acc[i][1]));
+                }
+                return;
+            }
+            for (int i = 0; i < FLOAT_MR; ++i) {
+                _mm256_store_ps(tile[i], acc[i][0]);
+                _mm256_store_ps(tile[i] + 8, acc[i][1]);
+            }
+#else
+            for (int i = 0; i < FLOAT_MR; ++i) {
+                for (int j = 0; j < FLOAT_NR; ++j) tile[i][j] = 0.0f;
+            }
+            for (int p = 0; p < depth; ++p) {
+                for (int i = 0; i < FLOAT_MR; ++i) {
+                    const float li = l[i];
+                    for (int j = 0; j < FLOAT_NR; ++j) tile[i][j] += li * u[j];
+                }
+                l += FLOAT_MR;
+                u += FLOAT_NR;
+            }
+#endif
+            for (int i = 0; i < rows; ++i) {
+                float* ci = c + i * c_stride;
+                for (int j = 0; j < cols; ++j) ci[j] -= tile[i][j];
+            }
+        }
+
+        // Right-looking blocked LU with partial pivoting, the float twin of the built-in
+        // backend's getrf. Returns false on an exactly zero pivot.
+        bool floatGetrf(FloatLU& f) {
+            const int n = f.n;
+            std::vector<float> packed_u;
+            for (int k = 0; k < n; k += FLOAT_PANEL) {
+                const int nb = std::min(FLOAT_PANEL, n - k);
+                for (int j = k; j < k + nb; ++j) {
+                    int pivot_row = j;
+                    float pivot_abs = std::fabs(f.row(j)[j]);
+                    for (int r = j + 1; r < n; ++r) {
+                        float v = std::fabs(f.row(r)[j]);
+                        if (v > pivot_abs) {
+                            pivot_abs = v;
+                            pivot_row = r;
+                        }
+                    }
+                    f.pivots[j] = pivot_row;
+                    if (pivot_abs == 0.0f) return false;
+                    if (pivot_row != j) std::swap_ranges(f.row(j), f.row(j) + n, f.row(pivot_row));
+                    const float* row_j = f.row(j);
+                    const float inv_pivot = 1.0f / row_j[j];
+                    for (int r = j + 1; r < n; ++r) {
+                        float* row_r = f.row(r);
+                        const float l = row_r[j] * inv_pivot;
+                        row_r[j] = l;
+                        if (l == 0.0f) continue;
+                        for (int c = j + 1; c < k + nb; ++c) row_r[c] -= l * row_j[c];
+                    }
+                }
+                const int rest = n - k - nb;
+                if (rest <= 0) continue;
+                // U12 = L11^-1 * A12, row by row
+                for (int r = k + 1; r < k + nb; ++r) {
+                    float* row_r = f.row(r) + k + nb;
+                    const float* l_row = f.row(r);
+                    for (int c = k; c < r; ++c) {
+                        const float l = l_row[c];
+                        if (l == 0.0f) continue;
+                        const float* row_c = f.row(c) + k + nb;
+                        for (int j = 0; j < rest; ++j) row_r[j] -= l * row_c[j];
+                    }
+                }
+                // A22 -= L21 * U12 on the matrix pool. U12 is packed once into zero-padded
+                // FLOAT_NR-wide slivers shared by every task; each task packs its own L21 rows.
+                const int strips = (rest + FLOAT_NR - 1) / FLOAT_NR;
+                packed_u.assign(static_cast<size_t>(strips) * nb * FLOAT_NR, 0.0f);
+                for (int p = 0; p < nb; ++p) {
+                    const float* u_row = f.row(k + p) + k + nb;
+                    for (int j = 0; j < rest; ++j) {
+                        packed_u[(static_cast<size_t>(j / FLOAT_NR) * nb + p) * FLOAT_NR + j % FLOAT_NR] = u_row[j];
+                    }
+                }
+                const int tasks = (rest + FLOAT_ROW_GRAIN - 1) / FLOAT_ROW_GRAIN;
+                matrixThreadPool().parallelFor(tasks, [&](int task) {
+                    alignas(32) float packed_l[FLOAT_PANEL * FLOAT_MR];
+                    const int end = std::min(n, k + nb + (task + 1) * FLOAT_ROW_GRAIN);
+                    for (int r = k + nb + task * FLOAT_ROW_GRAIN; r < end; r += FLOAT_MR) {
+                        const int rows = std::min(FLOAT_MR, end - r);
+                        for (int p = 0; p < nb; ++p) {
+                            for (int i = 0; i < FLOAT_MR; ++i) packed_l[p * FLOAT_MR + i] = i < rows ? f.row(r + i)[k + p] : 0.0f;
+                        }
+                        for (int s = 0; s < strips; ++s) {
+                            floatMicroKernel(nb, packed_l, packed_u.data() + static_cast<size_t>(s) * nb * FLOAT_NR,
+                                             f.row(r) + k + nb + s * FLOAT_NR, f.stride, rows,
+                                             std::min(FLOAT_NR, rest - s * FLOAT_NR));
+                        }
+                    }
+                });
+            }
+            return true;
+        }
+
+        // y = A_f^-1 * y for one contiguous float right-hand side
+        void floatSolve(const FloatLU& f, float* y) {
+            const int n = f.n;
+            for (int k = 0; k < n; ++k) {
+                if (f.pivots[k] != k) std::swap(y[k], y[f.pivots[k]]);
+            }
+            for (int r = 1; r < n; ++r) y[r] -= dotFloat(f.row(r), y, r);
+            for (int r = n - 1; r >= 0; --r) {
+                const float* u_row = f.row(r);
+                y[r] = (y[r] - dotFloat(u_row + r + 1, y + r + 1, n - r - 1)) / u_row[r];
+            }
+        }
+
+        // r = b - a * x
+        void residual(ConstDenseMatrixView a, ConstDenseMatrixView x, ConstDenseMatrixView b, DenseMatrix& r) {
+            for (int i = 0; i < b.rows(); ++i) std::copy(b.row(i), b.row(i) + b.cols(), r.row(i));
+            const MatrixBackend& backend = activeMatrixBackend();
+            if (b.cols() == 1) {
+                // A single column is strided in a padded DenseMatrix; gemv wants it contiguous
+                std::vector<double> x_col(x.rows()), r_col(r.rows());
+                for (int i = 0; i < x.rows(); ++i) x_col[i] = x(i, 0);
+                for (int i = 0; i < r.rows(); ++i) r_col[i] = r(i, 0);
+                backend.gemv(-1.0, a, x_col.data(), 1.0, r_col.data());
+                for (int i = 0; i < r.rows(); ++i) r(i, 0) = r_col[i];
+            } else {
+                backend.gemm(-1.0, a, x, 1.0, r);
+            }
+        }
+
+        // Largest ||r_j||_inf / ||x_j||_inf over the columns (0 for a zero residual)
+        double worstColumnRatio(const DenseMatrix& r, const DenseMatrix& x) {
+            double worst = 0.0;
+            for (int j = 0; j < r.cols(); ++j) {
+                double r_max = 0.0, x_max = 0.0;
+                for (int i = 0; i < r.rows(); ++i) {
+                    r_max = std::max(r_max, std::fabs(r(i, j)));
+                    x_max = std::max(x_max, std::fabs(x(i, j)));
+                }
+                if (r_max == 0.0) continue;
+                worst = std::max(worst, x_max > 0.0 ? r_max / x_max : std::numeric_limits<double>::infinity());
+            }
+            return worst;
+        }
+
+    } // namespace
+
+    RefinedSolution solveMixedPrecision(ConstDenseMatrixView a, ConstDenseMatrixView b,
+                                        const RefinementOptions& options) {
+        int n;
+        if (!isSquareMatrix(a, n)) {
+            throw std::invalid_argument("Mixed-precision solve requires a square matrix.");
+        }
+        if (b.rows() != n || b.cols() == 0) {
+            throw std::invalid_argument("Right-hand side rows do not match the coefficient matrix.");
+        }
+        const int nrhs = b.cols();
+
+        // ||A||_inf, and whether every entry survives the conversion to float
+        double a_norm = 0.0, a_max = 0.0;
+        for (int i = 0; i < n; ++i) {
+            const double* row = a.row(i);
+            double sum = 0.0;
+            for (int j = 0; j < n; ++j) {
+                sum += std::fabs(row[j]);
+                a_max = std::max(a_max, std::fabs(row[j]));
+            }
+            a_norm = std::max(a_norm, sum);
+        }
+        // Stop once the residual is that of a backward-stable double solve (dsgesv's test)
+        const double threshold = a_norm * std::numeric_limits<double>::epsilon() * std::sqrt(static_cast<double>(n));
+
+        RefinedSolution result;
+        result.x = DenseMatrix(n, nrhs);
+        DenseMatrix r(n, nrhs);
+        bool usable = a_max <= std::numeric_limits<float>::max();
+
+        FloatLU f;
+        if (usable) {
+            f.n = n;
+            f.stride = paddedStride(n);
+            f.lu.assign(static_cast<size_t>(n) * f.stride, 0.0f);
+            f.pivots.resize(n);
+            for (int i = 0; i < n; ++i) {
+                const double* row = a.row(i);
+                float* dst = f.row(i);
+                for (int j = 0; j < n; ++j) dst[j] = static_cast<float>(row[j]);
+            }
+            usable = floatGetrf(f);
+        }
+
+        // x += A_f^-1 * r, column by column on the pool (r = b for the first solve)
+        std::vector<float> work(static_cast<size_t>(n) * nrhs);
+        auto correct = [&](const DenseMatrix& rhs) {
+            matrixThreadPool().parallelFor(nrhs, [&](int j) {
+                float* y = work.data() + static_cast<size_t>(j) * n;
+                for (int i = 0; i < n; ++i) y[i] = static_cast<float>(rhs(i, j));
+                floatSolve(f, y);
+                for (int i = 0; i < n; ++i) result.x(i, j) += y[i];
+            });
+        };
+
+        if (usable) {
+            DenseMatrix rhs = DenseMatrix::fromView(b);
+            correct(rhs);
+            double previous = std::numeric_limits<double>::infinity();
+            for (int iteration = 0;; ++iteration) {
+                residual(a, result.x, b, r);
+                const double ratio = worstColumnRatio(r, result.x);
+                if (ratio <= threshold) {
+                    result.refined = true;
+                    result.iterations = iteration;
+                    result.backward_error = a_norm > 0.0 ? ratio / a_norm : 0.0;
+                    return result;
+                }
+                // Refinement contracts by about cond(A) * 2^-24 per step; no progress means
+                // A is too ill-conditioned for the float factors
+                if (iteration == options.max_iterations || !(ratio < previous)) {
+                    result.iterations = iteration;
+                    break;
+                }
+                previous = ratio;
+                correct(r);
+            }
+        }
+
+        LUDecomposition lu = luDecompose(a);
+        result.x = lu.solve(b);
+        residual(a, result.x, b, r);
+        result.backward_error = a_norm > 0.0 ? worstColumnRatio(r, result.x) / a_norm : 0.0;
+        return result;
+    }
+
+} // namespace MatrixUtils
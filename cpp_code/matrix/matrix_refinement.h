@@ -0,0 +1,33 @@
+// File: matrix_refinement.h
+#ifndef MATRIX_REFINEMENT_H
+#define MATRIX_REFINEMENT_H
+
+#include "matrix_types.h"
+
+namespace MatrixUtils {
+
+    // Mixed-precision iterative refinement (LAPACK dsgesv): A is factored once in float,
+    // which halves the memory traffic of the O(n^3) step and doubles the SIMD width, then
+    // x is corrected in double, x += A_f^-1 (b - A x) with the residual in double, until
+    // every column's residual is at the level of a double-precision backward-stable solve.
+    // Each step costs O(n^2). When A is too ill-conditioned for float (roughly
+    // cond(A) > 1e7) refinement stalls, and the solve falls back to a double LU.
+    struct RefinementOptions {
+        int max_iterations = 30; // Refinement steps before falling back to double
+    };
+
+    struct RefinedSolution {
+        DenseMatrix x;
+        int iterations = 0;         // Refinement steps taken with the float factors
+        bool refined = false;       // False if x came from the double-precision fallback
+        double backward_error = 0.0; // max over columns of ||b - A x||_inf / (||A||_inf * ||x||_inf)
+    };
+
+    // Solves A * X = B for square A and every column of B. Throws std::invalid_argument on
+    // mismatched shapes and std::runtime_error if A is singular in double precision too.
+    RefinedSolution solveMixedPrecision(ConstDenseMatrixView a, ConstDenseMatrixView b,
+                                        const RefinementOptions& options = {});
+
+} // namespace MatrixUtils
+
+#endif // MATRIX_REFINEMENT_H
@@ -0,0 +1,161 @@
+// File: matrix_transpose.cc
+#include "matrix_transpose.h"
+#include "matrix_utils.h"
+#include <stdexcept>
+#include <utility>   // For std::swap
+#include <algorithm> // For std::min
+
+namespace MatrixUtils {
+
+    namespace {
+
+        constexpr int MICRO = 8; // One cache line of doubles
+
+        // Halves n but keeps the first part a multiple of MICRO, so nearly every leaf tile
+        // is built from whole 8 x 8 sub-blocks (n > TRANSPOSE_TILE here, so h >= 16)
+        int splitPoint(int n) {
+            return n / 2 / MICRO * MICRO;
+        }
+
+        // Moves 8 x 8 sub-blocks through a register-sized buffer, so every read and every
+        // write is a full contiguous cache line rather than one double per row
+        void transposeTile(ConstDenseMatrixView src, DenseMatrixView dst) {
+            const int rows = src.rows();
+            const int cols = src.cols();
+            double buffer[MICRO][MICRO];
+            for (int i0 = 0; i0 < rows; i0 += MICRO) {
+                const int mi = std::min(MICRO, rows - i0);
+                for (int j0 = 0; j0 < cols; j0 += MICRO) {
+                    const int mj = std::min(MICRO, cols - j0);
+                    if (mi == MICRO && mj == MICRO) {
+                        for (int i = 0; i < MICRO; ++i) {
+                            const double* s = src.row(i0 + i) + j0;
+                            for (int j = 0; j < MICRO; ++j) buffer[j][i] = s[j];
+                        }
+                        for (int j = 0; j < MICRO; ++j) {
+                            double* d = dst.row(j0 + j) + i0;
+                            for (int i = 0; i < MICRO; ++i) d[i] = buffer[j][i];
+                        }
+                        continue;
+                    }
+                    for (int i = 0; i < mi; ++i) {
+                        for (int j = 0; j < mj; ++j) dst(j0 + j, i0 + i) = src(i0 + i, j0 + j);
+                    }
+                }
+            }
+        }
+
+        void transposeBlock(ConstDenseMatrixView src, DenseMatrixView dst) {
+            const int rows = src.rows();
+            const int cols = src.cols();
+            if (rows <= TRANSPOSE_TILE && cols <= TRANSPOSE_TILE) {
+                transposeTile(src, dst);
+                return;
+            }
+            if (rows >= cols) {
+                const int h = splitPoint(rows);
+                transposeBlock(src.block(0, 0, h, cols), dst.block(0, 0, cols, h));
+                transposeBlock(src.block(h, 0, rows - h, cols), dst.block(0, h, cols, rows - h));
+            } else {
+                const int h = splitPoint(cols);
+                transposeBlock(src.block(0, 0, rows, h), dst.block(0, 0, h, rows));
+                transposeBlock(src.block(0, h, rows, cols - h), dst.block(h, 0, cols - h, rows));
+            }
+        }
+
+        // x (p x q) and y (q x p) exchange contents transposed: x <- y^T, y <- x^T
+        void swapTransposed(DenseMatrixView x, DenseMatrixView y) {
+            const int p = x.rows();
+            const int q = x.cols();
+            if (p <= TRANSPOSE_TILE && q <= TRANSPOSE_TILE) {
+                double tx[MICRO][MICRO];
+                for (int i0 = 0; i0 < p; i0 += MICRO) {
+                    const int mi = std::min(MICRO, p - i0);
+                    for (int j0 = 0; j0 < q; j0 += MICRO) {
+                        const int mj = std::min(MICRO, q - j0);
+                        if (mi == MICRO && mj == MICRO) {
+                            // Stage x's block transposed, pull y's block across, then write x^T into y
+                            for (int i = 0; i < MICRO; ++i) {
+                                const double* x_i = x.row(i0 + i) + j0;
+                                for (int j = 0; j < MICRO; ++j) tx[j][i] = x_i[j];
+                            }
+                            for (int i = 0; i < MICRO; ++i) {
+                                double* x_i = x.row(i0 + i) + j0;
+                                for (int j = 0; j < MICRO; ++j) x_i[j] = y(j0 + j, i0 + i);
+                            }
+                            for (int j = 0; j < MICRO; ++j) {
+                                double* y_j = y.row(j0 + j) + i0;
+                                for (int i = 0; i < MICRO; ++i) y_j[i] = tx[j][i];
+                            }
+                            continue;
+                        }
+                        for (int i = 0; i < mi; ++i) {
+                            for (int j = 0; j < mj; ++j) std::swap(x(i0 + i, j0 + j), y(j0 + j, i0 + i));
+                        }
+                    }
+                }
+                return;
+            }
+            if (p >= q) {
+                const int h = splitPoint(p);
+                swapTransposed(x.block(0, 0, h, q), y.block(0, 0, q, h));
+                swapTransposed(x.block(h, 0, p - h, q), y.block(0, h, q, p - h));
+            } else {
+                const int h = splitPoint(q);
+                swapTransposed(x.block(0, 0, p, h), y.block(0, 0, h, p));
+                swapTransposed(x.block(0, h, p, q - h), y.block(h, 0, q - h, p));
+            }
+        }
+
+        void transposeSquareInPlace(DenseMatrixView a) {
+            const int n = a.rows();
+            if (n <= TRANSPOSE_TILE) {
+                for (int i = 1; i < n; ++i) {
+                    double* a_i = a.row(i);
+                    for (int j = 0; j < i; ++j) std::swap(a_i[j], a(j, i));
+                }
+                return;
+            }
+            // Diagonal quadrants transpose in place; the off-diagonal pair swaps across
+            const int h = splitPoint(n);
+            transposeSquareInPlace(a.block(0, 0, h, h));
+            transposeSquareInPlace(a.block(h, h, n - h, n - h));
+            swapTransposed(a.block(0, h, h, n - h), a.block(h, 0, n - h, h));
+        }
+
+    } // namespace
+
+    void transposeInto(ConstDenseMatrixView src, DenseMatrixView dst) {
+        if (dst.rows() != src.cols() || dst.cols() != src.rows()) {
+            throw std::invalid_argument("Transpose destination must be " + std::to_string(src.cols()) + "x" +
+                                        std::to_string(src.rows()) + ".");
+        }
+        if (src.empty()) return;
+        transposeBlock(src, dst);
+    }
+
+    void transposeInPlace(DenseMatrixView a) {
+        if (a.rows() != a.cols()) {
+            throw std::invalid_argument("In-place transpose requires a square matrix.");
+        }
+        transposeSquareInPlace(a);
+    }
+
+    void transposeInPlace(Matrix& matrix) {
+        int n;
+        if (!isSquareMatrix(matrix, n)) {
+            throw std::invalid_argument("In-place transpose requires a square matrix.");
+        }
+        // Tile pairs (bi, bj) and (bj, bi) are swapped together so each stays in cache
+        for (int bi = 0; bi < n; bi += TRANSPOSE_TILE) {
+            for (int bj = 0; bj <= bi; bj += TRANSPOSE_TILE) {
+                const int i_end = std::min(n, bi + TRANSPOSE_TILE);
+                const int j_end = std::min(n, bj + TRANSPOSE_TILE);
+                for (int i = bi; i < i_end; ++i) {
+                    for (int j = bj; j < std::min(j_end, i); ++j) std::swap(matrix[i][j], matrix[j][i]);
+                }
+            }
+        }
+    }
+
+} // namespace MatrixUtils
@@ -0,0 +1,26 @@
+// File: matrix_transpose.h
+#ifndef MATRIX_TRANSPOSE_H
+#define MATRIX_TRANSPOSE_H
+
+#include "matrix_types.h"
+
+namespace MatrixUtils {
+
+    // Cache-oblivious transposes: the larger dimension is halved recursively until a block
+    // fits in L1, so both the reads and the writes stay cache-friendly at any size without
+    // a tuned tile size.
+
+    // Recursion stops once a block is at most TILE x TILE: 32 x 32 doubles is 8 KB per side,
+    // so source and destination tiles share L1 comfortably
+    constexpr int TRANSPOSE_TILE = 32;
+
+    // dst = src^T into caller-owned storage; dst must be cols x rows and must not overlap src
+    void transposeInto(ConstDenseMatrixView src, DenseMatrixView dst);
+    // a = a^T for a square view, without any scratch storage
+    void transposeInPlace(DenseMatrixView a);
+    // Square legacy matrices only; rows are swapped element-wise in tiles
+    void transposeInPlace(Matrix& matrix);
+
+} // namespace MatrixUtils
+
+#endif // MATRIX_TRANSPOSE_H
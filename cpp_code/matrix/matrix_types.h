@@ -5,6 +5,7 @@
 #include <vector>
 #include <string>
 #include <optional> // For optional inverse matrix
+#include "dense_matrix.h" // Contiguous DenseMatrix and its views
 
 // Define Matrix type for convenience
 using Matrix = std::vector<std::vector<double>>;
@@ -29,11 +30,23 @@ struct DeterminantResponse {
     double determinant;
 };
 
+struct ExactDeterminantResponse {
+    Matrix input_matrix;
+    std::string determinant;     // Exact decimal value, whatever its size
+    bool fits_in_int64 = false;
+    long long determinant_int64 = 0; // Valid only when fits_in_int64
+    bool used_multiprecision = false; // True if 128-bit intermediates overflowed
+};
+
 struct MatrixEqualityResponse {
     bool are_equal;
     std::string reason;
     std::string dimensions_a; // e.g., "3x4" or "Invalid"
     std::string dimensions_b;
+    long long mismatch_count = 0; // Among the elements compared (the scan may stop at the first)
+    double max_abs_error = 0.0;   // Over the elements compared
+    int first_mismatch_row = -1;
+    int first_mismatch_col = -1;
 };
 
 struct MatrixResponse { // For simple operations returning one matrix
@@ -48,11 +61,34 @@ struct MinorsCofactorsResponse {
     double determinant; // Often useful to return alongside
 };
 
+struct LinearSolveResponse {
+    Matrix solution;    // X with A * X = B (least-squares X when A has more rows than columns)
+    std::string method; // "lu", "cholesky", "qr" or "mixed"
+};
+
+struct EigenResponse {
+    Matrix input_matrix;
+    bool symmetric = false;               // Symmetric input: real eigenvalues, orthonormal eigenvectors
+    std::vector<double> eigenvalues_real; // Ascending if symmetric, else sorted by real then imaginary part
+    std::vector<double> eigenvalues_imag; // Complex pairs appear as conjugates
+    Matrix eigenvectors;                  // One per column, for symmetric input only
+};
+
+struct SvdResponse {
+    Matrix input_matrix;
+    std::vector<double> singular_values; // Descending
+    Matrix u;                            // rows x k, k = min(rows, cols)
+    Matrix v;                            // cols x k
+    int rank = 0;
+    double condition_number = 0.0;
+};
+
 struct AdjInvResponse {
     Matrix input_matrix;
     std::string dimensions;
     double determinant;
-    bool is_invertible;
+    bool is_invertible;         // Not singular to working precision (see condition_estimate)
+    double condition_estimate;  // ||A||_1 * ||A^-1||_1 (exact up to 4x4, estimated above); infinity if singular
     Matrix adjoint_matrix;
     std::optional<Matrix> inverse_matrix; // Use optional for possibly non-existent inverse
 };
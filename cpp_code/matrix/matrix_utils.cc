@@ -6,6 +6,8 @@
 #include <limits>   // For numeric_limits
 #include <sstream>  // For dimension string formatting
 #include <iomanip>  // For setting precision in output (optional)
+#include <algorithm> // For std::copy, std::min
+#include <utility>   // For std::move
 
 namespace MatrixUtils {
 
@@ -83,27 +85,19 @@ namespace MatrixUtils {
         if (!isSquareMatrix(matrix, n)) {
             throw std::invalid_argument("Determinant requires a square matrix.");
         }
-
-        if (n == 0) {
-            return 1.0; // Convention: det(0x0 matrix) = 1 (minor of 1x1)
-        }
-        if (n == 1) {
-            return matrix[0][0];
-        }
-        if (n == 2) {
-            return matrix[0][0] * matrix[1][1] - matrix[0][1] * matrix[1][0];
+        double det = 0.0;
+        if (dispatchSmallMatrix(n, [&](auto size) { det = SmallMatrix<decltype(size)::value>::fromRows(matrix).determinant(); })) {
+            return det;
         }
+        // O(n^3) LU factorization instead of the O(n!) Laplace expansion
+        return luDecompose(matrix).determinant();
+    }
 
-        double det = 0.0;
-        // Laplace expansion along the first row (row 0)
-        for (int j = 0; j < n; ++j) { // Column index j
-            Matrix sub = getSubmatrix(matrix, 0, j);
-            double minor = calculateDeterminantRecursive(sub);
-            // Cofactor sign = (-1)^(0+j)
-            double sign = (j % 2 == 0) ? 1.0 : -1.0;
-            det += sign * matrix[0][j] * minor;
+    double calculateMinorDeterminant(const Matrix& matrix, int skip_row, int skip_col) {
+        if (matrix.size() == 1) {
+            return 1.0; // Convention: det(0x0 matrix) = 1 (minor of 1x1)
         }
-        return det;
+        return calculateDeterminantRecursive(getSubmatrix(matrix, skip_row, skip_col));
     }
 
     Matrix transposeMatrix(const Matrix& matrix) {
@@ -115,9 +109,17 @@ namespace MatrixUtils {
         if (rows == 0 || cols == 0) return Matrix();
 
         Matrix transposed(cols, std::vector<double>(rows));
-        for (int i = 0; i < rows; ++i) {
-            for (int j = 0; j < cols; ++j) {
-                transposed[j][i] = matrix[i][j];
+        // Tile by tile, so the strided writes land in a few cache-resident rows at a time
+        for (int bi = 0; bi < rows; bi += TRANSPOSE_TILE) {
+            const int i_end = std::min(rows, bi + TRANSPOSE_TILE);
+            for (int bj = 0; bj < cols; bj += TRANSPOSE_TILE) {
+                const int j_end = std::min(cols, bj + TRANSPOSE_TILE);
+                for (int i = bi; i < i_end; ++i) {
+                    const double* src = matrix[i].data();
+                    for (int j = bj; j < j_end; ++j) {
+                        transposed[j][i] = src[j];
+                    }
+                }
             }
         }
         return transposed;
@@ -165,15 +167,17 @@ namespace MatrixUtils {
             throw std::invalid_argument("Incompatible dimensions for matrix multiplication (A.cols != B.rows).");
         }
 
-        Matrix result(rows_a, std::vector<double>(cols_b, 0.0)); // Initialize with zeros
-        for (int i = 0; i < rows_a; ++i) {
-            for (int j = 0; j < cols_b; ++j) {
-                for (int k = 0; k < cols_a; ++k) { // cols_a is same as rows_b
-                    result[i][j] += matrix_a[i][k] * matrix_b[k][j];
-                }
-            }
+        Matrix small_result;
+        if (rows_a == cols_a && cols_a == cols_b &&
+            dispatchSmallMatrix(rows_a, [&](auto size) {
+                using Small = SmallMatrix<decltype(size)::value>;
+                small_result = (Small::fromRows(matrix_a) * Small::fromRows(matrix_b)).toMatrix();
+            })) {
+            return small_result;
         }
-        return result;
+
+        // One contiguous copy of each operand beats walking matrix_b[k][j] across scattered rows
+        return multiplyMatrices(DenseMatrix(matrix_a), DenseMatrix(matrix_b)).toMatrix();
     }
 
     Matrix calculateCofactorMatrix(const Matrix& matrix) {
@@ -181,21 +185,219 @@ namespace MatrixUtils {
         if (!isSquareMatrix(matrix, n)) {
             throw std::invalid_argument("Cofactor matrix requires a square matrix.");
         }
-        Matrix cofactors(n, std::vector<double>(n));
+        return calculateCofactorMatrix(DenseMatrix(matrix)).toMatrix();
+    }
+
+    Matrix calculateAdjointMatrix(const Matrix& matrix) {
+        int n;
+        if (!isSquareMatrix(matrix, n)) {
+            throw std::invalid_argument("Adjoint matrix requires a square matrix.");
+        }
+        // adj(A) directly; no cofactor matrix to build and transpose back
+        return calculateAdjointMatrix(DenseMatrix(matrix)).toMatrix();
+    }
+
+    // --- DenseMatrix Overloads ---
+    // Same semantics as the Matrix versions above, over contiguous storage.
+
+    bool isValidMatrix(ConstDenseMatrixView matrix, int& rows, int& cols) {
+        rows = matrix.rows();
+        cols = matrix.cols();
+        return rows > 0 && cols > 0; // Rectangular by construction; only emptiness can be invalid
+    }
+
+    bool isSquareMatrix(ConstDenseMatrixView matrix, int& n) {
+        n = (!matrix.empty() && matrix.rows() == matrix.cols()) ? matrix.rows() : 0;
+        return n > 0;
+    }
+
+    std::string getDimensionString(ConstDenseMatrixView matrix) {
+        if (matrix.empty()) {
+            return "Invalid";
+        }
+        return std::to_string(matrix.rows()) + "x" + std::to_string(matrix.cols());
+    }
+
+    DenseMatrix getSubmatrix(ConstDenseMatrixView matrix, int skip_row, int skip_col) {
+        int n = matrix.rows();
+        if (n <= 1) {
+            return DenseMatrix();
+        }
+        DenseMatrix submatrix(n - 1, n - 1);
+        int sub_r = 0;
+        for (int r = 0; r < n; ++r) {
+            if (r == skip_row) continue;
+            const double* src = matrix.row(r);
+            double* dst = submatrix.row(sub_r++);
+            std::copy(src, src + skip_col, dst);
+            std::copy(src + skip_col + 1, src + n, dst + skip_col);
+        }
+        return submatrix;
+    }
+
+    double calculateDeterminantRecursive(ConstDenseMatrixView matrix) {
+        int n;
+        if (!isSquareMatrix(matrix, n)) {
+            throw std::invalid_argument("Determinant requires a square matrix.");
+        }
+        double det = 0.0;
+        if (dispatchSmallMatrix(n, [&](auto size) { det = SmallMatrix<decltype(size)::value>::fromView(matrix).determinant(); })) {
+            return det;
+        }
+        return luDecompose(matrix).determinant();
+    }
+
+    double calculateMinorDeterminant(ConstDenseMatrixView matrix, int skip_row, int skip_col) {
+        if (matrix.rows() == 1) {
+            return 1.0; // Convention: det(0x0 matrix) = 1 (minor of 1x1)
+        }
+        return calculateDeterminantRecursive(getSubmatrix(matrix, skip_row, skip_col));
+    }
+
+    DenseMatrix transposeMatrix(ConstDenseMatrixView matrix) {
+        if (matrix.empty()) {
+            return DenseMatrix();
+        }
+        DenseMatrix transposed(matrix.cols(), matrix.rows());
+        transposeInto(matrix, transposed);
+        return transposed;
+    }
+
+    DenseMatrix addMatrices(ConstDenseMatrixView matrix_a, ConstDenseMatrixView matrix_b) {
+        if (matrix_a.empty() || matrix_b.empty()) {
+            throw std::invalid_argument("Invalid input matrices for addition.");
+        }
+        if (matrix_a.rows() != matrix_b.rows() || matrix_a.cols() != matrix_b.cols()) {
+            throw std::invalid_argument("Matrices must have the same dimensions for addition.");
+        }
+        return DenseMatrix(matrix_a + matrix_b); // One fused pass, see matrix_expression.h
+    }
+
+    DenseMatrix multiplyMatrixByScalar(ConstDenseMatrixView matrix, double scalar) {
+        if (matrix.empty()) {
+            return DenseMatrix();
+        }
+        return DenseMatrix(matrix * scalar);
+    }
+
+    DenseMatrix multiplyMatrices(ConstDenseMatrixView matrix_a, ConstDenseMatrixView matrix_b) {
+        if (matrix_a.empty() || matrix_b.empty()) {
+            throw std::invalid_argument("Invalid input matrices for multiplication.");
+        }
+        if (matrix_a.cols() != matrix_b.rows()) {
+            throw std::invalid_argument("Incompatible dimensions for matrix multiplication (A.cols != B.rows).");
+        }
+        DenseMatrix result(matrix_a.rows(), matrix_b.cols());
+        activeMatrixBackend().gemm(1.0, matrix_a, matrix_b, 0.0, result); // Built-in blocked kernel or vendor BLAS
+        return result;
+    }
+
+    DenseMatrix calculateCofactorMatrix(ConstDenseMatrixView matrix) {
+        DenseMatrix cofactors = calculateAdjointMatrix(matrix);
+        transposeInPlace(cofactors); // C = adj(A)^T, reusing adj's storage
+        return cofactors;
+    }
+
+    DenseMatrix calculateAdjointMatrix(ConstDenseMatrixView matrix) {
+        int n;
+        if (!isSquareMatrix(matrix, n)) {
+            throw std::invalid_argument("Adjoint matrix requires a square matrix.");
+        }
+        DenseMatrix adj;
+        if (dispatchSmallMatrix(n, [&](auto size) { adj = SmallMatrix<decltype(size)::value>::fromView(matrix).adjugate().toDense(); })) {
+            return adj;
+        }
+        return calculateAdjointMatrix(matrix, luDecompose(matrix));
+    }
+
+    DenseMatrix calculateAdjointMatrix(ConstDenseMatrixView matrix, const LUDecomposition& lu) {
+        if (!lu.singular) {
+            // adj(A) = det(A) * A^-1: n triangular solves on the existing factorization
+            return calculateAdjointFromInverse(lu.inverse(), lu.determinant());
+        }
+        // No inverse to scale; fall back to one LU determinant per minor
+        const int n = lu.n;
+        DenseMatrix adj(n, n);
         for (int r = 0; r < n; ++r) {
             for (int c = 0; c < n; ++c) {
-                Matrix sub = getSubmatrix(matrix, r, c);
-                double minor = calculateDeterminantRecursive(sub);
-                double sign = ((r + c) % 2 == 0) ? 1.0 : -1.0;
-                cofactors[r][c] = sign * minor;
+                double minor = calculateMinorDeterminant(matrix, r, c);
+                adj(c, r) = ((r + c) % 2 == 0) ? minor : -minor;
             }
         }
-        return cofactors;
+        return adj;
     }
 
-    Matrix calculateAdjointMatrix(const Matrix& matrix) {
-        Matrix cofactor_matrix = calculateCofactorMatrix(matrix); // Handles square check
-        return transposeMatrix(cofactor_matrix);
+    DenseMatrix calculateAdjointFromInverse(DenseMatrix inverse, double determinant) {
+        for (int i = 0; i < inverse.rows(); ++i) {
+            double* row = inverse.row(i);
+            for (int j = 0; j < inverse.cols(); ++j) row[j] *= determinant;
+        }
+        return inverse;
+    }
+
+    namespace {
+
+        bool looksSymmetricPositiveDiagonal(ConstDenseMatrixView a) {
+            for (int i = 0; i < a.rows(); ++i) {
+                if (!(a(i, i) > 0.0)) return false;
+                for (int j = 0; j < i; ++j) {
+                    if (a(i, j) != a(j, i)) return false;
+                }
+            }
+            return true;
+        }
+
+        DenseMatrix solveWith(ConstDenseMatrixView a, ConstDenseMatrixView b, SolveMethod method, SolveMethod& used) {
+            int rows, cols;
+            if (!isValidMatrix(a, rows, cols)) {
+                throw std::invalid_argument("Invalid coefficient matrix for solve.");
+            }
+            if (b.rows() != rows || b.cols() == 0) {
+                throw std::invalid_argument("Right-hand side rows do not match the coefficient matrix.");
+            }
+            if (method == SolveMethod::Auto) {
+                if (rows != cols) {
+                    method = SolveMethod::QR;
+                } else if (looksSymmetricPositiveDiagonal(a)) {
+                    CholeskyDecomposition chol = choleskyDecompose(a);
+                    if (chol.positive_definite) {
+                        used = SolveMethod::Cholesky;
+                        return chol.solve(b);
+                    }
+                    method = SolveMethod::LU; // Symmetric but indefinite
+                } else {
+                    method = SolveMethod::LU;
+                }
+            }
+            used = method;
+            switch (method) {
+                case SolveMethod::Cholesky: {
+                    CholeskyDecomposition chol = choleskyDecompose(a);
+                    if (!chol.positive_definite) {
+                        throw std::runtime_error("Matrix is not positive definite; Cholesky factorization failed.");
+                    }
+                    return chol.solve(b);
+                }
+                case SolveMethod::QR:
+                    return qrDecompose(a).solve(b);
+                case SolveMethod::MixedPrecision:
+                    if (rows != cols) {
+                        throw std::invalid_argument("Mixed-precision solve requires a square matrix.");
+                    }
+                    return solveMixedPrecision(a, b).x;
+                default:
+                    if (rows != cols) {
+                        throw std::invalid_argument("LU solve requires a square matrix; use QR for least squares.");
+                    }
+                    return luDecompose(a).solve(b);
+            }
+        }
+
+    } // namespace
+
+    DenseMatrix solve(ConstDenseMatrixView a, ConstDenseMatrixView b, SolveMethod method) {
+        SolveMethod used;
+        return solveWith(a, b, method, used);
     }
 
     // --- "API"-like Functions ---
@@ -207,6 +409,12 @@ namespace MatrixUtils {
     }
 
     MatrixEqualityResponse compareMatrices(const TwoMatrixInput& input) {
+        ComparisonOptions options;
+        options.tolerance = MATRIX_EPSILON;
+        return compareMatrices(input, options);
+    }
+
+    MatrixEqualityResponse compareMatrices(const TwoMatrixInput& input, const ComparisonOptions& options) {
         int rows_a, cols_a, rows_b, cols_b;
         bool valid_a = isValidMatrix(input.matrix_a, rows_a, cols_a);
         bool valid_b = isValidMatrix(input.matrix_b, rows_b, cols_b);
@@ -220,18 +428,25 @@ namespace MatrixUtils {
             return {false, "Matrices have different dimensions.", dim_a_str, dim_b_str};
         }
 
-        // Element-wise comparison with tolerance
+        // Vectorised kernel over the row pointers; the reason is formatted once, afterwards
+        std::vector<const double*> a_rows(rows_a), b_rows(rows_b);
         for (int i = 0; i < rows_a; ++i) {
-            for (int j = 0; j < cols_a; ++j) {
-                if (std::fabs(input.matrix_a[i][j] - input.matrix_b[i][j]) > MATRIX_EPSILON) {
-                     std::ostringstream reason_ss;
-                     reason_ss << "Element mismatch at row " << i << ", column " << j
-                               << " (" << input.matrix_a[i][j] << " != " << input.matrix_b[i][j] << ").";
-                    return {false, reason_ss.str(), dim_a_str, dim_b_str};
-                }
-            }
+            a_rows[i] = input.matrix_a[i].data();
+            b_rows[i] = input.matrix_b[i].data();
         }
-        return {true, "Matrices are identical.", dim_a_str, dim_b_str};
+        ComparisonResult cmp = compareElements(a_rows.data(), b_rows.data(), rows_a, cols_a, options);
+        MatrixEqualityResponse response{cmp.equal, "Matrices are identical.", dim_a_str, dim_b_str};
+        response.mismatch_count = cmp.mismatches;
+        response.max_abs_error = cmp.max_abs_error;
+        response.first_mismatch_row = cmp.first_row;
+        response.first_mismatch_col = cmp.first_col;
+        if (!cmp.equal) {
+            std::ostringstream reason_ss;
+            reason_ss << "Element mismatch at row " << cmp.first_row << ", column " << cmp.first_col << " ("
+                      << cmp.first_a << " != " << cmp.first_b << ").";
+            response.reason = reason_ss.str();
+        }
+        return response;
     }
 
     MatrixResponse addMatricesAPI(const TwoMatrixInput& input) {
@@ -263,21 +478,30 @@ namespace MatrixUtils {
          if (!isSquareMatrix(input.matrix, n)) {
              throw std::invalid_argument("Minors/Cofactors require a square matrix.");
          }
-         // Calculate cofactors (which internally calculates minors via determinants)
-         Matrix cofactors = calculateCofactorMatrix(input.matrix);
-         Matrix minors(n, std::vector<double>(n));
+         // One factorization yields det and adj(A); cofactors are adj^T and minors differ by sign
+         DenseMatrix adj;
+         double det = 0.0;
+         bool small = dispatchSmallMatrix(n, [&](auto size) {
+             auto a = SmallMatrix<decltype(size)::value>::fromRows(input.matrix);
+             det = a.determinant();
+             adj = a.adjugate().toDense();
+         });
+         if (!small) {
+             DenseMatrix dense(input.matrix);
+             LUDecomposition lu = luDecompose(dense);
+             det = lu.determinant();
+             adj = calculateAdjointMatrix(dense, lu);
+         }
 
-         // Re-calculate minors explicitly for the response structure
-         // or modify calculateCofactorMatrix to return both if performance is critical
+         Matrix minors(n, std::vector<double>(n));
+         Matrix cofactors(n, std::vector<double>(n));
          for (int r = 0; r < n; ++r) {
             for (int c = 0; c < n; ++c) {
-                 Matrix sub = getSubmatrix(input.matrix, r, c);
-                 minors[r][c] = calculateDeterminantRecursive(sub);
+                 cofactors[r][c] = adj(c, r);
+                 minors[r][c] = ((r + c) % 2 == 0) ? adj(c, r) : -adj(c, r);
             }
          }
 
-         double det = calculateDeterminantRecursive(input.matrix); // Recalculate determinant
-
          return {
              input.matrix,
              getDimensionString(input.matrix),
@@ -293,14 +517,47 @@ namespace MatrixUtils {
                 throw std::invalid_argument("Adjoint/Inverse require a square matrix.");
             }
 
-            Matrix adj = calculateAdjointMatrix(input.matrix); // Handles internal checks
-            double det = calculateDeterminantRecursive(input.matrix);
-
-            bool invertible = std::fabs(det) > MATRIX_EPSILON;
             std::optional<Matrix> inv_opt = std::nullopt; // std::nullopt represents absence of value
 
-            if (invertible) {
-                inv_opt = multiplyMatrixByScalar(adj, 1.0 / det);
+            // Closed-form adjugate for n <= 4: no factorization, no heap traffic until the result
+            AdjInvResponse small_response;
+            if (dispatchSmallMatrix(n, [&](auto size) {
+                    auto a = SmallMatrix<decltype(size)::value>::fromRows(input.matrix);
+                    double det = a.determinant();
+                    auto adj = a.adjugate();
+                    // Exact 1-norm condition number, ||A||_1 * ||adj(A)||_1 / |det|
+                    double condition = det == 0.0 ? std::numeric_limits<double>::infinity()
+                                                  : a.norm1() * adj.norm1() / std::fabs(det);
+                    bool invertible = condition <= 1.0 / std::numeric_limits<double>::epsilon();
+                    if (invertible) {
+                        inv_opt = (adj * (1.0 / det)).toMatrix();
+                    }
+                    small_response = {input.matrix, getDimensionString(input.matrix), det, invertible, condition,
+                                      adj.toMatrix(), inv_opt};
+                })) {
+                return small_response;
+            }
+
+            DenseMatrix dense(input.matrix);
+            LUDecomposition lu = luDecompose(dense);
+            double det = lu.determinant();
+
+            // Scale-invariant test: |det| says nothing about conditioning (det(0.1 * I) is
+            // 1e-100 at n = 100, yet that matrix is perfectly conditioned)
+            double rcond = lu.reciprocalConditionEstimate();
+            bool invertible = !lu.singular && rcond >= std::numeric_limits<double>::epsilon(); // As lu.invertible()
+            double condition = rcond > 0.0 ? 1.0 / rcond : std::numeric_limits<double>::infinity();
+
+            Matrix adj;
+            if (!lu.singular) {
+                // One set of triangular solves serves both the inverse and adj = det * inverse
+                DenseMatrix inverse = lu.inverse();
+                if (invertible) {
+                    inv_opt = inverse.toMatrix();
+                }
+                adj = calculateAdjointFromInverse(std::move(inverse), det).toMatrix();
+            } else {
+                adj = calculateAdjointMatrix(dense, lu).toMatrix();
             }
 
             return {
@@ -308,11 +565,83 @@ namespace MatrixUtils {
                 getDimensionString(input.matrix),
                 det,
                 invertible,
+                condition,
                 adj,
                 inv_opt // Assign the optional containing the matrix or nullopt
             };
       }
 
+    LinearSolveResponse solveLinearSystem(const TwoMatrixInput& input, SolveMethod method) {
+        int rows_a, cols_a, rows_b, cols_b;
+        if (!isValidMatrix(input.matrix_a, rows_a, cols_a) || !isValidMatrix(input.matrix_b, rows_b, cols_b)) {
+            throw std::invalid_argument("Invalid input matrices for solve.");
+        }
+        SolveMethod used;
+        DenseMatrix x = solveWith(DenseMatrix(input.matrix_a), DenseMatrix(input.matrix_b), method, used);
+        const char* name = used == SolveMethod::Cholesky         ? "cholesky"
+                           : used == SolveMethod::QR             ? "qr"
+                           : used == SolveMethod::MixedPrecision ? "mixed"
+                                                                 : "lu";
+        return {x.toMatrix(), name};
+    }
+
+    EigenResponse calculateEigenAPI(const MatrixInput& input) {
+        int n;
+        if (!isSquareMatrix(input.matrix, n)) {
+            throw std::invalid_argument("Eigenvalues require a non-empty square matrix.");
+        }
+        EigenResponse response;
+        response.input_matrix = input.matrix;
+        response.symmetric = true;
+        for (int i = 0; i < n && response.symmetric; ++i) {
+            for (int j = 0; j < i; ++j) {
+                if (input.matrix[i][j] != input.matrix[j][i]) {
+                    response.symmetric = false;
+                    break;
+                }
+            }
+        }
+        DenseMatrix a(input.matrix);
+        if (response.symmetric) {
+            SymmetricEigenDecomposition eig = symmetricEigenDecompose(a);
+            response.eigenvalues_real = eig.eigenvalues;
+            response.eigenvalues_imag.assign(n, 0.0);
+            response.eigenvectors = eig.eigenvectors.toMatrix();
+        } else {
+            for (const std::complex<double>& value : calculateEigenvalues(a)) {
+                response.eigenvalues_real.push_back(value.real());
+                response.eigenvalues_imag.push_back(value.imag());
+            }
+        }
+        return response;
+    }
+
+    SvdResponse calculateSingularValueDecompositionAPI(const MatrixInput& input) {
+        int rows, cols;
+        if (!isValidMatrix(input.matrix, rows, cols)) {
+            throw std::invalid_argument("Invalid input matrix for SVD.");
+        }
+        SingularValueDecomposition svd = singularValueDecompose(DenseMatrix(input.matrix));
+        SvdResponse response;
+        response.input_matrix = input.matrix;
+        response.singular_values = svd.singular_values;
+        response.u = svd.u.toMatrix();
+        response.v = svd.v.toMatrix();
+        response.rank = svd.rank();
+        response.condition_number = svd.conditionNumber();
+        return response;
+    }
+
+    MatrixResponse matrixPowerAPI(const MatrixInput& input, long long exponent) {
+        // matrixPower performs validation
+        return {matrixPower(input.matrix, exponent)};
+    }
+
+    MatrixResponse matrixExpAPI(const MatrixInput& input) {
+        // matrixExp performs validation
+        return {matrixExp(input.matrix)};
+    }
+
 
 } // namespace MatrixUtils
 
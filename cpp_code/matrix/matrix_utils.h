@@ -3,6 +3,20 @@
 #define MATRIX_UTILS_H
 
 #include "matrix_types.h" // Include the structures defined above
+#include "matrix_decompositions.h" // LUDecomposition and luDecompose
+#include "matrix_gemm.h" // Blocked GEMM kernel behind multiplyMatrices
+#include "matrix_transpose.h" // Cache-oblivious out-of-place and in-place transposes
+#include "matrix_backend.h" // Built-in or CBLAS kernels selected at build/run time
+#include "small_matrix.h" // Closed-form 1x1..4x4 paths the API dispatches to
+#include "matrix_batch.h" // Batched structure-of-arrays small-matrix kernels
+#include "sparse_matrix.h" // CSR/CSC storage with SpMV, SpGEMM, add and transpose
+#include "matrix_expression.h" // Lazy fused elementwise expressions (a + alpha * b - c)
+#include "matrix_file.h" // Binary matrix files: streaming writer, loader and zero-copy mmap views
+#include "matrix_eigen.h" // Symmetric eigendecomposition, general eigenvalues and Jacobi SVD
+#include "matrix_out_of_core.h" // Tiled GEMM over matrix files larger than memory
+#include "matrix_refinement.h" // Float LU with double-precision iterative refinement
+#include "matrix_functions.h" // Matrix power by repeated squaring, matrix exponential
+#include "matrix_compare.h" // Vectorised element comparison with absolute/relative/ULP tolerances
 #include <vector>
 #include <string>
 #include <stdexcept> // For standard exceptions
@@ -19,7 +33,8 @@ namespace MatrixUtils {
     Matrix getSubmatrix(const Matrix& matrix, int skip_row, int skip_col);
 
     // --- Core Calculation Functions ---
-    double calculateDeterminantRecursive(const Matrix& matrix); // Internal recursive helper
+    double calculateDeterminantRecursive(const Matrix& matrix); // Internal helper; name kept, now LU-based
+    double calculateMinorDeterminant(const Matrix& matrix, int skip_row, int skip_col);
     Matrix transposeMatrix(const Matrix& matrix);
     Matrix addMatrices(const Matrix& matrix_a, const Matrix& matrix_b);
     Matrix multiplyMatrixByScalar(const Matrix& matrix, double scalar);
@@ -27,16 +42,47 @@ namespace MatrixUtils {
     Matrix calculateCofactorMatrix(const Matrix& matrix); // Helper needed for adj/inv
     Matrix calculateAdjointMatrix(const Matrix& matrix); // Helper needed for inv
 
+    // --- DenseMatrix Overloads (contiguous storage; a DenseMatrix converts to a view for free) ---
+    bool isValidMatrix(ConstDenseMatrixView matrix, int& rows, int& cols); // O(1)
+    bool isSquareMatrix(ConstDenseMatrixView matrix, int& n);
+    std::string getDimensionString(ConstDenseMatrixView matrix);
+    DenseMatrix getSubmatrix(ConstDenseMatrixView matrix, int skip_row, int skip_col);
+    double calculateDeterminantRecursive(ConstDenseMatrixView matrix);
+    double calculateMinorDeterminant(ConstDenseMatrixView matrix, int skip_row, int skip_col);
+    DenseMatrix transposeMatrix(ConstDenseMatrixView matrix);
+    DenseMatrix addMatrices(ConstDenseMatrixView matrix_a, ConstDenseMatrixView matrix_b);
+    DenseMatrix multiplyMatrixByScalar(ConstDenseMatrixView matrix, double scalar);
+    DenseMatrix multiplyMatrices(ConstDenseMatrixView matrix_a, ConstDenseMatrixView matrix_b);
+    DenseMatrix calculateCofactorMatrix(ConstDenseMatrixView matrix);
+    DenseMatrix calculateAdjointMatrix(ConstDenseMatrixView matrix);
+    // adj(A) from an existing factorization of A; singular A falls back to per-minor determinants
+    DenseMatrix calculateAdjointMatrix(ConstDenseMatrixView matrix, const LUDecomposition& lu);
+    DenseMatrix calculateAdjointFromInverse(DenseMatrix inverse, double determinant);
+    // X with A * X = B for every column of B at once. For many solves against one A, keep the
+    // LUDecomposition / CholeskyDecomposition / QRDecomposition and call its solve instead.
+    DenseMatrix solve(ConstDenseMatrixView a, ConstDenseMatrixView b, SolveMethod method = SolveMethod::Auto);
+
     // --- "API"-like Functions (matching Python endpoints where possible) ---
 
     DeterminantResponse calculateDeterminant(const MatrixInput& input);
-    MatrixEqualityResponse compareMatrices(const TwoMatrixInput& input);
+    // Bareiss fraction-free elimination; entries must be integers (|x| <= 2^53 for doubles)
+    ExactDeterminantResponse calculateDeterminantExact(const MatrixInput& input);
+    ExactDeterminantResponse calculateDeterminantExact(const std::vector<std::vector<long long>>& matrix);
+    MatrixEqualityResponse compareMatrices(const TwoMatrixInput& input); // Absolute tolerance MATRIX_EPSILON
+    MatrixEqualityResponse compareMatrices(const TwoMatrixInput& input, const ComparisonOptions& options);
     MatrixResponse addMatricesAPI(const TwoMatrixInput& input);
     MatrixResponse multiplyMatrixByScalarAPI(const MatrixInput& matrixInput, double scalar);
     MatrixResponse multiplyMatricesAPI(const TwoMatrixInput& input);
     MatrixResponse transposeMatrixAPI(const MatrixInput& input);
     MinorsCofactorsResponse calculateMinorsAndCofactors(const MatrixInput& input);
     AdjInvResponse calculateAdjointAndInverse(const MatrixInput& input);
+    // matrix_a is A, matrix_b holds the right-hand sides as columns
+    LinearSolveResponse solveLinearSystem(const TwoMatrixInput& input, SolveMethod method = SolveMethod::Auto);
+    // Exactly symmetric input takes the symmetric path and also returns eigenvectors
+    EigenResponse calculateEigenAPI(const MatrixInput& input);
+    SvdResponse calculateSingularValueDecompositionAPI(const MatrixInput& input);
+    MatrixResponse matrixPowerAPI(const MatrixInput& input, long long exponent);
+    MatrixResponse matrixExpAPI(const MatrixInput& input);
 
     // NOTE: construct_matrix_from_formula is omitted due to complexity without external libraries.
 
@@ -0,0 +1,222 @@
+// File: small_matrix.h
+#ifndef SMALL_MATRIX_H
+#define SMALL_MATRIX_H
+
+#include "matrix_types.h"
+#include <stdexcept>
+#include <type_traits> // For std::integral_constant
+
+namespace MatrixUtils {
+
+    // Largest size handled by the closed-form SmallMatrix paths
+    constexpr int SMALL_MATRIX_MAX_N = 4;
+
+    // Fixed-size N x N matrix on the stack. Determinant, adjugate, inverse and product are
+    // unrolled closed forms (no pivoting, no allocation) and usable in constant expressions.
+    template <int N>
+    struct SmallMatrix {
+        static_assert(N >= 1 && N <= SMALL_MATRIX_MAX_N, "SmallMatrix supports 1x1 through 4x4");
+
+        double m[N][N] = {};
+
+        constexpr double& operator()(int r, int c) { return m[r][c]; }
+        constexpr double operator()(int r, int c) const { return m[r][c]; }
+
+        static constexpr SmallMatrix identity() {
+            SmallMatrix result;
+            for (int i = 0; i < N; ++i) result.m[i][i] = 1.0;
+            return result;
+        }
+
+        // Caller guarantees the source is N x N
+        static SmallMatrix fromRows(const Matrix& matrix) {
+            SmallMatrix result;
+            for (int r = 0; r < N; ++r) {
+                const double* src = matrix[r].data();
+                for (int c = 0; c < N; ++c) result.m[r][c] = src[c];
+            }
+            return result;
+        }
+
+        static SmallMatrix fromView(ConstDenseMatrixView matrix) {
+            SmallMatrix result;
+            for (int r = 0; r < N; ++r) {
+                const double* src = matrix.row(r);
+                for (int c = 0; c < N; ++c) result.m[r][c] = src[c];
+            }
+            return result;
+        }
+
+        Matrix toMatrix() const {
+            Matrix result(N, std::vector<double>(N));
+            for (int r = 0; r < N; ++r) {
+                for (int c = 0; c < N; ++c) result[r][c] = m[r][c];
+            }
+            return result;
+        }
+
+        DenseMatrix toDense() const {
+            DenseMatrix result(N, N);
+            for (int r = 0; r < N; ++r) {
+                for (int c = 0; c < N; ++c) result(r, c) = m[r][c];
+            }
+            return result;
+        }
+
+        constexpr SmallMatrix transpose() const {
+            SmallMatrix result;
+            for (int r = 0; r < N; ++r) {
+                for (int c = 0; c < N; ++c) result.m[c][r] = m[r][c];
+            }
+            return result;
+        }
+
+        constexpr double determinant() const {
+            if constexpr (N == 1) {
+                return m[0][0];
+            } else if constexpr (N == 2) {
+                return m[0][0] * m[1][1] - m[0][1] * m[1][0];
+            } else if constexpr (N == 3) {
+                return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+                     - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+                     + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+            } else {
+                // Laplace expansion over the 2x2 minors of the top and bottom row pairs
+                double s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+                double s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+                double s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+                double s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+                double s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+                double s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+                double c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+                double c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+                double c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+                double c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+                double c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+                double c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+                return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+            }
+        }
+
+        // adj(A) = C^T; defined (and exact in form) for singular A too
+        constexpr SmallMatrix adjugate() const {
+            SmallMatrix b;
+            if constexpr (N == 1) {
+                b.m[0][0] = 1.0; // Convention: det of the empty minor is 1
+            } else if constexpr (N == 2) {
+                b.m[0][0] = m[1][1];
+                b.m[0][1] = -m[0][1];
+                b.m[1][0] = -m[1][0];
+                b.m[1][1] = m[0][0];
+            } else if constexpr (N == 3) {
+                b.m[0][0] = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+                b.m[0][1] = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+                b.m[0][2] = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+                b.m[1][0] = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+                b.m[1][1] = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+                b.m[1][2] = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+                b.m[2][0] = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+                b.m[2][1] = m[0][1] * m[2][0] - m[0][0] * m[2][1];
+                b.m[2][2] = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+            } else {
+                double s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+                double s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+                double s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+                double s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+                double s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+                double s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+                double c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+                double c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+                double c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+                double c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+                double c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+                double c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+                b.m[0][0] = m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3;
+                b.m[0][1] = -m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3;
+                b.m[0][2] = m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3;
+                b.m[0][3] = -m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3;
+                b.m[1][0] = -m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1;
+                b.m[1][1] = m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1;
+                b.m[1][2] = -m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1;
+                b.m[1][3] = m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1;
+                b.m[2][0] = m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0;
+                b.m[2][1] = -m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0;
+                b.m[2][2] = m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0;
+                b.m[2][3] = -m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0;
+                b.m[3][0] = -m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0;
+                b.m[3][1] = m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0;
+                b.m[3][2] = -m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0;
+                b.m[3][3] = m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0;
+            }
+            return b;
+        }
+
+        // ||A||_1, the largest absolute column sum. With A^-1 = adj(A) / det(A), the exact
+        // reciprocal condition number is |det| / (norm1() * adjugate().norm1()).
+        constexpr double norm1() const {
+            double result = 0.0;
+            for (int c = 0; c < N; ++c) {
+                double sum = 0.0;
+                for (int r = 0; r < N; ++r) sum += m[r][c] < 0.0 ? -m[r][c] : m[r][c];
+                result = sum > result ? sum : result;
+            }
+            return result;
+        }
+
+        // A^-1 = adj(A) / det(A). Throws only on an exactly zero determinant; tolerance checks are the caller's
+        constexpr SmallMatrix inverse() const {
+            double det = determinant();
+            if (det == 0.0) {
+                throw std::domain_error("Matrix is singular; inverse does not exist.");
+            }
+            return adjugate() * (1.0 / det);
+        }
+
+        friend constexpr SmallMatrix operator*(const SmallMatrix& a, const SmallMatrix& b) {
+            SmallMatrix result;
+            for (int i = 0; i < N; ++i) {
+                for (int k = 0; k < N; ++k) {
+                    double a_ik = a.m[i][k];
+                    for (int j = 0; j < N; ++j) result.m[i][j] += a_ik * b.m[k][j];
+                }
+            }
+            return result;
+        }
+
+        friend constexpr SmallMatrix operator*(const SmallMatrix& a, double scalar) {
+            SmallMatrix result;
+            for (int r = 0; r < N; ++r) {
+                for (int c = 0; c < N; ++c) result.m[r][c] = a.m[r][c] * scalar;
+            }
+            return result;
+        }
+
+        friend constexpr SmallMatrix operator+(const SmallMatrix& a, const SmallMatrix& b) {
+            SmallMatrix result;
+            for (int r = 0; r < N; ++r) {
+                for (int c = 0; c < N; ++c) result.m[r][c] = a.m[r][c] + b.m[r][c];
+            }
+            return result;
+        }
+    };
+
+    using SmallMatrix2 = SmallMatrix<2>;
+    using SmallMatrix3 = SmallMatrix<3>;
+    using SmallMatrix4 = SmallMatrix<4>;
+
+    // Calls fn(std::integral_constant<int, n>{}) for 1 <= n <= SMALL_MATRIX_MAX_N so runtime
+    // sizes can reach the fixed-size code; returns false (fn not called) for larger n.
+    template <typename Fn>
+    bool dispatchSmallMatrix(int n, Fn&& fn) {
+        switch (n) {
+            case 1: fn(std::integral_constant<int, 1>{}); return true;
+            case 2: fn(std::integral_constant<int, 2>{}); return true;
+            case 3: fn(std::integral_constant<int, 3>{}); return true;
+            case 4: fn(std::integral_constant<int, 4>{}); return true;
+            default: return false;
+        }
+    }
+
+} // namespace MatrixUtils
+
+#endif // SMALL_MATRIX_H
@@ -0,0 +1,422 @@
+// File: sparse_matrix.cc
+#include "sparse_matrix.h"
+#include "matrix_utils.h"
+#include "thread_pool.h"
+#include <algorithm> // For std::sort, std::upper_bound, std::min, std::max
+#include <cmath>     // For std::fabs
+#include <stdexcept>
+#include <utility>   // For std::move
+
+namespace MatrixUtils {
+
+    namespace {
+
+        // Nonzeros per parallel task below which splitting costs more than it saves
+        constexpr size_t SPARSE_TASK_NNZ = 1 << 16;
+
+        // Row boundaries [0, ..., rows] giving every task a similar number of nonzeros
+        std::vector<int> balancedRowSplits(const std::vector<size_t>& row_ptr, int rows, size_t work) {
+            const size_t max_tasks = static_cast<size_t>(getMatrixThreadCount()) * 4;
+            const size_t tasks = std::max<size_t>(1, std::min(max_tasks, work / SPARSE_TASK_NNZ));
+            std::vector<int> splits = {0};
+            const size_t nnz = row_ptr[rows];
+            for (size_t t = 1; t < tasks; ++t) {
+                size_t target = nnz / tasks * t;
+                int row = static_cast<int>(std::upper_bound(row_ptr.begin(), row_ptr.begin() + rows + 1, target) -
+                                           row_ptr.begin()) - 1;
+                if (row > splits.back()) splits.push_back(row);
+            }
+            splits.push_back(rows);
+            return splits;
+        }
+
+        template <typename Fn>
+        void forEachRowRange(const std::vector<int>& splits, Fn&& fn) {
+            const int tasks = static_cast<int>(splits.size()) - 1;
+            if (tasks == 1) {
+                fn(splits[0], splits[1]);
+                return;
+            }
+            matrixThreadPool().parallelFor(tasks, [&](int t) { fn(splits[t], splits[t + 1]); });
+        }
+
+        // Output rows of one task, stitched into the final CSR afterwards
+        struct RowBlock {
+            std::vector<size_t> counts;
+            std::vector<int> cols;
+            std::vector<double> values;
+        };
+
+        // Builds a rows x cols CSR. Each task gets its own emitter from make_emitter(), and
+        // emit_row(r, block) appends row r to the task's block in column order.
+        template <typename MakeEmitter>
+        CsrMatrix buildRowsParallel(int rows, int cols, const std::vector<int>& splits, MakeEmitter&& make_emitter) {
+            const int tasks = static_cast<int>(splits.size()) - 1;
+            std::vector<RowBlock> blocks(tasks);
+            matrixThreadPool().parallelFor(tasks, [&](int t) {
+                RowBlock& block = blocks[t];
+                auto emit_row = make_emitter();
+                for (int r = splits[t]; r < splits[t + 1]; ++r) {
+                    size_t before = block.values.size();
+                    emit_row(r, block);
+                    block.counts.push_back(block.values.size() - before);
+                }
+            });
+
+            std::vector<size_t> row_ptr(static_cast<size_t>(rows) + 1, 0);
+            size_t nnz = 0;
+            for (int t = 0; t < tasks; ++t) {
+                for (size_t i = 0; i < blocks[t].counts.size(); ++i) {
+                    nnz += blocks[t].counts[i];
+                    row_ptr[splits[t] + i + 1] = nnz;
+                }
+            }
+            std::vector<int> col_idx(nnz);
+            std::vector<double> values(nnz);
+            for (int t = 0; t < tasks; ++t) {
+                size_t offset = row_ptr[splits[t]];
+                std::copy(blocks[t].cols.begin(), blocks[t].cols.end(), col_idx.begin() + offset);
+                std::copy(blocks[t].values.begin(), blocks[t].values.end(), values.begin() + offset);
+                blocks[t] = RowBlock(); // Release as we go
+            }
+            return CsrMatrix(rows, cols, std::move(row_ptr), std::move(col_idx), std::move(values));
+        }
+
+        // Counting-sort transpose of compressed arrays: (major x minor) -> (minor x major)
+        void transposeCompressed(int major, int minor, const std::vector<size_t>& ptr, const std::vector<int>& idx,
+                                 const std::vector<double>& vals, std::vector<size_t>& out_ptr,
+                                 std::vector<int>& out_idx, std::vector<double>& out_vals) {
+            const size_t nnz = vals.size();
+            out_ptr.assign(static_cast<size_t>(minor) + 1, 0);
+            for (size_t k = 0; k < nnz; ++k) ++out_ptr[idx[k] + 1];
+            for (int i = 0; i < minor; ++i) out_ptr[i + 1] += out_ptr[i];
+            out_idx.resize(nnz);
+            out_vals.resize(nnz);
+            std::vector<size_t> next(out_ptr.begin(), out_ptr.end() - 1);
+            // Walking majors in order keeps every output segment sorted
+            for (int m = 0; m < major; ++m) {
+                for (size_t k = ptr[m]; k < ptr[m + 1]; ++k) {
+                    size_t dst = next[idx[k]]++;
+                    out_idx[dst] = m;
+                    out_vals[dst] = vals[k];
+                }
+            }
+        }
+
+        void validateCompressed(int major, int minor, const std::vector<size_t>& ptr, const std::vector<int>& idx,
+                                const std::vector<double>& vals) {
+            if (major < 0 || minor < 0) {
+                throw std::invalid_argument("Sparse matrix dimensions cannot be negative.");
+            }
+            if (ptr.size() != static_cast<size_t>(major) + 1 || ptr[0] != 0 || ptr.back() != vals.size() ||
+                idx.size() != vals.size()) {
+                throw std::invalid_argument("Sparse matrix index arrays have inconsistent sizes.");
+            }
+            for (int m = 0; m < major; ++m) {
+                if (ptr[m + 1] < ptr[m]) {
+                    throw std::invalid_argument("Sparse matrix offsets must be non-decreasing.");
+                }
+                for (size_t k = ptr[m]; k < ptr[m + 1]; ++k) {
+                    if (idx[k] < 0 || idx[k] >= minor || (k > ptr[m] && idx[k] <= idx[k - 1])) {
+                        throw std::invalid_argument("Sparse matrix indices must be in range and strictly increasing.");
+                    }
+                }
+            }
+        }
+
+    } // namespace
+
+    // --- CsrMatrix ---
+
+    CsrMatrix::CsrMatrix(int rows, int cols)
+        : CsrMatrix(rows, cols, std::vector<size_t>(static_cast<size_t>(rows < 0 ? 0 : rows) + 1, 0), {}, {}) {}
+
+    CsrMatrix::CsrMatrix(int rows, int cols, std::vector<size_t> row_ptr, std::vector<int> col_idx,
+                         std::vector<double> values)
+        : rows_(rows), cols_(cols), row_ptr_(std::move(row_ptr)), col_idx_(std::move(col_idx)), values_(std::move(values)) {
+        validateCompressed(rows_, cols_, row_ptr_, col_idx_, values_);
+    }
+
+    CsrMatrix CsrMatrix::fromTriplets(int rows, int cols, std::vector<SparseTriplet> triplets) {
+        for (const SparseTriplet& t : triplets) {
+            if (t.row < 0 || t.row >= rows || t.col < 0 || t.col >= cols) {
+                throw std::invalid_argument("Sparse triplet lies outside the matrix.");
+            }
+        }
+        std::sort(triplets.begin(), triplets.end(), [](const SparseTriplet& x, const SparseTriplet& y) {
+            return x.row != y.row ? x.row < y.row : x.col < y.col;
+        });
+        std::vector<size_t> row_ptr(static_cast<size_t>(rows) + 1, 0);
+        std::vector<int> col_idx;
+        std::vector<double> values;
+        col_idx.reserve(triplets.size());
+        values.reserve(triplets.size());
+        for (size_t k = 0; k < triplets.size(); ++k) {
+            const SparseTriplet& t = triplets[k];
+            if (k > 0 && t.row == triplets[k - 1].row && t.col == triplets[k - 1].col) {
+                values.back() += t.value;
+                continue;
+            }
+            col_idx.push_back(t.col);
+            values.push_back(t.value);
+            ++row_ptr[t.row + 1];
+        }
+        for (int r = 0; r < rows; ++r) row_ptr[r + 1] += row_ptr[r];
+        return CsrMatrix(rows, cols, std::move(row_ptr), std::move(col_idx), std::move(values));
+    }
+
+    CsrMatrix CsrMatrix::fromDense(ConstDenseMatrixView matrix, double drop_tolerance) {
+        std::vector<size_t> row_ptr(static_cast<size_t>(matrix.rows()) + 1, 0);
+        std::vector<int> col_idx;
+        std::vector<double> values;
+        for (int r = 0; r < matrix.rows(); ++r) {
+            const double* row = matrix.row(r);
+            for (int c = 0; c < matrix.cols(); ++c) {
+                if (std::fabs(row[c]) > drop_tolerance) {
+                    col_idx.push_back(c);
+                    values.push_back(row[c]);
+                }
+            }
+            row_ptr[r + 1] = values.size();
+        }
+        return CsrMatrix(matrix.rows(), matrix.cols(), std::move(row_ptr), std::move(col_idx), std::move(values));
+    }
+
+    CsrMatrix CsrMatrix::fromMatrix(const Matrix& matrix, double drop_tolerance) {
+        int rows, cols;
+        if (!isValidMatrix(matrix, rows, cols)) {
+            throw std::invalid_argument("Cannot build a sparse matrix from an invalid matrix.");
+        }
+        std::vector<size_t> row_ptr(static_cast<size_t>(rows) + 1, 0);
+        std::vector<int> col_idx;
+        std::vector<double> values;
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                if (std::fabs(matrix[r][c]) > drop_tolerance) {
+                    col_idx.push_back(c);
+                    values.push_back(matrix[r][c]);
+                }
+            }
+            row_ptr[r + 1] = values.size();
+        }
+        return CsrMatrix(rows, cols, std::move(row_ptr), std::move(col_idx), std::move(values));
+    }
+
+    double CsrMatrix::at(int r, int c) const {
+        auto begin = col_idx_.begin() + row_ptr_[r];
+        auto end = col_idx_.begin() + row_ptr_[r + 1];
+        auto it = std::lower_bound(begin, end, c);
+        return (it != end && *it == c) ? values_[it - col_idx_.begin()] : 0.0;
+    }
+
+    DenseMatrix CsrMatrix::toDense() const {
+        DenseMatrix dense(rows_, cols_);
+        for (int r = 0; r < rows_; ++r) {
+            for (size_t k = row_ptr_[r]; k < row_ptr_[r + 1]; ++k) dense(r, col_idx_[k]) = values_[k];
+        }
+        return dense;
+    }
+
+    Matrix CsrMatrix::toMatrix() const {
+        Matrix matrix(rows_, std::vector<double>(cols_, 0.0));
+        for (int r = 0; r < rows_; ++r) {
+            for (size_t k = row_ptr_[r]; k < row_ptr_[r + 1]; ++k) matrix[r][col_idx_[k]] = values_[k];
+        }
+        return matrix;
+    }
+
+    CscMatrix CsrMatrix::toCsc() const {
+        std::vector<size_t> col_ptr;
+        std::vector<int> row_idx;
+        std::vector<double> values;
+        transposeCompressed(rows_, cols_, row_ptr_, col_idx_, values_, col_ptr, row_idx, values);
+        return CscMatrix(rows_, cols_, std::move(col_ptr), std::move(row_idx), std::move(values));
+    }
+
+    // --- CscMatrix ---
+
+    CscMatrix::CscMatrix(int rows, int cols, std::vector<size_t> col_ptr, std::vector<int> row_idx,
+                         std::vector<double> values)
+        : rows_(rows), cols_(cols), col_ptr_(std::move(col_ptr)), row_idx_(std::move(row_idx)), values_(std::move(values)) {
+        validateCompressed(cols_, rows_, col_ptr_, row_idx_, values_);
+    }
+
+    CscMatrix CscMatrix::fromMatrix(const Matrix& matrix, double drop_tolerance) {
+        return CsrMatrix::fromMatrix(matrix, drop_tolerance).toCsc();
+    }
+
+    DenseMatrix CscMatrix::toDense() const {
+        DenseMatrix dense(rows_, cols_);
+        for (int c = 0; c < cols_; ++c) {
+            for (size_t k = col_ptr_[c]; k < col_ptr_[c + 1]; ++k) dense(row_idx_[k], c) = values_[k];
+        }
+        return dense;
+    }
+
+    Matrix CscMatrix::toMatrix() const {
+        return toDense().toMatrix();
+    }
+
+    CsrMatrix CscMatrix::toCsr() const {
+        std::vector<size_t> row_ptr;
+        std::vector<int> col_idx;
+        std::vector<double> values;
+        transposeCompressed(cols_, rows_, col_ptr_, row_idx_, values_, row_ptr, col_idx, values);
+        return CsrMatrix(rows_, cols_, std::move(row_ptr), std::move(col_idx), std::move(values));
+    }
+
+    // --- Sparse kernels ---
+
+    void spmv(double alpha, const CsrMatrix& a, const double* x, double beta, double* y) {
+        const std::vector<size_t>& row_ptr = a.rowPtr();
+        const int* col_idx = a.colIndices().data();
+        const double* values = a.values().data();
+        forEachRowRange(balancedRowSplits(row_ptr, a.rows(), a.nnz()), [&](int r0, int r1) {
+            for (int r = r0; r < r1; ++r) {
+                double sum = 0.0;
+                for (size_t k = row_ptr[r]; k < row_ptr[r + 1]; ++k) sum += values[k] * x[col_idx[k]];
+                y[r] = alpha * sum + (beta == 0.0 ? 0.0 : beta * y[r]);
+            }
+        });
+    }
+
+    std::vector<double> multiplyMatrixVector(const CsrMatrix& a, const std::vector<double>& x) {
+        if (static_cast<int>(x.size()) != a.cols()) {
+            throw std::invalid_argument("Vector length does not match the sparse matrix columns.");
+        }
+        std::vector<double> y(a.rows());
+        spmv(1.0, a, x.data(), 0.0, y.data());
+        return y;
+    }
+
+    std::vector<double> multiplyMatrixVector(const CscMatrix& a, const std::vector<double>& x) {
+        if (static_cast<int>(x.size()) != a.cols()) {
+            throw std::invalid_argument("Vector length does not match the sparse matrix columns.");
+        }
+        std::vector<double> y(a.rows(), 0.0);
+        const std::vector<size_t>& col_ptr = a.colPtr();
+        const std::vector<int>& row_idx = a.rowIndices();
+        const std::vector<double>& values = a.values();
+        for (int c = 0; c < a.cols(); ++c) {
+            double xc = x[c];
+            if (xc == 0.0) continue;
+            for (size_t k = col_ptr[c]; k < col_ptr[c + 1]; ++k) y[row_idx[k]] += values[k] * xc;
+        }
+        return y;
+    }
+
+    DenseMatrix multiplyMatrices(const CsrMatrix& a, ConstDenseMatrixView b) {
+        if (a.cols() != b.rows()) {
+            throw std::invalid_argument("Incompatible dimensions for matrix multiplication (A.cols != B.rows).");
+        }
+        DenseMatrix c(a.rows(), b.cols());
+        const std::vector<size_t>& row_ptr = a.rowPtr();
+        const std::vector<int>& col_idx = a.colIndices();
+        const std::vector<double>& values = a.values();
+        const int width = b.cols();
+        size_t work = a.nnz() * static_cast<size_t>(std::max(1, width / 8));
+        forEachRowRange(balancedRowSplits(row_ptr, a.rows(), work), [&](int r0, int r1) {
+            for (int r = r0; r < r1; ++r) {
+                double* c_r = c.row(r);
+                for (size_t k = row_ptr[r]; k < row_ptr[r + 1]; ++k) {
+                    const double v = values[k];
+                    const double* b_k = b.row(col_idx[k]);
+                    for (int j = 0; j < width; ++j) c_r[j] += v * b_k[j];
+                }
+            }
+        });
+        return c;
+    }
+
+    CsrMatrix multiplyMatrices(const CsrMatrix& a, const CsrMatrix& b) {
+        if (a.cols() != b.rows()) {
+            throw std::invalid_argument("Incompatible dimensions for matrix multiplication (A.cols != B.rows).");
+        }
+        const std::vector<size_t>& a_ptr = a.rowPtr();
+        const std::vector<int>& a_idx = a.colIndices();
+        const std::vector<double>& a_val = a.values();
+        const std::vector<size_t>& b_ptr = b.rowPtr();
+        const std::vector<int>& b_idx = b.colIndices();
+        const std::vector<double>& b_val = b.values();
+
+        // Flop count per row decides the split, not the nonzeros of A alone
+        std::vector<size_t> flops(static_cast<size_t>(a.rows()) + 1, 0);
+        for (int r = 0; r < a.rows(); ++r) {
+            size_t f = 0;
+            for (size_t k = a_ptr[r]; k < a_ptr[r + 1]; ++k) f += b_ptr[a_idx[k] + 1] - b_ptr[a_idx[k]];
+            flops[r + 1] = flops[r] + f;
+        }
+
+        const int out_cols = b.cols();
+        auto make_emitter = [&] {
+            // Gustavson: scatter rows of B scaled by A(r, k) into a dense per-task accumulator
+            return [&, accumulator = std::vector<double>(out_cols, 0.0), marker = std::vector<int>(out_cols, -1),
+                    touched = std::vector<int>()](int r, RowBlock& block) mutable {
+                touched.clear();
+                for (size_t k = a_ptr[r]; k < a_ptr[r + 1]; ++k) {
+                    const double v = a_val[k];
+                    const int j = a_idx[k];
+                    for (size_t q = b_ptr[j]; q < b_ptr[j + 1]; ++q) {
+                        int c = b_idx[q];
+                        if (marker[c] != r) {
+                            marker[c] = r;
+                            accumulator[c] = 0.0;
+                            touched.push_back(c);
+                        }
+                        accumulator[c] += v * b_val[q];
+                    }
+                }
+                std::sort(touched.begin(), touched.end());
+                for (int c : touched) {
+                    block.cols.push_back(c);
+                    block.values.push_back(accumulator[c]);
+                }
+            };
+        };
+        return buildRowsParallel(a.rows(), out_cols, balancedRowSplits(flops, a.rows(), flops.back()), make_emitter);
+    }
+
+    CsrMatrix addMatrices(const CsrMatrix& a, const CsrMatrix& b) {
+        if (a.rows() != b.rows() || a.cols() != b.cols()) {
+            throw std::invalid_argument("Matrices must have the same dimensions for addition.");
+        }
+        const std::vector<size_t>& a_ptr = a.rowPtr();
+        const std::vector<int>& a_idx = a.colIndices();
+        const std::vector<double>& a_val = a.values();
+        const std::vector<size_t>& b_ptr = b.rowPtr();
+        const std::vector<int>& b_idx = b.colIndices();
+        const std::vector<double>& b_val = b.values();
+
+        std::vector<size_t> work(static_cast<size_t>(a.rows()) + 1);
+        for (int r = 0; r <= a.rows(); ++r) work[r] = a_ptr[r] + b_ptr[r];
+
+        auto make_emitter = [&] {
+            return [&](int r, RowBlock& block) {
+                size_t i = a_ptr[r], j = b_ptr[r];
+                const size_t i_end = a_ptr[r + 1], j_end = b_ptr[r + 1];
+                while (i < i_end || j < j_end) {
+                    if (j == j_end || (i < i_end && a_idx[i] < b_idx[j])) {
+                        block.cols.push_back(a_idx[i]);
+                        block.values.push_back(a_val[i++]);
+                    } else if (i == i_end || b_idx[j] < a_idx[i]) {
+                        block.cols.push_back(b_idx[j]);
+                        block.values.push_back(b_val[j++]);
+                    } else {
+                        block.cols.push_back(a_idx[i]);
+                        block.values.push_back(a_val[i++] + b_val[j++]);
+                    }
+                }
+            };
+        };
+        return buildRowsParallel(a.rows(), a.cols(), balancedRowSplits(work, a.rows(), work.back()), make_emitter);
+    }
+
+    CsrMatrix transposeMatrix(const CsrMatrix& a) {
+        std::vector<size_t> row_ptr;
+        std::vector<int> col_idx;
+        std::vector<double> values;
+        transposeCompressed(a.rows(), a.cols(), a.rowPtr(), a.colIndices(), a.values(), row_ptr, col_idx, values);
+        return CsrMatrix(a.cols(), a.rows(), std::move(row_ptr), std::move(col_idx), std::move(values));
+    }
+
+} // namespace MatrixUtils
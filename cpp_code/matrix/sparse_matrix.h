@@ -0,0 +1,103 @@
+// File: sparse_matrix.h
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include "matrix_types.h"
+#include <cstddef> // For size_t
+#include <vector>
+
+namespace MatrixUtils {
+
+    // One (row, col, value) entry used to assemble a sparse matrix
+    struct SparseTriplet {
+        int row;
+        int col;
+        double value;
+    };
+
+    class CscMatrix;
+
+    // Compressed sparse row: the nonzeros of row r are values[row_ptr[r] .. row_ptr[r + 1]),
+    // with strictly increasing column indices in col_idx. Explicit zeros are allowed but
+    // never produced by the kernels below except where cancellation happens.
+    class CsrMatrix {
+    public:
+        CsrMatrix() = default;
+        CsrMatrix(int rows, int cols); // All-zero matrix
+        // Takes ownership of prepared arrays; throws if they are not a valid, sorted CSR
+        CsrMatrix(int rows, int cols, std::vector<size_t> row_ptr, std::vector<int> col_idx, std::vector<double> values);
+
+        // Duplicated (row, col) entries are summed
+        static CsrMatrix fromTriplets(int rows, int cols, std::vector<SparseTriplet> triplets);
+        // Keeps entries with |value| > drop_tolerance
+        static CsrMatrix fromDense(ConstDenseMatrixView matrix, double drop_tolerance = 0.0);
+        static CsrMatrix fromMatrix(const Matrix& matrix, double drop_tolerance = 0.0);
+
+        int rows() const { return rows_; }
+        int cols() const { return cols_; }
+        size_t nnz() const { return values_.size(); }
+        const std::vector<size_t>& rowPtr() const { return row_ptr_; }
+        const std::vector<int>& colIndices() const { return col_idx_; }
+        const std::vector<double>& values() const { return values_; }
+        std::vector<double>& values() { return values_; } // Pattern is fixed; values may change
+
+        double at(int r, int c) const; // O(log nnz(row)) lookup; 0.0 if not stored
+
+        DenseMatrix toDense() const;
+        Matrix toMatrix() const;
+        CscMatrix toCsc() const;
+
+    private:
+        int rows_ = 0;
+        int cols_ = 0;
+        std::vector<size_t> row_ptr_{0};
+        std::vector<int> col_idx_;
+        std::vector<double> values_;
+    };
+
+    // Compressed sparse column: the same layout with rows and columns exchanged. Column
+    // access is cheap, which suits A^T * x and column-oriented factorizations.
+    class CscMatrix {
+    public:
+        CscMatrix() = default;
+        CscMatrix(int rows, int cols, std::vector<size_t> col_ptr, std::vector<int> row_idx, std::vector<double> values);
+
+        static CscMatrix fromMatrix(const Matrix& matrix, double drop_tolerance = 0.0);
+
+        int rows() const { return rows_; }
+        int cols() const { return cols_; }
+        size_t nnz() const { return values_.size(); }
+        const std::vector<size_t>& colPtr() const { return col_ptr_; }
+        const std::vector<int>& rowIndices() const { return row_idx_; }
+        const std::vector<double>& values() const { return values_; }
+
+        DenseMatrix toDense() const;
+        Matrix toMatrix() const;
+        CsrMatrix toCsr() const;
+
+    private:
+        int rows_ = 0;
+        int cols_ = 0;
+        std::vector<size_t> col_ptr_{0};
+        std::vector<int> row_idx_;
+        std::vector<double> values_;
+    };
+
+    // --- Sparse kernels ---
+    // Row ranges are balanced by nonzero count and run on matrixThreadPool(); every output
+    // row is produced by exactly one task, so results match the serial order bit for bit.
+
+    // y = alpha * A * x + beta * y (x has a.cols() entries, y has a.rows())
+    void spmv(double alpha, const CsrMatrix& a, const double* x, double beta, double* y);
+    std::vector<double> multiplyMatrixVector(const CsrMatrix& a, const std::vector<double>& x);
+    // y = A * x for CSC storage (column scatter; serial)
+    std::vector<double> multiplyMatrixVector(const CscMatrix& a, const std::vector<double>& x);
+
+    DenseMatrix multiplyMatrices(const CsrMatrix& a, ConstDenseMatrixView b); // Sparse x dense
+    CsrMatrix multiplyMatrices(const CsrMatrix& a, const CsrMatrix& b);      // Gustavson SpGEMM
+    CsrMatrix addMatrices(const CsrMatrix& a, const CsrMatrix& b);           // Sorted row merge
+    CsrMatrix transposeMatrix(const CsrMatrix& a);
+
+} // namespace MatrixUtils
+
+#endif // SPARSE_MATRIX_H
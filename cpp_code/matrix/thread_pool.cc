@@ -0,0 +1,163 @@
+// File: thread_pool.cc
+#include "thread_pool.h"
+#include <algorithm> // For std::min, std::max
+#include <cstdlib>   // For std::getenv, std::atoi
+#include <stdexcept>
+
+namespace MatrixUtils {
+
+    namespace {
+        thread_local bool t_inside_pool = false;
+
+        std::mutex g_pool_mutex;
+        std::unique_ptr<WorkStealingPool> g_pool;
+
+        int defaultThreadCount() {
+            if (const char* env = std::getenv("NECTAR_MATRIX_THREADS")) {
+                int requested = std::atoi(env);
+                if (requested > 0) return requested;
+            }
+            unsigned hw = std::thread::hardware_concurrency();
+            return hw > 0 ? static_cast<int>(hw) : 1;
+        }
+    } // namespace
+
+    WorkStealingPool::WorkStealingPool(int thread_count)
+        : thread_count_(std::max(1, thread_count)) {
+        for (int i = 0; i < thread_count_; ++i) {
+            queues_.push_back(std::make_unique<WorkerQueue>());
+        }
+        for (int i = 1; i < thread_count_; ++i) {
+            threads_.emplace_back(&WorkStealingPool::workerLoop, this, i);
+        }
+    }
+
+    WorkStealingPool::~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            stopping_ = true;
+        }
+        work_ready_.notify_all();
+        for (std::thread& t : threads_) {
+            t.join();
+        }
+    }
+
+    void WorkStealingPool::parallelFor(int task_count, const std::function<void(int)>& task) {
+        if (task_count <= 0) {
+            return;
+        }
+        if (thread_count_ == 1 || task_count == 1 || t_inside_pool) {
+            for (int i = 0; i < task_count; ++i) task(i);
+            return;
+        }
+
+        std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+
+        // Contiguous runs keep neighbouring tiles on one worker until stealing kicks in
+        int chunk = (task_count + thread_count_ - 1) / thread_count_;
+        for (int w = 0; w < thread_count_; ++w) {
+            std::lock_guard<std::mutex> lock(queues_[w]->mutex);
+            for (int i = w * chunk; i < std::min(task_count, (w + 1) * chunk); ++i) {
+                queues_[w]->tasks.push_back(i);
+            }
+        }
+        pending_tasks_.store(task_count);
+        first_error_ = nullptr;
+
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            task_ = &task;
+            busy_workers_ = thread_count_ - 1;
+            ++generation_;
+        }
+        work_ready_.notify_all();
+
+        t_inside_pool = true;
+        runTasks(0);
+        t_inside_pool = false;
+
+        {
+            std::unique_lock<std::mutex> lock(state_mutex_);
+            work_done_.wait(lock, [this] { return busy_workers_ == 0; });
+            task_ = nullptr;
+        }
+        if (first_error_) {
+            std::rethrow_exception(first_error_);
+        }
+    }
+
+    void WorkStealingPool::workerLoop(int worker_index) {
+        t_inside_pool = true;
+        unsigned long seen_generation = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(state_mutex_);
+                work_ready_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+                if (stopping_) return;
+                seen_generation = generation_;
+            }
+            runTasks(worker_index);
+            {
+                std::lock_guard<std::mutex> lock(state_mutex_);
+                if (--busy_workers_ == 0) work_done_.notify_one();
+            }
+        }
+    }
+
+    void WorkStealingPool::runTasks(int worker_index) {
+        int task_index;
+        while (pending_tasks_.load(std::memory_order_acquire) > 0) {
+            if (!popLocal(worker_index, task_index) && !steal(worker_index, task_index)) {
+                break; // Everything left is already running on another worker
+            }
+            try {
+                (*task_)(task_index);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex_);
+                if (!first_error_) first_error_ = std::current_exception();
+            }
+            pending_tasks_.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    bool WorkStealingPool::popLocal(int worker_index, int& task_index) {
+        WorkerQueue& q = *queues_[worker_index];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) return false;
+        task_index = q.tasks.front();
+        q.tasks.pop_front();
+        return true;
+    }
+
+    bool WorkStealingPool::steal(int thief_index, int& task_index) {
+        for (int offset = 1; offset < thread_count_; ++offset) {
+            WorkerQueue& victim = *queues_[(thief_index + offset) % thread_count_];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task_index = victim.tasks.back(); // Take from the far end, away from the owner
+                victim.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    WorkStealingPool& matrixThreadPool() {
+        std::lock_guard<std::mutex> lock(g_pool_mutex);
+        if (!g_pool) {
+            g_pool = std::make_unique<WorkStealingPool>(defaultThreadCount());
+        }
+        return *g_pool;
+    }
+
+    void setMatrixThreadCount(int thread_count) {
+        std::lock_guard<std::mutex> lock(g_pool_mutex);
+        g_pool = std::make_unique<WorkStealingPool>(thread_count > 0 ? thread_count : defaultThreadCount());
+    }
+
+    int getMatrixThreadCount() {
+        return matrixThreadPool().threadCount();
+    }
+
+} // namespace MatrixUtils
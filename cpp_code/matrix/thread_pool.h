@@ -0,0 +1,72 @@
+// File: thread_pool.h
+#ifndef MATRIX_THREAD_POOL_H
+#define MATRIX_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MatrixUtils {
+
+    // Fixed-size pool whose parallelFor hands every worker a contiguous run of task
+    // indices; a worker that drains its own deque steals from the back of another's.
+    // The calling thread joins in as worker 0, so a pool of size 1 has no threads at all.
+    class WorkStealingPool {
+    public:
+        explicit WorkStealingPool(int thread_count);
+        ~WorkStealingPool();
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        int threadCount() const { return thread_count_; }
+
+        // Runs task(i) for every i in [0, task_count) and returns once all have finished.
+        // The first exception thrown by a task is rethrown here. Calls made from inside a
+        // task run serially on that thread.
+        void parallelFor(int task_count, const std::function<void(int)>& task);
+
+    private:
+        struct WorkerQueue {
+            std::mutex mutex;
+            std::deque<int> tasks;
+        };
+
+        void workerLoop(int worker_index);
+        void runTasks(int worker_index);
+        bool popLocal(int worker_index, int& task_index);
+        bool steal(int thief_index, int& task_index);
+
+        int thread_count_;
+        std::vector<std::thread> threads_;
+        std::vector<std::unique_ptr<WorkerQueue>> queues_;
+
+        std::mutex submit_mutex_; // One parallelFor at a time per pool
+        std::mutex state_mutex_;
+        std::condition_variable work_ready_;
+        std::condition_variable work_done_;
+        const std::function<void(int)>* task_ = nullptr;
+        unsigned long generation_ = 0;
+        int busy_workers_ = 0;
+        bool stopping_ = false;
+
+        std::atomic<int> pending_tasks_{0};
+        std::mutex error_mutex_;
+        std::exception_ptr first_error_;
+    };
+
+    // Shared pool used by the matrix kernels. Defaults to the NECTAR_MATRIX_THREADS
+    // environment variable, else std::thread::hardware_concurrency().
+    WorkStealingPool& matrixThreadPool();
+    void setMatrixThreadCount(int thread_count); // Not safe while matrix operations are running
+    int getMatrixThreadCount();
+
+} // namespace MatrixUtils
+
+#endif // MATRIX_THREAD_POOL_H
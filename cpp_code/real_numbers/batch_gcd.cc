@@ -0,0 +1,205 @@
+// File: batch_gcd.cc
+#include "batch_gcd.h"
+#include <algorithm> // For std::min, std::max, std::max_element
+#include <climits>   // For INT_MIN, INT_MAX, LLONG_MAX
+#include <stdexcept> // For std::overflow_error
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define REAL_NUMBERS_BATCH_GCD_AVX2 1
+#endif
+
+namespace michu_fr {
+namespace real_numbers {
+
+namespace {
+
+// gcdOf folds this many values into its lanes between checks for a gcd of 1
+constexpr std::size_t GCD_CHECK_INTERVAL = 256;
+
+// |x| as an unsigned value, so |INT_MIN| = 2^31 is representable
+uint32_t magnitude(int x) {
+    return x < 0 ? 0u - static_cast<uint32_t>(x) : static_cast<uint32_t>(x);
+}
+
+int checkedGcd(uint32_t g) {
+    if (g > static_cast<uint32_t>(INT_MAX)) { // Only 2^31 is possible
+        throw std::overflow_error("HCF is 2^31, which does not fit in an int.");
+    }
+    return static_cast<int>(g);
+}
+
+long long lcmOfMagnitudes(uint32_t a, uint32_t b) {
+    if (a == 0 || b == 0) return 0;
+    return static_cast<long long>(static_cast<uint64_t>(a / binaryGcd(a, b)) * b); // <= 2^62
+}
+
+#ifdef REAL_NUMBERS_BATCH_GCD_AVX2
+
+// Trailing zeros of each unsigned 32-bit lane: the lowest set bit converts to a float whose
+// exponent is its position. A zero lane gives a huge count, and a variable shift by a count
+// of 32 or more yields 0, so zero lanes stay zero.
+__m256i trailingZeros(__m256i x) {
+    const __m256i lowest = _mm256_and_si256(x, _mm256_sub_epi32(_mm256_setzero_si256(), x));
+    const __m256i exponent = _mm256_srli_epi32(_mm256_castps_si256(_mm256_cvtepi32_ps(lowest)), 23);
+    // 2^31 converts as -2^31: mask off the sign bit that lands above the exponent
+    return _mm256_sub_epi32(_mm256_and_si256(exponent, _mm256_set1_epi32(0xFF)), _mm256_set1_epi32(127));
+}
+
+// Lane-wise binary gcd of unsigned 32-bit values. The loop runs until every lane is done;
+// lanes that finish early are frozen by a mask rather than branched around.
+__m256i gcdLanes(__m256i a, __m256i b) {
+    const __m256i zero = _mm256_setzero_si256();
+    // gcd(0, x) = x: a zero lane takes the other value, and gcd(x, x) = x
+    a = _mm256_blendv_epi8(a, b, _mm256_cmpeq_epi32(a, zero));
+    b = _mm256_blendv_epi8(b, a, _mm256_cmpeq_epi32(b, zero));
+    const __m256i shift = trailingZeros(_mm256_or_si256(a, b));
+    a = _mm256_srlv_epi32(a, trailingZeros(a));
+    for (;;) {
+        const __m256i done = _mm256_cmpeq_epi32(b, zero);
+        if (_mm256_movemask_epi8(done) == -1) break;
+        b = _mm256_srlv_epi32(b, trailingZeros(b));
+        const __m256i low = _mm256_min_epu32(a, b);
+        const __m256i high = _mm256_max_epu32(a, b);
+        a = _mm256_blendv_epi8(low, a, done);
+        b = _mm256_andnot_si256(done, _mm256_sub_epi32(high, low));
+    }
+    return _mm256_sllv_epi32(a, shift);
+}
+
+__m256i loadMagnitudes(const int* values) {
+    return _mm256_abs_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values))); // INT_MIN -> 2^31
+}
+
+uint32_t reduceLanes(__m256i lanes) {
+    alignas(32) uint32_t values[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(values), lanes);
+    uint64_t g = 0;
+    for (uint32_t value : values) g = binaryGcd(g, value);
+    return static_cast<uint32_t>(g);
+}
+
+// Unsigned 32-bit lanes to doubles (the signed conversion, rebiased by 2^31)
+__m256d toDouble(__m128i x) {
+    const __m256d biased = _mm256_cvtepi32_pd(_mm_xor_si128(x, _mm_set1_epi32(INT_MIN)));
+    return _mm256_add_pd(biased, _mm256_set1_pd(2147483648.0));
+}
+
+// values mod divisors lane by lane, or the value where the divisor is 0. Both are below
+// 2^31 + 1, so the double quotient never rounds up to the next integer and q * d is exact.
+__m256i remainderLanes(__m256i values, __m256i divisors) {
+    __m128i halves[2];
+    for (int h = 0; h < 2; ++h) {
+        const __m128i v = h ? _mm256_extracti128_si256(values, 1) : _mm256_castsi256_si128(values);
+        const __m128i d = h ? _mm256_extracti128_si256(divisors, 1) : _mm256_castsi256_si128(divisors);
+        const __m256d dv = toDouble(v), dd = toDouble(d);
+        const __m256d quotient = _mm256_floor_pd(_mm256_div_pd(dv, dd));
+        halves[h] = _mm256_cvttpd_epi32(_mm256_sub_pd(dv, _mm256_mul_pd(quotient, dd))); // < d <= 2^31
+    }
+    const __m256i remainder = _mm256_set_m128i(halves[1], halves[0]);
+    return _mm256_blendv_epi8(remainder, values, _mm256_cmpeq_epi32(divisors, _mm256_setzero_si256()));
+}
+
+// lcm of four pairs from their magnitudes and gcds (gcd 0 only when both are 0). a / g is
+// exact in double and at most 2^31; the product is formed by a 32 x 32 -> 64-bit multiply.
+__m256i lcmFromGcd(__m128i a, __m128i b, __m128i g) {
+    const __m128i safe_g = _mm_max_epu32(g, _mm_set1_epi32(1)); // lcm(0, 0) = 0 / 1 * 0
+    const __m256d quotient = _mm256_div_pd(toDouble(a), toDouble(safe_g));
+    // Convert q - 2^31, which fits in an int, and flip the sign bit back
+    const __m128i q = _mm_xor_si128(_mm256_cvttpd_epi32(_mm256_sub_pd(quotient, _mm256_set1_pd(2147483648.0))),
+                                    _mm_set1_epi32(INT_MIN));
+    return _mm256_mul_epu32(_mm256_cvtepu32_epi64(q), _mm256_cvtepu32_epi64(b));
+}
+
+#endif // REAL_NUMBERS_BATCH_GCD_AVX2
+
+} // namespace
+
+void gcdOfPairs(const int* a, const int* b, int* out, std::size_t count) {
+    std::size_t i = 0;
+    uint32_t largest = 0; // Checked once at the end, so the loop has no branch on it
+#ifdef REAL_NUMBERS_BATCH_GCD_AVX2
+    __m256i largest_lanes = _mm256_setzero_si256();
+    for (; i + 8 <= count; i += 8) {
+        const __m256i g = gcdLanes(loadMagnitudes(a + i), loadMagnitudes(b + i));
+        largest_lanes = _mm256_max_epu32(largest_lanes, g);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), g);
+    }
+    alignas(32) uint32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), largest_lanes);
+    largest = *std::max_element(lanes, lanes + 8);
+#endif
+    for (; i < count; ++i) {
+        const uint32_t g = static_cast<uint32_t>(binaryGcd(magnitude(a[i]), magnitude(b[i])));
+        largest = std::max(largest, g);
+        out[i] = static_cast<int>(g);
+    }
+    checkedGcd(largest);
+}
+
+void lcmOfPairs(const int* a, const int* b, long long* out, std::size_t count) {
+    std::size_t i = 0;
+#ifdef REAL_NUMBERS_BATCH_GCD_AVX2
+    for (; i + 8 <= count; i += 8) {
+        const __m256i abs_a = loadMagnitudes(a + i);
+        const __m256i abs_b = loadMagnitudes(b + i);
+        const __m256i g = gcdLanes(abs_a, abs_b);
+        const __m256i low = lcmFromGcd(_mm256_castsi256_si128(abs_a), _mm256_castsi256_si128(abs_b),
+                                       _mm256_castsi256_si128(g));
+        const __m256i high = lcmFromGcd(_mm256_extracti128_si256(abs_a, 1), _mm256_extracti128_si256(abs_b, 1),
+                                        _mm256_extracti128_si256(g, 1));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 4), high);
+    }
+#endif
+    for (; i < count; ++i) out[i] = lcmOfMagnitudes(magnitude(a[i]), magnitude(b[i]));
+}
+
+int gcdOf(const int* values, std::size_t count) {
+    std::size_t i = 0;
+    uint64_t g = 0;
+#ifdef REAL_NUMBERS_BATCH_GCD_AVX2
+    // Eight running gcds over interleaved values, combined at each check. A running gcd is
+    // soon far smaller than the values, so each value is first reduced modulo it, which
+    // keeps the binary loop as short as the gcd is wide.
+    __m256i lanes = _mm256_setzero_si256();
+    while (i + 8 <= count) {
+        const std::size_t stop = std::min(count - (count - i) % 8, i + GCD_CHECK_INTERVAL);
+        for (; i < stop; i += 8) lanes = gcdLanes(lanes, remainderLanes(loadMagnitudes(values + i), lanes));
+        g = reduceLanes(lanes);
+        if (g == 1) return 1;
+    }
+#endif
+    for (; i < count && g != 1; ++i) g = binaryGcd(g, g ? magnitude(values[i]) % g : magnitude(values[i]));
+    return checkedGcd(static_cast<uint32_t>(g));
+}
+
+int gcdOf(const std::vector<int>& values) {
+    return gcdOf(values.data(), values.size());
+}
+
+long long lcmOf(const int* values, std::size_t count) {
+    uint64_t lcm = 1;
+    for (std::size_t i = 0; i < count; ++i) {
+        const uint32_t m = magnitude(values[i]);
+        if (m == 0) return 0;
+        // The running lcm soon dwarfs the values: one remainder brings the gcd down to
+        // m's size, where the binary loop is short
+        const uint64_t factor = m / binaryGcd(m, lcm % m);
+        if (__builtin_mul_overflow(lcm, factor, &lcm) || lcm > static_cast<uint64_t>(LLONG_MAX)) {
+            // A zero further on still makes the answer 0
+            for (std::size_t j = i + 1; j < count; ++j) {
+                if (values[j] == 0) return 0;
+            }
+            throw std::overflow_error("LCM of the values exceeds the range of long long.");
+        }
+    }
+    return static_cast<long long>(lcm);
+}
+
+long long lcmOf(const std::vector<int>& values) {
+    return lcmOf(values.data(), values.size());
+}
+
+} // namespace real_numbers
+} // namespace michu_fr
@@ -0,0 +1,56 @@
+// File: batch_gcd.h
+#ifndef REAL_NUMBERS_BATCH_GCD_H
+#define REAL_NUMBERS_BATCH_GCD_H
+
+#include <cstddef> // For size_t
+#include <cstdint>
+#include <utility> // For std::swap
+#include <vector>
+
+namespace michu_fr {
+namespace real_numbers {
+
+// gcd(a, b) by Stein's binary algorithm: common powers of two come out with one bit scan,
+// then the larger odd value is replaced by the difference with its trailing zeros
+// stripped. No division, and the loop body is a handful of ALU ops. gcd(0, b) = b.
+inline uint64_t binaryGcd(uint64_t a, uint64_t b) {
+    if (a == 0) return b;
+    if (b == 0) return a;
+    const int shift = __builtin_ctzll(a | b);
+    a >>= __builtin_ctzll(a);
+    do {
+        b >>= __builtin_ctzll(b);
+        if (a > b) std::swap(a, b);
+        b -= a;
+    } while (b != 0);
+    return a << shift;
+}
+
+// Batch HCF/LCM over arrays of ints. Signs are ignored, as with std::gcd, and no result
+// object is built: these are the kernels for reducing millions of numbers, where
+// euclidsAlgorithmHCF and calculateLCM are for reporting on one pair. With AVX2 the binary
+// gcd runs on eight pairs at once (trailing zeros counted through the float exponent);
+// elsewhere it runs one pair at a time.
+
+// out[i] = gcd(a[i], b[i]) for i < count, with gcd(0, 0) = 0. out may alias a or b.
+// Throws std::overflow_error if a gcd is 2^31 (INT_MIN against 0 or itself).
+void gcdOfPairs(const int* a, const int* b, int* out, std::size_t count);
+
+// out[i] = lcm(a[i], b[i]) for i < count: 0 if either is 0 (calculateLCM throws for
+// (0, 0) instead). Always fits in a long long.
+void lcmOfPairs(const int* a, const int* b, long long* out, std::size_t count);
+
+// gcd of all the values; 0 if there are none or all are 0. Returns as soon as a prefix has
+// gcd 1. Throws std::overflow_error if the gcd is 2^31.
+int gcdOf(const int* values, std::size_t count);
+int gcdOf(const std::vector<int>& values);
+
+// lcm of all the values; 1 if there are none, 0 if any is 0. Throws std::overflow_error
+// once the running lcm would pass LLONG_MAX.
+long long lcmOf(const int* values, std::size_t count);
+long long lcmOf(const std::vector<int>& values);
+
+} // namespace real_numbers
+} // namespace michu_fr
+
+#endif // REAL_NUMBERS_BATCH_GCD_H
@@ -0,0 +1,206 @@
+// File: factorization64.cc
+#include "factorization64.h"
+#include "batch_gcd.h" // For binaryGcd
+#include <algorithm> // For std::min
+#include <array>
+#include <stdexcept> // For std::invalid_argument
+#include <vector>
+
+namespace michu_fr {
+namespace real_numbers {
+
+namespace {
+
+__extension__ typedef unsigned __int128 uint128_t; // GCC/Clang; __extension__ keeps -pedantic quiet
+
+// Trial division covers the odd primes below this bound; a cofactor below its square is prime
+constexpr uint32_t TRIAL_DIVISION_BOUND = 1u << 10;
+
+// Rho steps multiplied together between gcds; a failed block is replayed one step at a time
+constexpr int RHO_BLOCK = 128;
+
+// Sinclair's bases: no 64-bit composite passes all seven
+constexpr std::array<uint64_t, 7> MILLER_RABIN_BASES = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+
+const std::vector<uint32_t>& smallOddPrimes() {
+    static const std::vector<uint32_t> primes = [] {
+        std::vector<bool> composite(TRIAL_DIVISION_BOUND, false);
+        std::vector<uint32_t> result;
+        for (uint32_t i = 3; i < TRIAL_DIVISION_BOUND; i += 2) {
+            if (composite[i]) continue;
+            result.push_back(i);
+            for (uint32_t j = i * i; j < TRIAL_DIVISION_BOUND; j += 2 * i) composite[j] = true;
+        }
+        return result;
+    }();
+    return primes;
+}
+
+// Arithmetic modulo an odd n on values kept as x * 2^64 mod n, so a product needs two
+// multiplies and a subtraction instead of a 128-by-64-bit division.
+class Montgomery {
+public:
+    explicit Montgomery(uint64_t n) : n_(n) {
+        // n^-1 mod 2^64 by Newton's iteration; each step doubles the correct low bits
+        inverse_ = n;
+        for (int i = 0; i < 5; ++i) inverse_ *= 2 - n * inverse_;
+        const uint64_t r = (0 - n) % n; // 2^64 mod n
+        r_squared_ = static_cast<uint64_t>(static_cast<uint128_t>(r) * r % n);
+        one_ = r;
+    }
+
+    uint64_t modulus() const { return n_; }
+    uint64_t one() const { return one_; }
+    uint64_t toMontgomery(uint64_t x) const { return multiply(x % n_, r_squared_); }
+
+    // x * y / 2^64 mod n, in [0, n)
+    uint64_t multiply(uint64_t x, uint64_t y) const {
+        const uint128_t t = static_cast<uint128_t>(x) * y;
+        const uint64_t m = static_cast<uint64_t>(t) * inverse_;
+        const uint64_t high = static_cast<uint64_t>(t >> 64);
+        const uint64_t correction = static_cast<uint64_t>((static_cast<uint128_t>(m) * n_) >> 64);
+        return high >= correction ? high - correction : high - correction + n_;
+    }
+
+    uint64_t add(uint64_t x, uint64_t y) const {
+        const uint64_t sum = x + y;
+        return (sum < x || sum >= n_) ? sum - n_ : sum;
+    }
+
+    uint64_t power(uint64_t base, uint64_t exponent) const {
+        uint64_t result = one_;
+        while (exponent > 0) {
+            if (exponent & 1) result = multiply(result, base);
+            base = multiply(base, base);
+            exponent >>= 1;
+        }
+        return result;
+    }
+
+private:
+    uint64_t n_;
+    uint64_t inverse_;   // n^-1 mod 2^64
+    uint64_t r_squared_; // 2^128 mod n
+    uint64_t one_;       // 1 in Montgomery form
+};
+
+// Strong probable-prime test of odd n > 2 to base a
+bool passesMillerRabin(const Montgomery& mont, uint64_t a, uint64_t d, int s) {
+    const uint64_t n = mont.modulus();
+    a %= n;
+    if (a == 0) return true; // The base is a multiple of n: no information
+    const uint64_t minus_one = n - mont.one(); // -1 in Montgomery form
+    uint64_t x = mont.power(mont.toMontgomery(a), d);
+    if (x == mont.one() || x == minus_one) return true;
+    for (int i = 1; i < s; ++i) {
+        x = mont.multiply(x, x);
+        if (x == minus_one) return true;
+        if (x == mont.one()) return false;
+    }
+    return false;
+}
+
+bool isOddPrime(uint64_t n) {
+    const Montgomery mont(n);
+    const int s = __builtin_ctzll(n - 1);
+    const uint64_t d = (n - 1) >> s;
+    for (uint64_t a : MILLER_RABIN_BASES) {
+        if (!passesMillerRabin(mont, a, d, s)) return false;
+    }
+    return true;
+}
+
+uint64_t absoluteDifference(uint64_t x, uint64_t y) {
+    return x > y ? x - y : y - x;
+}
+
+// A nontrivial factor of the odd composite n (Brent 1980, with Pollard's batched gcds)
+uint64_t pollardBrent(uint64_t n) {
+    const Montgomery mont(n);
+    for (uint64_t increment = 1;; ++increment) {
+        const uint64_t c = mont.toMontgomery(increment);
+        auto step = [&](uint64_t x) { return mont.add(mont.multiply(x, x), c); };
+
+        uint64_t y = mont.toMontgomery(2), x = y, saved = y;
+        uint64_t product = mont.one();
+        uint64_t factor = 1;
+        for (uint64_t length = 1; factor == 1; length *= 2) {
+            x = y;
+            for (uint64_t i = 0; i < length; ++i) y = step(y);
+            for (uint64_t done = 0; done < length && factor == 1; done += RHO_BLOCK) {
+                saved = y;
+                const uint64_t block = std::min<uint64_t>(RHO_BLOCK, length - done);
+                for (uint64_t i = 0; i < block; ++i) {
+                    y = step(y);
+                    product = mont.multiply(product, absoluteDifference(x, y));
+                }
+                // The Montgomery factor 2^64 is coprime to n, so it does not change the gcd
+                factor = binaryGcd(product, n);
+            }
+        }
+        if (factor == n) {
+            // The block overshot (or the product hit 0): replay it one gcd at a time
+            do {
+                saved = step(saved);
+                factor = binaryGcd(absoluteDifference(x, saved), n);
+            } while (factor == 1);
+        }
+        if (factor != n) return factor;
+        // The cycle closed without separating the factors: try another polynomial
+    }
+}
+
+// Adds the prime factors of the odd n > 1, which has no prime factor below TRIAL_DIVISION_BOUND
+void splitInto(uint64_t n, PrimeFactors64& factors) {
+    if (n < static_cast<uint64_t>(TRIAL_DIVISION_BOUND) * TRIAL_DIVISION_BOUND || isOddPrime(n)) {
+        factors.add(n); // Rho finds primes in no particular order
+        return;
+    }
+    const uint64_t factor = pollardBrent(n);
+    splitInto(factor, factors);
+    splitInto(n / factor, factors);
+}
+
+} // namespace
+
+bool isPrimeMillerRabin(uint64_t n) {
+    if (n < 2) return false;
+    if (n % 2 == 0) return n == 2;
+    for (uint32_t p : smallOddPrimes()) {
+        if (n % p == 0) return n == p;
+        if (static_cast<uint64_t>(p) * p > n) return true;
+    }
+    return isOddPrime(n);
+}
+
+PrimeFactorization64Result getPrimeFactorization64(uint64_t n) {
+    if (n <= 1) {
+        throw std::invalid_argument("Number must be greater than 1 for prime factorization.");
+    }
+
+    PrimeFactors64 factors;
+    uint64_t num = n;
+    const int twos = __builtin_ctzll(num);
+    if (twos > 0) {
+        factors.append(2, twos);
+        num >>= twos;
+    }
+    for (uint32_t p : smallOddPrimes()) {
+        if (static_cast<uint64_t>(p) * p > num) break;
+        if (num % p == 0) {
+            int exponent = 0;
+            do {
+                num /= p;
+                ++exponent;
+            } while (num % p == 0);
+            factors.append(p, exponent);
+        }
+    }
+    if (num > 1) {
+        splitInto(num, factors);
+    }
+    return PrimeFactorization64Result(n, factors);
+}
+
+} // namespace real_numbers
+} // namespace michu_fr
@@ -0,0 +1,26 @@
+// File: factorization64.h
+#ifndef REAL_NUMBERS_FACTORIZATION64_H
+#define REAL_NUMBERS_FACTORIZATION64_H
+
+#include "real_numbers_types.h"
+#include <cstdint>
+
+namespace michu_fr {
+namespace real_numbers {
+
+// Deterministic for every 64-bit n: Miller-Rabin with the seven-base witness set of
+// Sinclair (2011), all arithmetic in Montgomery form. A few hundred nanoseconds per call.
+bool isPrimeMillerRabin(uint64_t n);
+
+// Prime factorization of any 64-bit n > 1 (throws std::invalid_argument otherwise).
+// Powers of two go by a bit scan and small primes by trial division; whatever is left is
+// split by Pollard-Brent rho (Montgomery multiplication, gcds batched over blocks of
+// steps) until Miller-Rabin certifies every piece. Rho needs about sqrt(p) steps to find
+// a prime factor p, so the cost is set by the second-largest prime factor: a few
+// microseconds for most inputs, about a millisecond for a product of two 32-bit primes.
+PrimeFactorization64Result getPrimeFactorization64(uint64_t n);
+
+} // namespace real_numbers
+} // namespace michu_fr
+
+#endif // REAL_NUMBERS_FACTORIZATION64_H
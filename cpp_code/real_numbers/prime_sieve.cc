@@ -0,0 +1,43 @@
+// File: prime_sieve.cc
+#include "prime_sieve.h"
+#include <stdexcept> // For std::invalid_argument
+
+namespace michu_fr {
+namespace real_numbers {
+
+namespace {
+
+// Limit of the shared table: factoring below it never divides, and 4 MB of uint16_t entries
+// stays resident in a typical L3 cache
+constexpr uint32_t SHARED_TABLE_LIMIT = 1u << 22;
+
+} // namespace
+
+SmallestPrimeFactorTable::SmallestPrimeFactorTable(uint32_t limit) : limit_(limit) {
+    if (limit < MIN_LIMIT || limit > MAX_LIMIT) {
+        throw std::invalid_argument("Smallest-prime-factor table limit must be between 2^16 and 2^31.");
+    }
+    spf_.assign(limit / 2 + 1, 0);
+    primes_.push_back(2);
+
+    // Linear sieve over odd numbers: i * p gets its smallest prime p exactly once, from the
+    // odd primes p up to the smallest prime factor of i
+    for (uint32_t i = 3; i <= limit; i += 2) {
+        const uint32_t lowest = spf_[i >> 1] ? spf_[i >> 1] : i;
+        if (lowest == i) primes_.push_back(i);
+        for (size_t k = 1; k < primes_.size(); ++k) {
+            const uint32_t p = primes_[k];
+            const uint64_t multiple = static_cast<uint64_t>(p) * i;
+            if (p > lowest || multiple > limit) break;
+            spf_[multiple >> 1] = static_cast<uint16_t>(p);
+        }
+    }
+}
+
+const SmallestPrimeFactorTable& sharedSmallestPrimeFactorTable() {
+    static const SmallestPrimeFactorTable table(SHARED_TABLE_LIMIT);
+    return table;
+}
+
+} // namespace real_numbers
+} // namespace michu_fr
@@ -0,0 +1,89 @@
+// File: prime_sieve.h
+#ifndef REAL_NUMBERS_PRIME_SIEVE_H
+#define REAL_NUMBERS_PRIME_SIEVE_H
+
+#include <cstddef> // For size_t
+#include <cstdint>
+#include <vector>
+
+namespace michu_fr {
+namespace real_numbers {
+
+// Smallest-prime-factor table over [2, limit], built once by a linear sieve (every composite
+// is written exactly once, by its smallest prime). Factoring n <= limit is then a chain of
+// lookups, one per prime factor with multiplicity; larger n are trial-divided by the table's
+// primes only until the cofactor falls inside the table. The table is immutable once built,
+// so one instance can be shared by any number of threads without locking.
+//
+// Storage is one uint16_t per odd number (powers of two are stripped with a bit scan): the
+// smallest prime factor of an odd composite n is at most sqrt(n) < 2^16, and 0 marks a prime.
+// The default shared table (limit 2^22) takes 4 MB.
+class SmallestPrimeFactorTable {
+public:
+    // Throws std::invalid_argument unless MIN_LIMIT <= limit <= MAX_LIMIT.
+    explicit SmallestPrimeFactorTable(uint32_t limit);
+
+    static constexpr uint32_t MIN_LIMIT = 1u << 16; // Its primes then cover sqrt of any int
+    static constexpr uint32_t MAX_LIMIT = 1u << 31;
+
+    uint32_t limit() const { return limit_; }
+    // All primes <= limit, ascending
+    const std::vector<uint32_t>& primes() const { return primes_; }
+
+    // Smallest prime factor of 2 <= n <= limit
+    uint32_t smallestPrimeFactor(uint32_t n) const {
+        if ((n & 1u) == 0) return 2;
+        const uint32_t p = spf_[n >> 1];
+        return p ? p : n;
+    }
+
+    // Calls visit(prime, exponent) for each prime factor of n >= 2, in ascending order.
+    template <typename Visit>
+    void forEachPrimeFactor(uint32_t n, Visit visit) const {
+        const int twos = __builtin_ctz(n);
+        if (twos > 0) {
+            visit(2u, twos);
+            n >>= twos;
+        }
+        // Above the table: trial division by odd primes until the cofactor fits in it
+        for (size_t i = 1; n > limit_; ++i) {
+            // Out of candidates: every prime below 2^16 has been tried, so what is left is prime
+            if (i == primes_.size() || static_cast<uint64_t>(primes_[i]) * primes_[i] > n) {
+                visit(n, 1);
+                return;
+            }
+            const uint32_t p = primes_[i];
+            if (n % p == 0) {
+                int exponent = 0;
+                do {
+                    n /= p;
+                    ++exponent;
+                } while (n % p == 0);
+                visit(p, exponent);
+            }
+        }
+        while (n > 1) {
+            const uint32_t p = smallestPrimeFactor(n);
+            int exponent = 0;
+            do {
+                n /= p;
+                ++exponent;
+            } while (n > 1 && smallestPrimeFactor(n) == p);
+            visit(p, exponent);
+        }
+    }
+
+private:
+    uint32_t limit_;
+    std::vector<uint16_t> spf_; // spf_[n / 2] for odd n; 0 for primes (and for 1)
+    std::vector<uint32_t> primes_;
+};
+
+// The process-wide table used by getHCFAndLCMDetails and getDecimalExpansionType. Built on
+// first use (thread-safe static initialisation) and read-only afterwards.
+const SmallestPrimeFactorTable& sharedSmallestPrimeFactorTable();
+
+} // namespace real_numbers
+} // namespace michu_fr
+
+#endif // REAL_NUMBERS_PRIME_SIEVE_H
@@ -8,8 +8,12 @@
 #include <optional>   // For std::optional (C++17)
 #include <iomanip>    // For std::fixed, std::setprecision
 #include <numeric>    // For std::gcd (C++17)
-#include <algorithm>  // For std::min, std::max
+#include <algorithm>  // For std::min, std::max, std::equal
+#include <array>
 #include <cmath>      // For std::abs, std::sqrt, std::pow
+#include <cstdint>    // For uint64_t
+#include <stdexcept>  // For std::length_error
+#include <utility>    // For std::pair
 
 namespace michu_fr {
 namespace real_numbers {
@@ -47,12 +51,78 @@ struct HCFResult {
     }
 };
 
+// A prime factorization held inline: up to Capacity (prime, exponent) pairs in ascending
+// order of prime, in a fixed array, so building, copying and merging one never allocates.
+// Elements are std::pair, so loops written against std::map<prime, exponent> still compile;
+// toMap() returns that map for code that needs one.
+template <typename Prime, int Capacity>
+class FactorList {
+public:
+    using value_type = std::pair<Prime, int>; // prime -> exponent
+    using const_iterator = const value_type*;
+
+    FactorList() = default;
+    // Implicit, so code that builds results from a map keeps compiling
+    FactorList(const std::map<Prime, int>& factors) {
+        for (const auto& factor : factors) append(factor.first, factor.second);
+    }
+
+    static constexpr int capacity() { return Capacity; }
+    int size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const_iterator begin() const { return factors_.data(); }
+    const_iterator end() const { return factors_.data() + size_; }
+    const value_type& operator[](int i) const { return factors_[i]; }
+
+    // Adds prime^exponent for a prime above every prime already held, the order in which
+    // factorizations find them. Throws std::length_error when the list is full.
+    void append(Prime prime, int exponent) {
+        if (size_ == Capacity) {
+            throw std::length_error("Factor list is full.");
+        }
+        factors_[size_++] = value_type(prime, exponent);
+    }
+
+    // Adds exponent to prime's, inserting prime in order if it is new; for producers that
+    // find primes out of order
+    void add(Prime prime, int exponent = 1) {
+        int i = size_;
+        while (i > 0 && factors_[i - 1].first > prime) --i;
+        if (i > 0 && factors_[i - 1].first == prime) {
+            factors_[i - 1].second += exponent;
+            return;
+        }
+        if (size_ == Capacity) {
+            throw std::length_error("Factor list is full.");
+        }
+        for (int j = size_; j > i; --j) factors_[j] = factors_[j - 1];
+        factors_[i] = value_type(prime, exponent);
+        ++size_;
+    }
+
+    std::map<Prime, int> toMap() const { return std::map<Prime, int>(begin(), end()); }
+
+    friend bool operator==(const FactorList& a, const FactorList& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+    friend bool operator!=(const FactorList& a, const FactorList& b) { return !(a == b); }
+
+private:
+    std::array<value_type, Capacity> factors_{};
+    int size_ = 0;
+};
+
+// Capacities: 2 * 3 * ... * 23 (nine primes) < 2^31 < 2 * 3 * ... * 29, and the product of
+// the first fifteen primes is below 2^64, of the first sixteen above it
+using PrimeFactors = FactorList<int, 9>;
+using PrimeFactors64 = FactorList<uint64_t, 15>;
+
 struct PrimeFactorizationResult {
     int number;
-    std::map<int, int> factors; // prime -> exponent
+    PrimeFactors factors; // prime -> exponent, ascending
 
-    PrimeFactorizationResult(int n, std::map<int, int> f)
-        : number(n), factors(std::move(f)) {}
+    PrimeFactorizationResult(int n, PrimeFactors f)
+        : number(n), factors(f) {}
     PrimeFactorizationResult() : number(0) {} // Default constructor if needed
 
     std::string toString() const {
@@ -71,17 +141,42 @@ struct PrimeFactorizationResult {
     }
 };
 
+// The same shape widened to 64 bits, for getPrimeFactorization64
+struct PrimeFactorization64Result {
+    uint64_t number;
+    PrimeFactors64 factors; // prime -> exponent, ascending
+
+    PrimeFactorization64Result(uint64_t n, PrimeFactors64 f)
+        : number(n), factors(f) {}
+    PrimeFactorization64Result() : number(0) {}
+
+    std::string toString() const {
+        std::ostringstream oss;
+        oss << "PrimeFactorization64Result{number=" << number << ", factors={";
+        bool first = true;
+        for (const auto& pair : factors) {
+            if (!first) {
+                oss << ", ";
+            }
+            oss << pair.first << ":" << pair.second;
+            first = false;
+        }
+        oss << "}}";
+        return oss.str();
+    }
+};
+
 struct HCFAndLCMResult {
     int num1;
     int num2;
-    std::map<int, int> prime_factorization_num1;
-    std::map<int, int> prime_factorization_num2;
+    PrimeFactors prime_factorization_num1;
+    PrimeFactors prime_factorization_num2;
     int hcf;
     long long lcm;
 
-    HCFAndLCMResult(int n1, int n2_val, std::map<int, int> pf1, std::map<int, int> pf2, int hcf_val, long long lcm_val)
-        : num1(n1), num2(n2_val), prime_factorization_num1(std::move(pf1)),
-          prime_factorization_num2(std::move(pf2)), hcf(hcf_val), lcm(lcm_val) {}
+    HCFAndLCMResult(int n1, int n2_val, PrimeFactors pf1, PrimeFactors pf2, int hcf_val, long long lcm_val)
+        : num1(n1), num2(n2_val), prime_factorization_num1(pf1),
+          prime_factorization_num2(pf2), hcf(hcf_val), lcm(lcm_val) {}
 
     std::string toString() const {
         std::ostringstream oss;
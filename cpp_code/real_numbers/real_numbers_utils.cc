@@ -5,6 +5,7 @@
 #include <algorithm> // For std::max, std::min
 #include <sstream>   // For std::ostringstream
 #include <iomanip>   // For std::fixed, std::setprecision
+#include <limits>    // For std::numeric_limits
 
 namespace michu_fr {
 namespace real_numbers {
@@ -46,71 +47,122 @@ PrimeFactorizationResult getPrimeFactorization(int n) {
         throw std::invalid_argument("Number must be greater than 1 for prime factorization.");
     }
 
-    std::map<int, int> factors_map;
+    PrimeFactors factors;
     int num = n;
 
+    int exponent = 0;
     while (num % 2 == 0) {
-        factors_map[2]++;
+        ++exponent;
         num /= 2;
     }
+    if (exponent > 0) {
+        factors.append(2, exponent);
+    }
 
-    for (int i = 3; i * i <= num; i += 2) {
+    for (int i = 3; i <= num / i; i += 2) { // i * i would overflow for primes near INT_MAX
+        exponent = 0;
         while (num % i == 0) {
-            factors_map[i]++;
+            ++exponent;
             num /= i;
         }
+        if (exponent > 0) {
+            factors.append(i, exponent);
+        }
     }
 
     if (num > 1) {
-        factors_map[num]++;
+        factors.append(num, 1);
     }
-    return PrimeFactorizationResult(n, factors_map);
+    return PrimeFactorizationResult(n, factors);
 }
 
-int hcfFromPrimeFactorization(const std::map<int, int>& factors1, const std::map<int, int>& factors2) {
-    int hcf_val = 1;
-    for (const auto& pair1 : factors1) {
-        int prime = pair1.first;
-        int power1 = pair1.second;
-        auto it2 = factors2.find(prime);
-        if (it2 != factors2.end()) {
-            int power2 = it2->second;
-            int common_power = std::min(power1, power2);
-            for (int i = 0; i < common_power; ++i) {
-                // Check for overflow before multiplication, though hcf is usually small
-                if (prime > 0 && hcf_val > std::numeric_limits<int>::max() / prime) {
-                    throw std::overflow_error("HCF calculation resulted in overflow.");
-                }
-                hcf_val *= prime;
-            }
-        }
+PrimeFactorizationResult getPrimeFactorization(int n, const SmallestPrimeFactorTable& table) {
+    if (n <= 1) {
+        throw std::invalid_argument("Number must be greater than 1 for prime factorization.");
     }
-    return hcf_val;
+
+    PrimeFactors factors;
+    // Primes arrive in ascending order, so each one is appended
+    table.forEachPrimeFactor(static_cast<uint32_t>(n), [&](uint32_t prime, int exponent) {
+        factors.append(static_cast<int>(prime), exponent);
+    });
+    return PrimeFactorizationResult(n, factors);
 }
 
-long long lcmFromPrimeFactorization(const std::map<int, int>& factors1, const std::map<int, int>& factors2) {
-    long long lcm_val = 1LL;
-    std::map<int, int> max_powers = factors1;
+namespace {
 
-    for (const auto& pair2 : factors2) {
-        int prime = pair2.first;
-        int power2 = pair2.second;
-        max_powers[prime] = std::max(max_powers.count(prime) ? max_powers[prime] : 0, power2);
+// value *= prime^exponent, throwing std::overflow_error(message) once value would pass limit
+void multiplyByPower(long long& value, long long prime, int exponent, long long limit, const char* message) {
+    for (int i = 0; i < exponent; ++i) {
+        if (prime > 0 && value > limit / prime) {
+            throw std::overflow_error(message);
+        }
+        value *= prime;
     }
+}
 
-    for (const auto& pair_max : max_powers) {
-        int prime = pair_max.first;
-        int max_power = pair_max.second;
-        for (int i = 0; i < max_power; ++i) {
-            if (prime > 0 && lcm_val > std::numeric_limits<long long>::max() / prime) {
-                 throw std::overflow_error("LCM calculation resulted in overflow during prime power multiplication.");
-            }
-            lcm_val *= prime;
+// Both factorizations are sorted by prime (a PrimeFactors or a std::map), so one merge pass
+// pairs up the common primes without any lookups
+template <typename Factors1, typename Factors2>
+int hcfByMerge(const Factors1& factors1, const Factors2& factors2) {
+    long long hcf_val = 1;
+    auto it1 = factors1.begin();
+    auto it2 = factors2.begin();
+    while (it1 != factors1.end() && it2 != factors2.end()) {
+        if (it1->first < it2->first) {
+            ++it1;
+        } else if (it2->first < it1->first) {
+            ++it2;
+        } else {
+            multiplyByPower(hcf_val, it1->first, std::min(it1->second, it2->second), std::numeric_limits<int>::max(),
+                            "HCF calculation resulted in overflow.");
+            ++it1;
+            ++it2;
+        }
+    }
+    return static_cast<int>(hcf_val);
+}
+
+template <typename Factors1, typename Factors2>
+long long lcmByMerge(const Factors1& factors1, const Factors2& factors2) {
+    const char* overflow = "LCM calculation resulted in overflow during prime power multiplication.";
+    const long long limit = std::numeric_limits<long long>::max();
+    long long lcm_val = 1LL;
+    auto it1 = factors1.begin();
+    auto it2 = factors2.begin();
+    while (it1 != factors1.end() || it2 != factors2.end()) {
+        if (it2 == factors2.end() || (it1 != factors1.end() && it1->first < it2->first)) {
+            multiplyByPower(lcm_val, it1->first, it1->second, limit, overflow);
+            ++it1;
+        } else if (it1 == factors1.end() || it2->first < it1->first) {
+            multiplyByPower(lcm_val, it2->first, it2->second, limit, overflow);
+            ++it2;
+        } else {
+            multiplyByPower(lcm_val, it1->first, std::max(it1->second, it2->second), limit, overflow);
+            ++it1;
+            ++it2;
         }
     }
     return lcm_val;
 }
 
+} // namespace
+
+int hcfFromPrimeFactorization(const PrimeFactors& factors1, const PrimeFactors& factors2) {
+    return hcfByMerge(factors1, factors2);
+}
+
+long long lcmFromPrimeFactorization(const PrimeFactors& factors1, const PrimeFactors& factors2) {
+    return lcmByMerge(factors1, factors2);
+}
+
+int hcfFromPrimeFactorization(const std::map<int, int>& factors1, const std::map<int, int>& factors2) {
+    return hcfByMerge(factors1, factors2);
+}
+
+long long lcmFromPrimeFactorization(const std::map<int, int>& factors1, const std::map<int, int>& factors2) {
+    return lcmByMerge(factors1, factors2);
+}
 
 long long calculateLCM(int n1, int n2) {
     if (n1 == 0 && n2 == 0) {
@@ -140,8 +192,9 @@ HCFAndLCMResult getHCFAndLCMDetails(int num1, int num2) {
         throw std::invalid_argument("Numbers must be positive for this detailed HCF/LCM via prime factorization.");
     }
     
-    PrimeFactorizationResult pf1_res = (num1 > 1) ? getPrimeFactorization(num1) : PrimeFactorizationResult(num1, {});
-    PrimeFactorizationResult pf2_res = (num2 > 1) ? getPrimeFactorization(num2) : PrimeFactorizationResult(num2, {});
+    const SmallestPrimeFactorTable& table = sharedSmallestPrimeFactorTable();
+    PrimeFactorizationResult pf1_res = (num1 > 1) ? getPrimeFactorization(num1, table) : PrimeFactorizationResult(num1, {});
+    PrimeFactorizationResult pf2_res = (num2 > 1) ? getPrimeFactorization(num2, table) : PrimeFactorizationResult(num2, {});
     
     int hcf_val = std::gcd(num1, num2);
     long long lcm_val = calculateLCM(num1, num2);
@@ -208,7 +261,6 @@ DecimalExpansionResult getDecimalExpansionType(int numerator, int denominator) {
         expansion_type_val = "terminating";
         reason_val = "The fraction simplifies to an integer (" + std::to_string(numerator / common) + "). Denominator is 1.";
     } else {
-        int temp_den = simplified_den;
         std::ostringstream factors_oss;
         bool first_factor_written = false;
 
@@ -220,33 +272,23 @@ DecimalExpansionResult getDecimalExpansionType(int numerator, int denominator) {
                 first_factor_written = true;
             }
         };
-        
-        int count2 = 0;
-        while (temp_den > 0 && temp_den % 2 == 0) { temp_den /= 2; count2++; }
-        append_factor(2, count2);
 
-        int count5 = 0;
-        while (temp_den > 0 && temp_den % 5 == 0) { temp_den /= 5; count5++; }
+        // Factor by table lookups; the reason lists 2 and 5 first, then the other primes ascending
+        int count2 = 0, count5 = 0;
+        std::vector<std::pair<int, int>> other_factors;
+        sharedSmallestPrimeFactorTable().forEachPrimeFactor(
+            static_cast<uint32_t>(simplified_den), [&](uint32_t prime, int count) {
+                if (prime == 2) count2 = count;
+                else if (prime == 5) count5 = count;
+                else other_factors.emplace_back(static_cast<int>(prime), count);
+            });
+        append_factor(2, count2);
         append_factor(5, count5);
-        
-        bool only_2_and_5 = true;
-        int original_temp_den_for_loop = temp_den; // Store before modification by loop
-        for (int i = 3; i * i <= original_temp_den_for_loop; i += 2) {
-            if (temp_den % i == 0) {
-                int count_other = 0;
-                while (temp_den % i == 0) {
-                    temp_den /= i;
-                    count_other++;
-                }
-                only_2_and_5 = false;
-                append_factor(i, count_other);
-            }
+        for (const auto& factor : other_factors) {
+            append_factor(factor.first, factor.second);
         }
-        if (temp_den > 1) { // Remaining temp_den is a prime factor
-            if (temp_den != 2 && temp_den != 5) { only_2_and_5 = false; } // Already factored out
-            append_factor(temp_den, 1);
-        }
-        
+        bool only_2_and_5 = other_factors.empty();
+
         std::string den_factors_str = factors_oss.str();
         if (den_factors_str.empty() && simplified_den == 1) den_factors_str = "1";
         else if (den_factors_str.empty()) den_factors_str = std::to_string(simplified_den);
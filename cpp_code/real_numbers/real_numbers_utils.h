@@ -2,6 +2,10 @@
 #define REAL_NUMBERS_UTILS_H
 
 #include "real_numbers_types.h" // Include our type definitions
+#include "prime_sieve.h"        // Smallest-prime-factor table for lookup-based factorization
+#include "factorization64.h"    // 64-bit Miller-Rabin and Pollard-Brent factorization
+#include "segmented_sieve.h"    // Multithreaded wheel sieve: primes and prime counts in ranges
+#include "batch_gcd.h"          // Binary GCD; batch and fold HCF/LCM over int arrays
 
 namespace michu_fr {
 namespace real_numbers {
@@ -9,6 +13,12 @@ namespace real_numbers {
 EuclidLemmaResult euclidsDivisionLemma(int dividend, int divisor);
 HCFResult euclidsAlgorithmHCF(int n1, int n2);
 PrimeFactorizationResult getPrimeFactorization(int n);
+// Same result by table lookups (see SmallestPrimeFactorTable); no trial division below table.limit()
+PrimeFactorizationResult getPrimeFactorization(int n, const SmallestPrimeFactorTable& table);
+// HCF and LCM of two numbers from their factorizations, by one merge pass over the primes
+int hcfFromPrimeFactorization(const PrimeFactors& factors1, const PrimeFactors& factors2);
+long long lcmFromPrimeFactorization(const PrimeFactors& factors1, const PrimeFactors& factors2);
+// The same over std::map factorizations, for callers that still build maps
 int hcfFromPrimeFactorization(const std::map<int, int>& factors1, const std::map<int, int>& factors2);
 long long lcmFromPrimeFactorization(const std::map<int, int>& factors1, const std::map<int, int>& factors2);
 long long calculateLCM(int n1, int n2);
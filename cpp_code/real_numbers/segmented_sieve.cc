@@ -0,0 +1,322 @@
+// File: segmented_sieve.cc
+#include "segmented_sieve.h"
+#include <algorithm> // For std::min, std::max
+#include <atomic>
+#include <cmath>     // For std::sqrt
+#include <cstring>   // For std::memcpy
+#include <future>
+#include <stdexcept> // For std::invalid_argument
+#include <thread>
+#include <vector>
+
+namespace michu_fr {
+namespace real_numbers {
+
+namespace {
+
+// Sieving primes go up to sqrt(high); at 2^50 that is 2^25, about two million of them
+constexpr uint64_t SIEVE_MAX_HIGH = 1ULL << 50;
+
+// Wheel bytes per segment: 64 KB covers about two million integers and stays in L2 cache
+constexpr uint64_t SEGMENT_BYTES = 1 << 16;
+
+// The residues mod 30 coprime to 30, one bit each, and the gaps between consecutive ones
+constexpr uint8_t WHEEL_RESIDUES[8] = {1, 7, 11, 13, 17, 19, 23, 29};
+constexpr uint8_t WHEEL_GAPS[8] = {6, 4, 2, 4, 2, 4, 6, 2};
+
+// Primes whose multiples are stamped from a repeating pattern instead of being sieved; the
+// pattern repeats every 7 * 11 * 13 * 17 wheel bytes
+constexpr uint32_t PRESIEVE_PRIMES[] = {7, 11, 13, 17};
+constexpr uint64_t PRESIEVE_BYTES = 7 * 11 * 13 * 17;
+
+struct WheelTables {
+    uint8_t bit[30];            // Bit of residue r in its byte, 0 if r shares a factor with 30
+    uint8_t round_up[30];       // Distance from r to the next residue coprime to 30
+    uint8_t round_up_index[30]; // Wheel index of that residue
+    // For a prime p = 30q + r_j and a multiplier m = 30a + r_k on the wheel, p * m lands in
+    // byte q*m + r_j*a + (r_j*r_k)/30, and clear[j][k] masks out its bit. Stepping m to the
+    // next wheel value moves the byte by q * WHEEL_GAPS[k] + byte_step[j][k], so the hot loop
+    // needs no division.
+    uint8_t clear[8][8];
+    uint8_t byte_step[8][8];
+};
+
+constexpr WheelTables makeWheelTables() {
+    WheelTables tables{};
+    for (int r = 0; r < 30; ++r) {
+        for (int k = 0; k < 8; ++k) {
+            if (WHEEL_RESIDUES[k] == r) tables.bit[r] = static_cast<uint8_t>(1u << k);
+        }
+        int k = 0;
+        while (k < 8 && WHEEL_RESIDUES[k] < r) ++k;
+        tables.round_up[r] = static_cast<uint8_t>(k < 8 ? WHEEL_RESIDUES[k] - r : 31 - r);
+        tables.round_up_index[r] = static_cast<uint8_t>(k < 8 ? k : 0);
+    }
+    for (int j = 0; j < 8; ++j) {
+        for (int k = 0; k < 8; ++k) {
+            const int rj = WHEEL_RESIDUES[j], rk = WHEEL_RESIDUES[k], rk_next = WHEEL_RESIDUES[(k + 1) & 7];
+            tables.clear[j][k] = static_cast<uint8_t>(~tables.bit[rj * rk % 30]);
+            // a grows by one when the wheel wraps from 29 to 1
+            tables.byte_step[j][k] = static_cast<uint8_t>((k == 7 ? rj : 0) + rj * rk_next / 30 - rj * rk / 30);
+        }
+    }
+    return tables;
+}
+
+constexpr WheelTables WHEEL = makeWheelTables();
+
+uint64_t integerSqrt(uint64_t n) {
+    uint64_t root = static_cast<uint64_t>(std::sqrt(static_cast<double>(n)));
+    while (root * root > n) --root;
+    while ((root + 1) * (root + 1) <= n) ++root;
+    return root;
+}
+
+// Primes 19 <= p <= limit (the ones not pre-sieved), from a plain odd-only sieve; limit is
+// at most 2^25
+std::vector<uint32_t> sievingPrimes(uint64_t limit) {
+    std::vector<uint32_t> primes;
+    std::vector<bool> composite(limit / 2 + 1, false); // composite[i] stands for 2i + 1
+    for (uint64_t i = 3; i <= limit; i += 2) {
+        if (composite[i / 2]) continue;
+        if (i >= 19) primes.push_back(static_cast<uint32_t>(i));
+        for (uint64_t j = i * i; j <= limit; j += 2 * i) composite[j / 2] = true;
+    }
+    return primes;
+}
+
+// One period of the wheel with the odd multiples of the pre-sieve primes cleared
+const std::vector<uint8_t>& presievePattern() {
+    static const std::vector<uint8_t> pattern = [] {
+        std::vector<uint8_t> bytes(PRESIEVE_BYTES, 0xFF);
+        for (uint32_t p : PRESIEVE_PRIMES) {
+            for (uint64_t n = p; n < 30 * PRESIEVE_BYTES; n += 2 * p) {
+                bytes[n / 30] &= static_cast<uint8_t>(~WHEEL.bit[n % 30]); // No-op off the wheel
+            }
+        }
+        return bytes;
+    }();
+    return pattern;
+}
+
+// Bits of the wheel byte starting at byte_base whose numbers are >= low, or <= high
+uint8_t bitsAtLeast(uint64_t byte_base, uint64_t low) {
+    uint8_t mask = 0;
+    for (int k = 0; k < 8; ++k) {
+        if (byte_base + WHEEL_RESIDUES[k] >= low) mask |= static_cast<uint8_t>(1u << k);
+    }
+    return mask;
+}
+
+uint8_t bitsAtMost(uint64_t byte_base, uint64_t high) {
+    uint8_t mask = 0;
+    for (int k = 0; k < 8; ++k) {
+        if (byte_base + WHEEL_RESIDUES[k] <= high) mask |= static_cast<uint8_t>(1u << k);
+    }
+    return mask;
+}
+
+// One segment of the wheel: bytes [first_byte, first_byte + size) stand for the integers
+// [30 * first_byte, 30 * (first_byte + size)). A set bit is a prime once sieved.
+class Segment {
+public:
+    void sieve(uint64_t first_byte, uint64_t size, const std::vector<uint32_t>& primes) {
+        first_byte_ = first_byte;
+        bytes_.resize(size);
+        presieve();
+        const uint64_t base = 30 * first_byte;
+        const uint64_t end = base + 30 * size;
+
+        for (uint32_t p : primes) {
+            const uint64_t p64 = p;
+            if (p64 * p64 >= end) break;
+            // First multiple p * m >= max(p^2, base) with m on the wheel; smaller m were
+            // crossed off by their own smallest prime
+            uint64_t m = std::max<uint64_t>(p64, (base + p64 - 1) / p64);
+            const unsigned r = static_cast<unsigned>(m % 30);
+            m += WHEEL.round_up[r];
+            unsigned k = WHEEL.round_up_index[r];
+            const unsigned j = WHEEL.round_up_index[p % 30];
+            const uint64_t q = p / 30;
+            const uint64_t first_hit = q * m + WHEEL_RESIDUES[j] * (m / 30) + WHEEL_RESIDUES[j] * WHEEL_RESIDUES[k] / 30;
+            for (uint64_t byte = first_hit - first_byte; byte < size; k = (k + 1) & 7) {
+                bytes_[byte] &= WHEEL.clear[j][k];
+                byte += q * WHEEL_GAPS[k] + WHEEL.byte_step[j][k];
+            }
+        }
+    }
+
+    // Calls visit(byte_base, bits) for each byte overlapping [low, high], masked to it
+    template <typename Visit>
+    void forEachByte(uint64_t low, uint64_t high, Visit visit) const {
+        const uint64_t base = 30 * first_byte_;
+        const uint64_t last = base + 30 * bytes_.size() - 1;
+        if (high < base || low > last) return;
+        const uint64_t first_index = (std::max(low, base) - base) / 30;
+        const uint64_t last_index = (std::min(high, last) - base) / 30;
+        for (uint64_t i = first_index; i <= last_index; ++i) {
+            uint8_t bits = bytes_[i];
+            const uint64_t byte_base = base + 30 * i;
+            if (i == first_index) bits &= bitsAtLeast(byte_base, low);
+            if (i == last_index) bits &= bitsAtMost(byte_base, high);
+            visit(byte_base, bits);
+        }
+    }
+
+    uint64_t count(uint64_t low, uint64_t high) const {
+        const uint64_t base = 30 * first_byte_;
+        const uint64_t last = base + 30 * bytes_.size() - 1;
+        if (high < base || low > last) return 0;
+        const uint64_t first_index = (std::max(low, base) - base) / 30;
+        const uint64_t last_index = (std::min(high, last) - base) / 30;
+        uint64_t total = 0;
+        // Interior bytes eight at a time; the two end bytes through the masks
+        uint64_t i = first_index + 1;
+        for (; i + 8 <= last_index; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, &bytes_[i], sizeof word);
+            total += static_cast<uint64_t>(__builtin_popcountll(word));
+        }
+        for (; i < last_index; ++i) total += static_cast<uint64_t>(__builtin_popcount(bytes_[i]));
+        uint8_t first_bits = bytes_[first_index] & bitsAtLeast(base + 30 * first_index, low);
+        if (first_index == last_index) {
+            return static_cast<uint64_t>(__builtin_popcount(first_bits & bitsAtMost(base + 30 * last_index, high)));
+        }
+        const uint8_t last_bits = bytes_[last_index] & bitsAtMost(base + 30 * last_index, high);
+        return total + static_cast<uint64_t>(__builtin_popcount(first_bits) + __builtin_popcount(last_bits));
+    }
+
+private:
+    // Tiles the pre-sieve pattern from this segment's phase in it
+    void presieve() {
+        const std::vector<uint8_t>& pattern = presievePattern();
+        uint64_t phase = first_byte_ % PRESIEVE_BYTES;
+        for (uint64_t filled = 0; filled < bytes_.size();) {
+            const uint64_t chunk = std::min<uint64_t>(PRESIEVE_BYTES - phase, bytes_.size() - filled);
+            std::memcpy(&bytes_[filled], &pattern[phase], chunk);
+            filled += chunk;
+            phase = 0;
+        }
+        if (first_byte_ == 0) {
+            // The pattern crossed off the pre-sieve primes themselves but left 1
+            bytes_[0] &= static_cast<uint8_t>(~WHEEL.bit[1]);
+            for (uint32_t p : PRESIEVE_PRIMES) bytes_[p / 30] |= WHEEL.bit[p % 30];
+        }
+    }
+
+    uint64_t first_byte_ = 0;
+    std::vector<uint8_t> bytes_;
+};
+
+// The wheel bytes covering [low, high], cut into segments
+struct SegmentPlan {
+    uint64_t first_byte;
+    uint64_t total_bytes;
+    uint64_t segments;
+    std::vector<uint32_t> primes;
+
+    SegmentPlan(uint64_t low, uint64_t high)
+        : first_byte(low / 30), total_bytes(high / 30 - low / 30 + 1),
+          segments((total_bytes + SEGMENT_BYTES - 1) / SEGMENT_BYTES), primes(sievingPrimes(integerSqrt(high))) {}
+
+    void sieve(Segment& segment, uint64_t index) const {
+        const uint64_t offset = index * SEGMENT_BYTES;
+        segment.sieve(first_byte + offset, std::min(SEGMENT_BYTES, total_bytes - offset), primes);
+    }
+};
+
+void validateRange(uint64_t low, uint64_t high) {
+    if (low > high) {
+        throw std::invalid_argument("Range is empty: low must not exceed high.");
+    }
+    if (high > SIEVE_MAX_HIGH) {
+        throw std::invalid_argument("Range end exceeds the sieve's bound of 2^50.");
+    }
+}
+
+unsigned resolveThreads(unsigned threads, uint64_t segments) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    return static_cast<unsigned>(std::max<uint64_t>(1, std::min<uint64_t>(threads, segments)));
+}
+
+} // namespace
+
+void primesInRange(uint64_t low, uint64_t high, const std::function<void(uint64_t)>& visit, unsigned threads) {
+    validateRange(low, high);
+    for (uint64_t p : {2, 3, 5}) { // Off the wheel
+        if (low <= p && p <= high) visit(p);
+    }
+    const SegmentPlan plan(low, high);
+    auto visitSegment = [&](const Segment& segment) {
+        segment.forEachByte(low, high, [&](uint64_t byte_base, uint8_t bits) {
+            while (bits) {
+                visit(byte_base + WHEEL_RESIDUES[__builtin_ctz(bits)]);
+                bits &= static_cast<uint8_t>(bits - 1);
+            }
+        });
+    };
+
+    const unsigned workers = resolveThreads(threads, plan.segments);
+    if (workers == 1) {
+        Segment segment;
+        for (uint64_t index = 0; index < plan.segments; ++index) {
+            plan.sieve(segment, index);
+            visitSegment(segment);
+        }
+        return;
+    }
+
+    // Batches of one segment per worker in two buffers: the next batch is sieved while the
+    // calling thread visits the current one in order
+    std::vector<Segment> buffers[2] = {std::vector<Segment>(workers), std::vector<Segment>(workers)};
+    auto launch = [&](uint64_t batch) {
+        std::vector<std::future<void>> futures;
+        std::vector<Segment>& buffer = buffers[batch & 1];
+        for (unsigned i = 0; i < workers && batch * workers + i < plan.segments; ++i) {
+            futures.push_back(std::async(std::launch::async, [&plan, &buffer, batch, workers, i] {
+                plan.sieve(buffer[i], batch * workers + i);
+            }));
+        }
+        return futures;
+    };
+    const uint64_t batches = (plan.segments + workers - 1) / workers;
+    std::vector<std::future<void>> current = launch(0);
+    for (uint64_t batch = 0; batch < batches; ++batch) {
+        for (std::future<void>& future : current) future.get();
+        const size_t ready = current.size();
+        current = (batch + 1 < batches) ? launch(batch + 1) : std::vector<std::future<void>>();
+        for (size_t i = 0; i < ready; ++i) visitSegment(buffers[batch & 1][i]);
+    }
+}
+
+uint64_t countPrimesInRange(uint64_t low, uint64_t high, unsigned threads) {
+    validateRange(low, high);
+    uint64_t small = 0;
+    for (uint64_t p : {2, 3, 5}) { // Off the wheel
+        if (low <= p && p <= high) ++small;
+    }
+    const SegmentPlan plan(low, high);
+    const unsigned workers = resolveThreads(threads, plan.segments);
+
+    // Segments are claimed from a shared counter, so uneven segments balance themselves
+    std::atomic<uint64_t> next_segment(0);
+    std::vector<uint64_t> counts(workers, 0);
+    auto work = [&](unsigned worker) {
+        Segment segment;
+        for (uint64_t index = next_segment++; index < plan.segments; index = next_segment++) {
+            plan.sieve(segment, index);
+            counts[worker] += segment.count(low, high);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned worker = 1; worker < workers; ++worker) pool.emplace_back(work, worker);
+    work(0);
+    for (std::thread& thread : pool) thread.join();
+
+    uint64_t total = small;
+    for (uint64_t count : counts) total += count;
+    return total;
+}
+
+} // namespace real_numbers
+} // namespace michu_fr
@@ -0,0 +1,31 @@
+// File: segmented_sieve.h
+#ifndef REAL_NUMBERS_SEGMENTED_SIEVE_H
+#define REAL_NUMBERS_SEGMENTED_SIEVE_H
+
+#include <cstdint>
+#include <functional>
+
+namespace michu_fr {
+namespace real_numbers {
+
+// Segmented Sieve of Eratosthenes over [low, high] (both inclusive, high <= 2^50).
+//
+// Numbers are stored on a mod-30 wheel: one byte per 30 integers, one bit for each of the
+// eight residues coprime to 30, so multiples of 2, 3 and 5 take no space and are never
+// crossed off. Each segment is a cache-sized block of such bytes, sieved by the primes up
+// to sqrt(high) stepping along the wheel. Segments are independent and are spread across
+// `threads` worker threads (0 means std::thread::hardware_concurrency()).
+//
+// Throws std::invalid_argument if low > high or high exceeds the supported bound.
+
+// Calls visit(p) for every prime p in [low, high], in ascending order, on the calling
+// thread. Workers sieve the next batch of segments while earlier ones are visited.
+void primesInRange(uint64_t low, uint64_t high, const std::function<void(uint64_t)>& visit, unsigned threads = 0);
+
+// Number of primes in [low, high]; counts by popcount, never materialising a prime.
+uint64_t countPrimesInRange(uint64_t low, uint64_t high, unsigned threads = 0);
+
+} // namespace real_numbers
+} // namespace michu_fr
+
+#endif // REAL_NUMBERS_SEGMENTED_SIEVE_H